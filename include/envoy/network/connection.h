@@ -78,6 +78,12 @@ public:
    */
   typedef std::function<void(uint64_t bytes_sent)> BytesSentCb;
 
+  /**
+   * Callback function for when bytes have been spliced from a connection to another connection.
+   * @param bytes_spliced supplies the number of bytes read from the connection.
+   */
+  typedef std::function<void(uint64_t bytes_spliced)> BytesSplicedCb;
+
   struct ConnectionStats {
     Stats::Counter& read_total_;
     Stats::Gauge& read_current_;
@@ -216,6 +222,23 @@ public:
    * @return boolean telling if the connection is currently above the high watermark.
    */
   virtual bool aboveHighWatermark() const PURE;
+
+  /**
+   * Move all data subsequently read from this connection straight to another connection without
+   * copying it through user space, bypassing the read filter chain of this connection and the
+   * write filter chain of the destination. This is only possible for plain TCP connections which
+   * have a single read filter, no write filters and no buffered data, and on platforms which
+   * support it (currently Linux splice()). Flow control is applied through the watermark
+   * callbacks of the destination as it is for buffered writes. Once splicing is enabled, data
+   * must not be written to the destination through write(). Splicing stops when either
+   * connection is closed. Each spliced direction holds a kernel pipe of the default capacity,
+   * i.e. two extra file descriptors, so splicing both directions of a proxied connection costs
+   * four.
+   * @param destination supplies the connection to move the data to.
+   * @param cb supplies the callback to invoke each time data has been read from this connection.
+   * @return true if splicing has been enabled, false if the data must take the buffered path.
+   */
+  virtual bool spliceTo(Connection& destination, BytesSplicedCb cb) PURE;
 };
 
 typedef std::unique_ptr<Connection> ConnectionPtr;
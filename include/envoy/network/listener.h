@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -10,6 +11,31 @@
 namespace Envoy {
 namespace Network {
 
+/**
+ * Limits the rate at which connections are accepted for a listener. A limiter is shared by all the
+ * workers accepting from the listener's socket, so that they stay within the limit together. It is
+ * thread safe.
+ */
+class ConnectionRateLimiter {
+public:
+  virtual ~ConnectionRateLimiter() {}
+
+  /**
+   * Take the permission to accept a connection.
+   * @return std::chrono::milliseconds 0 if the connection may be accepted now, otherwise how long
+   *         to wait before trying again.
+   */
+  virtual std::chrono::milliseconds consume() PURE;
+
+  /**
+   * Give back a permission taken by consume() that wasn't used, e.g. because another worker
+   * accepted the connection first.
+   */
+  virtual void refund() PURE;
+};
+
+typedef std::shared_ptr<ConnectionRateLimiter> ConnectionRateLimiterSharedPtr;
+
 /**
  * Listener configurations options.
  */
@@ -25,6 +51,12 @@ struct ListenerOptions {
   bool use_original_dst_;
   // Soft limit on size of the listener's new connection read and write buffers.
   uint32_t per_connection_buffer_limit_bytes_;
+  // Maximum number of connections accepted each time the listen socket becomes readable, so that a
+  // connection storm can't starve the connections already on the worker. 0 means the default.
+  uint32_t max_connections_per_accept_;
+  // Limits the rate at which this listener accepts new connections. Connections above it wait in
+  // the kernel backlog. nullptr means unlimited.
+  ConnectionRateLimiterSharedPtr connection_rate_limiter_;
 
   /**
    * Factory for ListenerOptions with bind_to_port_ set.
@@ -34,7 +66,9 @@ struct ListenerOptions {
     return {.bind_to_port_ = true,
             .use_proxy_proto_ = false,
             .use_original_dst_ = false,
-            .per_connection_buffer_limit_bytes_ = 0};
+            .per_connection_buffer_limit_bytes_ = 0,
+            .max_connections_per_accept_ = 0,
+            .connection_rate_limiter_ = nullptr};
   }
 };
 
@@ -2,6 +2,7 @@
 
 #include "envoy/network/filter.h"
 #include "envoy/network/listen_socket.h"
+#include "envoy/network/listener.h"
 #include "envoy/server/drain_manager.h"
 #include "envoy/server/filter_config.h"
 #include "envoy/server/guarddog.h"
@@ -101,6 +102,18 @@ public:
    */
   virtual uint32_t perConnectionBufferLimitBytes() PURE;
 
+  /**
+   * @return uint32_t the maximum number of connections a worker accepts for the listener each time
+   *         its socket becomes readable, or 0 for the default.
+   */
+  virtual uint32_t maxConnectionsPerAccept() PURE;
+
+  /**
+   * @return Network::ConnectionRateLimiterSharedPtr the limiter shared by all workers accepting
+   *         new connections for the listener, or nullptr for no limit.
+   */
+  virtual Network::ConnectionRateLimiterSharedPtr connectionRateLimiter() PURE;
+
   /**
    * @return Stats::Scope& the stats scope to use for all listener specific stats.
    */
@@ -2,8 +2,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/common/pure.h"
+#include "envoy/ssl/context_config.h"
 
 namespace Envoy {
 namespace Ssl {
@@ -36,7 +38,17 @@ public:
 class ClientContext : public virtual Context {};
 typedef std::unique_ptr<ClientContext> ClientContextPtr;
 
-class ServerContext : public virtual Context {};
+class ServerContext : public virtual Context {
+public:
+  /**
+   * Replace the keys used for encrypting and decrypting session tickets, e.g. after the key files
+   * have been rotated. This may be called from any thread while connections are being handshaked.
+   * It is a no-op for contexts that were configured without session ticket keys.
+   * @param keys supplies the new keys. The first key is used for encrypting new tickets.
+   */
+  virtual void
+  setSessionTicketKeys(const std::vector<ServerContextConfig::SessionTicketKey>& keys) PURE;
+};
 typedef std::unique_ptr<ServerContext> ServerContextPtr;
 
 } // namespace Ssl
@@ -46,6 +46,15 @@ public:
    */
   virtual void runOnAllThreads(Event::PostCb cb) PURE;
 
+  /**
+   * Run a callback on all registered threads and, once every thread has run it, run a completion
+   * callback on the main thread.
+   * @param cb supplies the callback to run on every thread.
+   * @param all_threads_complete_cb supplies the callback to run on the main thread once cb has run
+   *        on every thread.
+   */
+  virtual void runOnAllThreads(Event::PostCb cb, Event::PostCb all_threads_complete_cb) PURE;
+
   /**
    * Set thread local data on all threads previously registered via registerThread().
    * @param initializeCb supplies the functor that will be called *on each thread*. The functor
@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/config/grpc_mux.h"
@@ -95,6 +96,34 @@ public:
    */
   virtual Http::AsyncClient& httpAsyncClientForCluster(const std::string& cluster) PURE;
 
+  /**
+   * Record the outcome of a request to an upstream host for load reporting. This is *per-thread*:
+   * outcomes are accumulated by the calling thread without any cross-thread synchronization until
+   * they are harvested via harvestLoadReports(). Outcomes for hosts of clusters that are not being
+   * reported on are dropped.
+   * @param host supplies the host the request was sent to.
+   * @param success supplies whether the request succeeded.
+   */
+  virtual void recordLoadReport(const HostDescriptionConstSharedPtr& host, bool success) PURE;
+
+  typedef std::function<void(HostLoadReportMap&& load_reports)> LoadReportsCb;
+
+  /**
+   * Harvest the load reports accumulated by every thread since the previous harvest and keep
+   * accumulating reports for the given clusters. Every request is harvested exactly once.
+   * @param clusters supplies the names of the clusters to accumulate load reports for.
+   * @param cb supplies the callback to invoke on the main thread with the harvested load reports
+   *        once every thread has handed its reports over.
+   */
+  virtual void harvestLoadReports(const std::vector<std::string>& clusters, LoadReportsCb cb) PURE;
+
+  /**
+   * Change the clusters load reports are accumulated for on every thread. Reports accumulated for
+   * clusters that remain tracked are kept for the next harvest, the others are dropped.
+   * @param clusters supplies the names of the clusters to accumulate load reports for.
+   */
+  virtual void updateLoadReportClusters(const std::vector<std::string>& clusters) PURE;
+
   /**
    * Remove a primary cluster via API. Only clusters added via addOrUpdatePrimaryCluster() can
    * be removed in this manner. Statically defined clusters present when Envoy starts cannot be
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "envoy/network/address.h"
 #include "envoy/stats/stats_macros.h"
@@ -15,10 +17,6 @@ namespace Upstream {
 
 /**
  * All per host stats. @see stats_macros.h
- *
- * {rq_success, rq_error} have specific semantics driven by the needs of EDS load reporting. See
- * envoy.api.v2.UpstreamLocalityStats for the definitions of success/error. These are latched by
- * LoadStatsReporter, independent of the normal stats sink flushing.
  */
 // clang-format off
 #define ALL_HOST_STATS(COUNTER, GAUGE)                                                             \
@@ -27,8 +25,6 @@ namespace Upstream {
   COUNTER(cx_connect_fail)                                                                         \
   COUNTER(rq_total)                                                                                \
   COUNTER(rq_timeout)                                                                              \
-  COUNTER(rq_success)                                                                              \
-  COUNTER(rq_error)                                                                                \
   GAUGE  (rq_active)
 // clang-format on
 
@@ -98,5 +94,16 @@ public:
 
 typedef std::shared_ptr<const HostDescription> HostDescriptionConstSharedPtr;
 
+/**
+ * Request outcomes of a host accumulated for EDS load reporting. See
+ * envoy.api.v2.UpstreamLocalityStats for the definitions of success/error.
+ */
+struct HostLoadReport {
+  uint64_t rq_success_{};
+  uint64_t rq_error_{};
+};
+
+typedef std::unordered_map<HostDescriptionConstSharedPtr, HostLoadReport> HostLoadReportMap;
+
 } // Upstream
 } // namespace Envoy
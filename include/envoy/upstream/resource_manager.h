@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 
@@ -43,6 +44,32 @@ public:
   virtual uint64_t max() PURE;
 };
 
+/**
+ * A resource whose maximum adapts to the response times observed by the requests holding it.
+ */
+class AdaptiveResource : public Resource {
+public:
+  /**
+   * @return true if the adaptive limit is enabled. Requests should only be counted against the
+   *         resource while it is enabled.
+   */
+  virtual bool enabled() PURE;
+
+  /**
+   * Record the response time of a request that was counted against the resource.
+   * @param response_time supplies the time from the request being sent to the response completing.
+   */
+  virtual void recordResponseTime(std::chrono::milliseconds response_time) PURE;
+
+  /**
+   * Record a request that was counted against the resource but failed without a meaningful
+   * response time, e.g. because the upstream reset it. It is recorded as a slow response, so that
+   * fast failures don't raise the limit.
+   * @param response_time supplies the time from the request being sent to the failure.
+   */
+  virtual void recordFailure(std::chrono::milliseconds response_time) PURE;
+};
+
 /**
  * Global resource manager that loosely synchronizes maximum connections, pending requests, etc.
  * NOTE: Currently this is used on a per cluster basis. In the future we may consider also chaining
@@ -73,6 +100,12 @@ public:
    * @return Resource& active retries.
    */
   virtual Resource& retries() PURE;
+
+  /**
+   * @return AdaptiveResource& requests admitted by the router under the adaptive concurrency limit
+   *         (requests that have been routed to the cluster and have not yet completed).
+   */
+  virtual AdaptiveResource& adaptiveRequests() PURE;
 };
 
 } // namespace Upstream
@@ -126,6 +126,8 @@ class HostSet {
 public:
   typedef std::shared_ptr<const std::vector<HostSharedPtr>> HostVectorConstSharedPtr;
   typedef std::shared_ptr<const std::vector<std::vector<HostSharedPtr>>> HostListsConstSharedPtr;
+  typedef std::vector<uint32_t> LocalityWeights;
+  typedef std::shared_ptr<const LocalityWeights> LocalityWeightsConstSharedPtr;
 
   virtual ~HostSet() {}
 
@@ -156,6 +158,12 @@ public:
    */
   virtual const std::vector<std::vector<HostSharedPtr>>& healthyHostsPerLocality() const PURE;
 
+  /**
+   * @return the load balancing weight of each locality, indexed the same as hostsPerLocality(), or
+   *         nullptr if no locality weights were configured for this host set.
+   */
+  virtual LocalityWeightsConstSharedPtr localityWeights() const PURE;
+
   /**
    * Updates the hosts in a given host set.
    *
@@ -163,12 +171,14 @@ public:
    * @param healthy hosts supplies the subset of hosts which are healthy.
    * @param hosts_per_locality supplies the hosts subdivided by locality.
    * @param hosts_per_locality supplies the healthy hosts subdivided by locality.
+   * @param locality_weights supplies the per locality weights, or nullptr if there are none.
    * @param hosts_added supplies the hosts added since the last update.
    * @param hosts_removed supplies the hosts removed since the last update.
    */
   virtual void updateHosts(HostVectorConstSharedPtr hosts, HostVectorConstSharedPtr healthy_hosts,
                            HostListsConstSharedPtr hosts_per_locality,
                            HostListsConstSharedPtr healthy_hosts_per_locality,
+                           LocalityWeightsConstSharedPtr locality_weights,
                            const std::vector<HostSharedPtr>& hosts_added,
                            const std::vector<HostSharedPtr>& hosts_removed) PURE;
 
@@ -266,6 +276,7 @@ public:
   GAUGE    (upstream_rq_pending_active)                                                            \
   COUNTER  (upstream_rq_cancelled)                                                                 \
   COUNTER  (upstream_rq_maintenance_mode)                                                          \
+  COUNTER  (upstream_rq_concurrency_limited)                                                       \
   COUNTER  (upstream_rq_timeout)                                                                   \
   COUNTER  (upstream_rq_per_try_timeout)                                                           \
   COUNTER  (upstream_rq_rx_reset)                                                                  \
@@ -1,5 +1,9 @@
 #include "common/buffer/buffer_impl.h"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <string>
 
@@ -94,7 +98,48 @@ void OwnedImpl::move(Instance& rhs, uint64_t length) {
 }
 
 int OwnedImpl::read(int fd, uint64_t max_length) {
-  return evbuffer_read(buffer_.get(), fd, max_length);
+  if (max_length == 0) {
+    return 0;
+  }
+
+  // evbuffer_read() issues an ioctl(FIONREAD) before every read to size it, and clamps each read
+  // to 4K. Reading straight into reserved space takes a single readv() of up to max_length.
+  constexpr uint64_t MaxSlices = 2;
+  RawSlice slices[MaxSlices];
+  const uint64_t num_slices = OwnedImpl::reserve(max_length, slices, MaxSlices);
+  iovec iov[MaxSlices];
+  uint64_t num_slices_to_read = 0;
+  uint64_t num_bytes_to_read = 0;
+  for (; num_slices_to_read < num_slices && num_bytes_to_read < max_length;
+       num_slices_to_read++) {
+    const size_t slice_length =
+        std::min<uint64_t>(slices[num_slices_to_read].len_, max_length - num_bytes_to_read);
+    iov[num_slices_to_read].iov_base = slices[num_slices_to_read].mem_;
+    iov[num_slices_to_read].iov_len = slice_length;
+    num_bytes_to_read += slice_length;
+  }
+  ASSERT(num_bytes_to_read <= max_length);
+
+  const ssize_t rc = ::readv(fd, iov, static_cast<int>(num_slices_to_read));
+  if (rc < 0) {
+    // Release the reserved space. errno is preserved for the caller.
+    const int saved_errno = errno;
+    OwnedImpl::commit(slices, 0);
+    errno = saved_errno;
+    return rc;
+  }
+
+  uint64_t num_slices_to_commit = 0;
+  uint64_t bytes_to_commit = rc;
+  while (bytes_to_commit != 0) {
+    slices[num_slices_to_commit].len_ =
+        std::min<uint64_t>(slices[num_slices_to_commit].len_, bytes_to_commit);
+    bytes_to_commit -= slices[num_slices_to_commit].len_;
+    num_slices_to_commit++;
+  }
+  ASSERT(num_slices_to_commit <= num_slices);
+  OwnedImpl::commit(slices, num_slices_to_commit);
+  return rc;
 }
 
 uint64_t OwnedImpl::reserve(uint64_t length, RawSlice* iovecs, uint64_t num_iovecs) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/optional.h"
 #include "envoy/config/grpc_mux.h"
 #include "envoy/config/subscription.h"
 
@@ -47,15 +48,25 @@ public:
   // Config::GrpcMuxCallbacks
   void onConfigUpdate(const Protobuf::RepeatedPtrField<ProtobufWkt::Any>& resources,
                       const std::string& version_info) override {
+    // State-of-the-world updates resend every resource of the type, even if only one of them
+    // changed. Skip unpacking and delivering the resources when this subscription's view of them is
+    // identical to the last accepted update, so that e.g. an EDS cluster is not rebuilt because an
+    // unrelated cluster's endpoints moved.
+    const uint64_t resources_hash = RepeatedPtrUtil::hash(resources);
+    if (resources_hash_.valid() && resources_hash_.value() == resources_hash) {
+      ENVOY_LOG(debug, "gRPC config for {} unchanged with {} resources", type_url_,
+                resources.size());
+      onConfigUpdateAccepted(version_info);
+      return;
+    }
+
     Protobuf::RepeatedPtrField<ResourceType> typed_resources;
     std::transform(resources.cbegin(), resources.cend(),
                    Protobuf::RepeatedPtrFieldBackInserter(&typed_resources),
                    MessageUtil::anyConvert<ResourceType>);
     callbacks_->onConfigUpdate(typed_resources);
-    stats_.update_success_.inc();
-    stats_.update_attempt_.inc();
-    version_info_ = version_info;
-    stats_.version_.set(HashUtil::xxHash64(version_info_));
+    resources_hash_.value(resources_hash);
+    onConfigUpdateAccepted(version_info);
     ENVOY_LOG(debug, "gRPC config for {} accepted with {} resources: {}", type_url_,
               resources.size(), RepeatedPtrUtil::debugString(typed_resources));
   }
@@ -74,12 +85,21 @@ public:
   }
 
 private:
+  void onConfigUpdateAccepted(const std::string& version_info) {
+    stats_.update_success_.inc();
+    stats_.update_attempt_.inc();
+    version_info_ = version_info;
+    stats_.version_.set(HashUtil::xxHash64(version_info_));
+  }
+
   GrpcMux& grpc_mux_;
   SubscriptionStats stats_;
   const std::string type_url_;
   SubscriptionCallbacks<ResourceType>* callbacks_{};
   GrpcMuxWatchPtr watch_{};
   std::string version_info_;
+  // Hash of the resources in the last accepted update.
+  Optional<uint64_t> resources_hash_;
 };
 
 } // namespace Config
@@ -86,9 +86,9 @@ DispatcherImpl::createSslClientConnection(Ssl::ClientContext& ssl_ctx,
 }
 
 Network::DnsResolverSharedPtr DispatcherImpl::createDnsResolver(
-    const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers) {
+    const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers, Stats::Scope& scope) {
   ASSERT(isThreadSafe());
-  return Network::DnsResolverSharedPtr{new Network::DnsResolverImpl(*this, resolvers)};
+  return Network::DnsResolverSharedPtr{new Network::DnsResolverImpl(*this, resolvers, scope)};
 }
 
 FileEventPtr DispatcherImpl::createFileEvent(int fd, FileReadyCb cb, FileTriggerType trigger,
@@ -148,7 +148,7 @@ void DispatcherImpl::post(std::function<void()> callback) {
   {
     std::unique_lock<std::mutex> lock(post_lock_);
     do_post = post_callbacks_.empty();
-    post_callbacks_.push_back(callback);
+    post_callbacks_.push_back(std::move(callback));
   }
 
   if (do_post) {
@@ -169,14 +169,17 @@ void DispatcherImpl::run(RunType type) {
 }
 
 void DispatcherImpl::runPostCallbacks() {
-  std::unique_lock<std::mutex> lock(post_lock_);
-  while (!post_callbacks_.empty()) {
-    std::function<void()> callback = post_callbacks_.front();
-    post_callbacks_.pop_front();
-
-    lock.unlock();
-    callback();
-    lock.lock();
+  // Take everything posted so far under a single lock acquisition. Callbacks posted while these
+  // run land in the now empty post_callbacks_ and re-arm the post timer.
+  std::list<std::function<void()>> callbacks;
+  {
+    std::unique_lock<std::mutex> lock(post_lock_);
+    callbacks.swap(post_callbacks_);
+  }
+
+  while (!callbacks.empty()) {
+    callbacks.front()();
+    callbacks.pop_front();
   }
 }
 
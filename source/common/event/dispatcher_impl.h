@@ -40,8 +40,9 @@ public:
   createSslClientConnection(Ssl::ClientContext& ssl_ctx,
                             Network::Address::InstanceConstSharedPtr address,
                             Network::Address::InstanceConstSharedPtr source_address) override;
-  Network::DnsResolverSharedPtr createDnsResolver(
-      const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers) override;
+  Network::DnsResolverSharedPtr
+  createDnsResolver(const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers,
+                    Stats::Scope& scope) override;
   FileEventPtr createFileEvent(int fd, FileReadyCb cb, FileTriggerType trigger,
                                uint32_t events) override;
   Filesystem::WatcherPtr createFilesystemWatcher() override;
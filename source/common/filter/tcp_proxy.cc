@@ -50,7 +50,8 @@ TcpProxyConfig::TcpProxyConfig(const envoy::api::v2::filter::network::TcpProxy&
                                Server::Configuration::FactoryContext& context)
     : max_connect_attempts_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_connect_attempts, 1)),
       upstream_drain_manager_slot_(context.threadLocal().allocateSlot()),
-      shared_config_(std::make_shared<SharedConfig>(config, context)) {
+      shared_config_(std::make_shared<SharedConfig>(config, context)),
+      runtime_(context.runtime()) {
 
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     return ThreadLocal::ThreadLocalObjectSharedPtr(new TcpProxyUpstreamDrainManager());
@@ -109,6 +110,10 @@ const std::string& TcpProxyConfig::getRouteFromEntries(Network::Connection& conn
   return EMPTY_STRING;
 }
 
+bool TcpProxyConfig::spliceEnabled() const {
+  return runtime_.snapshot().featureEnabled("tcp_proxy.splice_enabled", 0);
+}
+
 TcpProxyUpstreamDrainManager& TcpProxyConfig::drainManager() {
   return upstream_drain_manager_slot_->getTyped<TcpProxyUpstreamDrainManager>();
 }
@@ -409,6 +414,25 @@ void TcpProxy::onUpstreamData(Buffer::Instance& data) {
   resetIdleTimer(); // TODO(ggreenway) PERF: do we need to reset timer on both send and receive?
 }
 
+void TcpProxy::spliceConnections() {
+  // Each direction falls back to onData()/onUpstreamData() on its own if it cannot be spliced,
+  // e.g. because another filter needs to see the data or one side uses TLS.
+  bool spliced = read_callbacks_->connection().spliceTo(*upstream_connection_, [this](
+      uint64_t bytes) {
+    request_info_.bytes_received_ += bytes;
+    resetIdleTimer();
+  });
+  spliced |= upstream_connection_->spliceTo(read_callbacks_->connection(), [this](uint64_t bytes) {
+    request_info_.bytes_sent_ += bytes;
+    resetIdleTimer();
+  });
+
+  if (spliced) {
+    ENVOY_CONN_LOG(debug, "splicing upstream connection", read_callbacks_->connection());
+    config_->stats().downstream_cx_spliced_.inc();
+  }
+}
+
 void TcpProxy::onUpstreamEvent(Network::ConnectionEvent event) {
   bool connecting = false;
 
@@ -444,6 +468,10 @@ void TcpProxy::onUpstreamEvent(Network::ConnectionEvent event) {
   } else if (event == Network::ConnectionEvent::Connected) {
     connect_timespan_->complete();
 
+    if (config_ != nullptr && config_->spliceEnabled()) {
+      spliceConnections();
+    }
+
     // Re-enable downstream reads now that the upstream connection is established
     // so we have a place to send downstream data to.
     read_callbacks_->connection().readDisable(false);
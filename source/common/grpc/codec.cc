@@ -1,10 +1,12 @@
 #include "common/grpc/codec.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <vector>
 
 #include "common/buffer/buffer_impl.h"
+#include "common/common/assert.h"
 
 namespace Envoy {
 namespace Grpc {
@@ -22,79 +24,83 @@ void Encoder::newFrame(uint8_t flags, uint64_t length, std::array<uint8_t, 5>& o
 Decoder::Decoder() : state_(State::FH_FLAG) {}
 
 bool Decoder::decode(Buffer::Instance& input, std::vector<Frame>& output) {
-  uint64_t count = input.getRawSlices(nullptr, 0);
-  Buffer::RawSlice slices[count];
-  input.getRawSlices(slices, count);
-  for (Buffer::RawSlice& slice : slices) {
-    uint8_t* mem = reinterpret_cast<uint8_t*>(slice.mem_);
-    for (uint64_t j = 0; j < slice.len_;) {
-      uint8_t c = *mem;
-      switch (state_) {
-      case State::FH_FLAG:
-        if (c & ~GRPC_FH_COMPRESSED) {
-          // Unsupported flags.
-          return false;
-        }
-        frame_.flags_ = c;
-        state_ = State::FH_LEN_0;
-        mem++;
-        j++;
-        break;
-      case State::FH_LEN_0:
-        frame_.length_ = static_cast<uint32_t>(c) << 24;
-        state_ = State::FH_LEN_1;
-        mem++;
-        j++;
-        break;
-      case State::FH_LEN_1:
-        frame_.length_ |= static_cast<uint32_t>(c) << 16;
-        state_ = State::FH_LEN_2;
-        mem++;
-        j++;
-        break;
-      case State::FH_LEN_2:
-        frame_.length_ |= static_cast<uint32_t>(c) << 8;
-        state_ = State::FH_LEN_3;
-        mem++;
-        j++;
-        break;
-      case State::FH_LEN_3:
-        frame_.length_ |= static_cast<uint32_t>(c);
-        if (frame_.length_ == 0) {
-          output.push_back(std::move(frame_));
-          state_ = State::FH_FLAG;
-        } else {
-          frame_.data_.reset(new Buffer::OwnedImpl());
-          state_ = State::DATA;
-        }
-        mem++;
-        j++;
-        break;
-      case State::DATA:
-        uint64_t remain_in_buffer = slice.len_ - j;
-        uint64_t remain_in_frame = frame_.length_ - frame_.data_->length();
-        if (remain_in_buffer <= remain_in_frame) {
-          frame_.data_->add(mem, remain_in_buffer);
-          mem += remain_in_buffer;
-          j += remain_in_buffer;
-        } else {
-          frame_.data_->add(mem, remain_in_frame);
-          mem += remain_in_frame;
-          j += remain_in_frame;
-        }
-        if (frame_.length_ == frame_.data_->length()) {
-          output.push_back(std::move(frame_));
-          frame_.flags_ = 0;
-          frame_.length_ = 0;
-          state_ = State::FH_FLAG;
-        }
-        break;
+  while (input.length() > 0) {
+    if (state_ == State::DATA) {
+      // Move the frame payload rather than copying it. Whole buffer slices are handed over to the
+      // frame's buffer and only a partial trailing slice is copied.
+      const uint64_t remain_in_frame = frame_.length_ - frame_.data_->length();
+      frame_.data_->move(input, std::min(remain_in_frame, input.length()));
+      if (frame_.length_ == frame_.data_->length()) {
+        output.push_back(std::move(frame_));
+        frame_.flags_ = 0;
+        frame_.length_ = 0;
+        state_ = State::FH_FLAG;
       }
+      continue;
     }
+
+    if (state_ == State::FH_FLAG && input.length() >= FRAME_HEADER_SIZE) {
+      // Fast path: the whole frame header is available.
+      std::array<uint8_t, FRAME_HEADER_SIZE> header;
+      input.copyOut(0, FRAME_HEADER_SIZE, header.data());
+      if (header[0] & ~GRPC_FH_COMPRESSED) {
+        // Unsupported flags.
+        return false;
+      }
+      frame_.flags_ = header[0];
+      frame_.length_ = static_cast<uint32_t>(header[1]) << 24 |
+                       static_cast<uint32_t>(header[2]) << 16 |
+                       static_cast<uint32_t>(header[3]) << 8 | static_cast<uint32_t>(header[4]);
+      input.drain(FRAME_HEADER_SIZE);
+      onFrameHeaderComplete(output);
+      continue;
+    }
+
+    // The frame header is split across calls, decode it a byte at a time.
+    uint8_t c;
+    input.copyOut(0, 1, &c);
+    switch (state_) {
+    case State::FH_FLAG:
+      if (c & ~GRPC_FH_COMPRESSED) {
+        // Unsupported flags.
+        return false;
+      }
+      frame_.flags_ = c;
+      state_ = State::FH_LEN_0;
+      break;
+    case State::FH_LEN_0:
+      frame_.length_ = static_cast<uint32_t>(c) << 24;
+      state_ = State::FH_LEN_1;
+      break;
+    case State::FH_LEN_1:
+      frame_.length_ |= static_cast<uint32_t>(c) << 16;
+      state_ = State::FH_LEN_2;
+      break;
+    case State::FH_LEN_2:
+      frame_.length_ |= static_cast<uint32_t>(c) << 8;
+      state_ = State::FH_LEN_3;
+      break;
+    case State::FH_LEN_3:
+      frame_.length_ |= static_cast<uint32_t>(c);
+      onFrameHeaderComplete(output);
+      break;
+    case State::DATA:
+      NOT_REACHED;
+    }
+    input.drain(1);
   }
-  input.drain(input.length());
   return true;
 }
 
+void Decoder::onFrameHeaderComplete(std::vector<Frame>& output) {
+  if (frame_.length_ == 0) {
+    output.push_back(std::move(frame_));
+    state_ = State::FH_FLAG;
+  } else {
+    frame_.data_.reset(new Buffer::OwnedImpl());
+    state_ = State::DATA;
+  }
+}
+
 } // namespace Grpc
 } // namespace Envoy
@@ -38,8 +38,9 @@ public:
 
   // Decodes the given buffer with GRPC data frame. Drains the input buffer when
   // decoding succeeded (returns true). If the input is not sufficient to make a
-  // complete GRPC data frame, it will be buffered in the decoder. If a decoding
-  // error happened, the input buffer remains unchanged.
+  // complete GRPC data frame, it will be buffered in the decoder. Frame payloads
+  // are moved out of the input buffer rather than copied. If a decoding error
+  // happened, the input buffer is left starting at the invalid frame header.
   // @param input supplies the binary octets wrapped in a GRPC data frame.
   // @param output supplies the buffer to store the decoded data.
   // @return bool whether the decoding succeeded or not.
@@ -51,6 +52,12 @@ public:
   uint32_t length() const { return frame_.length_; }
 
 private:
+  static const uint64_t FRAME_HEADER_SIZE = 5;
+
+  // Emits zero length frames or prepares for reading the payload once the frame header has been
+  // decoded.
+  void onFrameHeaderComplete(std::vector<Frame>& output);
+
   // Wire format (http://www.grpc.io/docs/guides/wire.html) of GRPC data frame
   // header:
   //
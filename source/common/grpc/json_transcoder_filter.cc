@@ -8,6 +8,7 @@
 #include "common/common/utility.h"
 #include "common/filesystem/filesystem_impl.h"
 #include "common/grpc/common.h"
+#include "common/http/codes.h"
 #include "common/http/headers.h"
 #include "common/http/utility.h"
 #include "common/protobuf/protobuf.h"
@@ -249,6 +250,7 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::Continue;
   }
 
+  request_pending_bytes_ += data.length();
   request_in_.move(data);
 
   if (end_stream) {
@@ -256,6 +258,9 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
   }
 
   readToBuffer(*transcoder_->RequestOutput(), data);
+  if (data.length() > 0) {
+    request_pending_bytes_ = 0;
+  }
 
   const auto& request_status = transcoder_->RequestStatus();
 
@@ -267,6 +272,12 @@ Http::FilterDataStatus JsonTranscoderFilter::decodeData(Buffer::Instance& data,
 
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
+
+  // The transcoder holds the JSON input internally until a complete gRPC message can be emitted,
+  // so bound it the same way the connection manager bounds buffered request bodies.
+  if (decoderBufferLimitReached(request_pending_bytes_)) {
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
   return Http::FilterDataStatus::Continue;
 }
 
@@ -329,6 +340,11 @@ Http::FilterDataStatus JsonTranscoderFilter::encodeData(Buffer::Instance& data,
 
   readToBuffer(*transcoder_->ResponseOutput(), data);
 
+  // Bytes left in the response input are a partial gRPC frame that the transcoder is waiting on.
+  if (encoderBufferLimitReached(response_in_.BytesAvailable())) {
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+
   if (!method_->server_streaming()) {
     // Buffer until the response is complete.
     return Http::FilterDataStatus::StopIterationAndBuffer;
@@ -380,7 +396,35 @@ void JsonTranscoderFilter::setEncoderFilterCallbacks(
   encoder_callbacks_ = &callbacks;
 }
 
-// TODO(lizan): Incorporate watermarks to bound buffer sizes
+bool JsonTranscoderFilter::decoderBufferLimitReached(uint64_t buffer_length) {
+  const uint32_t limit = decoder_callbacks_->decoderBufferLimit();
+  if (limit == 0 || buffer_length <= limit) {
+    return false;
+  }
+
+  ENVOY_LOG(debug, "Transcoding request too large: {} bytes pending, limit {}", buffer_length,
+            limit);
+  error_ = true;
+  Http::Utility::sendLocalReply(*decoder_callbacks_, stream_reset_, Http::Code::PayloadTooLarge,
+                                Http::CodeUtility::toString(Http::Code::PayloadTooLarge));
+  return true;
+}
+
+bool JsonTranscoderFilter::encoderBufferLimitReached(uint64_t buffer_length) {
+  const uint32_t limit = encoder_callbacks_->encoderBufferLimit();
+  if (limit == 0 || buffer_length <= limit) {
+    return false;
+  }
+
+  // Response headers may already have been sent for server streaming methods, so the only option
+  // left is to reset the stream.
+  ENVOY_LOG(debug, "Transcoding response too large: {} bytes pending, limit {}", buffer_length,
+            limit);
+  error_ = true;
+  encoder_callbacks_->resetStream();
+  return true;
+}
+
 bool JsonTranscoderFilter::readToBuffer(Protobuf::io::ZeroCopyInputStream& stream,
                                         Buffer::Instance& data) {
   const void* out;
@@ -102,6 +102,15 @@ public:
 private:
   bool readToBuffer(Protobuf::io::ZeroCopyInputStream& stream, Buffer::Instance& data);
 
+  /**
+   * Check the number of bytes held by the transcoder against the stream's buffer limit, and fail
+   * the stream if it is exceeded. A limit of 0 means no limit.
+   * @param buffer_length supplies the number of bytes held.
+   * @return bool true if the limit was exceeded and the stream was failed.
+   */
+  bool decoderBufferLimitReached(uint64_t buffer_length);
+  bool encoderBufferLimitReached(uint64_t buffer_length);
+
   JsonTranscoderConfig& config_;
   std::unique_ptr<google::grpc::transcoding::Transcoder> transcoder_;
   TranscoderInputStreamImpl request_in_;
@@ -110,6 +119,8 @@ private:
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_{nullptr};
   const Protobuf::MethodDescriptor* method_{nullptr};
   Http::HeaderMap* response_headers_{nullptr};
+  // Request bytes received since the transcoder last produced output.
+  uint64_t request_pending_bytes_{0};
 
   bool error_{false};
   bool stream_reset_{false};
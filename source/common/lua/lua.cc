@@ -7,8 +7,25 @@
 namespace Envoy {
 namespace Lua {
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     CoroutinePool* pool)
+    : coroutine_state_(new_thread_state, false), parent_state_(new_thread_state.second),
+      pool_(pool) {}
+
+Coroutine::~Coroutine() {
+  // A Lua thread can only be started again if it never ran or ran to completion without error. A
+  // yielded thread still has a live call frame, and an errored thread is dead.
+  if (pool_ == nullptr || pool_->closing_ || state_ == State::Yielded || errored_ ||
+      pool_->refs_.size() >= MAX_POOLED_COROUTINES) {
+    return;
+  }
+
+  // Drop anything left on the stack so that it can be collected, then take an additional registry
+  // reference for the pool before our own reference is released.
+  lua_settop(coroutine_state_.get(), 0);
+  coroutine_state_.pushStack();
+  pool_->refs_.push_back(luaL_ref(parent_state_, LUA_REGISTRYINDEX));
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -36,6 +53,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
     yield_callback();
   } else {
     state_ = State::Finished;
+    errored_ = true;
     const char* error = lua_tostring(coroutine_state_.get(), -1);
     throw LuaException(error);
   }
@@ -44,20 +62,35 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
 ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls)
     : tls_slot_(tls.allocateSlot()) {
 
-  // First verify that the supplied code can be parsed.
+  // First verify that the supplied code can be parsed and run. While the chunk is loaded, dump it
+  // to bytecode so that workers do not need to parse and compile the script again.
   CSmartPtr<lua_State, lua_close> state(lua_open());
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  if (0 != luaL_loadstring(state.get(), code.c_str())) {
+    throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
+  }
+
+  std::string bytecode;
+  int rc = lua_dump(state.get(), bytecodeWriter, &bytecode);
+  ASSERT(rc == 0);
+  UNREFERENCED_PARAMETER(rc);
+
+  if (0 != lua_pcall(state.get(), 0, LUA_MULTRET, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
   // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) {
-    return ThreadLocal::ThreadLocalObjectSharedPtr{new LuaThreadLocal(code)};
+  tls_slot_->set([bytecode](Event::Dispatcher&) {
+    return ThreadLocal::ThreadLocalObjectSharedPtr{new LuaThreadLocal(bytecode)};
   });
 }
 
+int ThreadLocalState::bytecodeWriter(lua_State*, const void* data, size_t size, void* bytecode) {
+  static_cast<std::string*>(bytecode)->append(static_cast<const char*>(data), size);
+  return 0;
+}
+
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
   LuaThreadLocal& tls = tls_slot_->getTyped<LuaThreadLocal>();
   ASSERT(tls.global_slots_.size() > slot);
@@ -81,16 +114,32 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global) {
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tls_slot_->getTyped<LuaThreadLocal>().state_.get();
-  return CoroutinePtr{new Coroutine({lua_newthread(state), state})};
+  LuaThreadLocal& tls = tls_slot_->getTyped<LuaThreadLocal>();
+  lua_State* state = tls.state_.get();
+  if (tls.coroutine_pool_.refs_.empty()) {
+    return CoroutinePtr{new Coroutine({lua_newthread(state), state}, &tls.coroutine_pool_)};
+  }
+
+  // Push the pooled thread so that the new coroutine can take its own reference to it, and then
+  // release the pool's reference.
+  const int ref = tls.coroutine_pool_.refs_.back();
+  tls.coroutine_pool_.refs_.pop_back();
+  lua_rawgeti(state, LUA_REGISTRYINDEX, ref);
+  lua_State* thread = lua_tothread(state, -1);
+  luaL_unref(state, LUA_REGISTRYINDEX, ref);
+  return CoroutinePtr{new Coroutine({thread, state}, &tls.coroutine_pool_)};
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code) : state_(lua_open()) {
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& bytecode)
+    : state_(lua_open()) {
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  int rc = luaL_loadbuffer(state_.get(), bytecode.data(), bytecode.size(), "bytecode") ||
+           lua_pcall(state_.get(), 0, LUA_MULTRET, 0);
   ASSERT(rc == 0);
   UNREFERENCED_PARAMETER(rc);
 }
 
+ThreadLocalState::LuaThreadLocal::~LuaThreadLocal() { coroutine_pool_.closing_ = true; }
+
 } // namespace Lua
 } // namespace Envoy
@@ -41,7 +41,7 @@ namespace Lua {
  */
 #define DECLARE_LUA_FUNCTION_EX(Class, Name, Index)                                                \
   static int static_##Name(lua_State* state) {                                                     \
-    Class* object = static_cast<Class*>(luaL_checkudata(state, Index, typeid(Class).name()));      \
+    Class* object = Class::checkUserData(state, Index);                                            \
     object->checkDead(state);                                                                      \
     return object->Name(state);                                                                    \
   }                                                                                                \
@@ -89,7 +89,7 @@ public:
   static std::pair<T*, lua_State*> create(lua_State* state, ConstructorArgs&&... args) {
     // Create a new user data and assign its metatable.
     void* mem = lua_newuserdata(state, sizeof(T));
-    luaL_getmetatable(state, typeid(T).name());
+    pushMetatable(state);
     ASSERT(lua_istable(state, -1));
     lua_setmetatable(state, -2);
 
@@ -98,6 +98,29 @@ public:
     return {new (mem) T(std::forward<ConstructorArgs>(args)...), state};
   }
 
+  /**
+   * Check that the value at the given stack index is userdata of this type. This is the equivalent
+   * of luaL_checkudata() but the metatable is looked up via a light userdata registry key instead
+   * of by the type name string, which avoids hashing and interning the name on every call.
+   * @param state supplies the owning Lua state.
+   * @param index supplies the stack index to check.
+   * @return T* the object. Raises a Lua error if the value is not of this type.
+   */
+  static T* checkUserData(lua_State* state, int index) {
+    void* object = lua_touserdata(state, index);
+    if (object != nullptr && lua_getmetatable(state, index)) {
+      pushMetatable(state);
+      const bool matches = lua_rawequal(state, -1, -2);
+      lua_pop(state, 2);
+      if (matches) {
+        return static_cast<T*>(object);
+      }
+    }
+
+    luaL_typerror(state, index, typeid(T).name());
+    NOT_REACHED;
+  }
+
   /**
    * Register a type with Lua.
    * @param state supplies the state to register with.
@@ -116,7 +139,7 @@ public:
     // manually because the memory is raw and was allocated by Lua.
     to_register.push_back(
         {"__gc", [](lua_State* state) {
-           T* object = static_cast<T*>(luaL_checkudata(state, 1, typeid(T).name()));
+           T* object = checkUserData(state, 1);
            ENVOY_LOG(trace, "destroying {} at {}", typeid(T).name(), static_cast<void*>(object));
            object->~T();
            return 0;
@@ -135,6 +158,12 @@ public:
     lua_pushvalue(state, -1);
     lua_setfield(state, -2, "__index");
     luaL_register(state, nullptr, to_register.data());
+
+    // Also store the metatable under this type's light userdata key for fast lookup. See
+    // pushMetatable().
+    lua_pushlightuserdata(state, metatableKey());
+    lua_pushvalue(state, -2);
+    lua_rawset(state, LUA_REGISTRYINDEX);
   }
 
   /**
@@ -185,6 +214,22 @@ protected:
   virtual void onMarkLive() {}
 
 private:
+  /**
+   * @return a unique address per type used as the registry key for the type's metatable.
+   */
+  static void* metatableKey() {
+    static char key;
+    return &key;
+  }
+
+  /**
+   * Push the metatable for this type onto the stack.
+   */
+  static void pushMetatable(lua_State* state) {
+    lua_pushlightuserdata(state, metatableKey());
+    lua_rawget(state, LUA_REGISTRYINDEX);
+  }
+
   bool dead_{};
 };
 
@@ -292,6 +337,16 @@ public:
   }
 };
 
+/**
+ * Registry references to finished Lua threads that can be reused by new coroutines.
+ */
+struct CoroutinePool {
+  std::vector<int> refs_;
+  // Set while the owning Lua state is being closed. Coroutines owned by Lua objects are destroyed
+  // then, and their threads can't be returned to the pool anymore.
+  bool closing_{};
+};
+
 /**
  * This is a wraper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -300,7 +355,16 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param new_thread_state supplies the coroutine state and its owning state. The coroutine state
+   *        must be at the top of the owning state's stack.
+   * @param pool supplies an optional pool of registry references that the underlying Lua thread
+   *        is returned to on destruction if the coroutine can be safely reused.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            CoroutinePool* pool = nullptr);
+  ~Coroutine();
+
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
@@ -323,8 +387,14 @@ public:
   void resume(int num_args, const std::function<void()>& yield_callback);
 
 private:
+  // The maximum number of idle Lua threads kept per worker for reuse.
+  static const size_t MAX_POOLED_COROUTINES = 128;
+
   LuaRef<lua_State> coroutine_state_;
+  lua_State* parent_state_;
+  CoroutinePool* pool_;
   State state_{State::NotStarted};
+  bool errored_{};
 };
 
 typedef std::unique_ptr<Coroutine> CoroutinePtr;
@@ -339,7 +409,8 @@ public:
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a new coroutine. If possible, the underlying Lua thread is taken from a
+   *         per-worker pool of previously finished coroutines rather than newly allocated.
    */
   CoroutinePtr createCoroutine();
 
@@ -367,9 +438,14 @@ public:
   }
 
 private:
+  static int bytecodeWriter(lua_State*, const void* data, size_t size, void* bytecode);
+
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& bytecode);
+    ~LuaThreadLocal();
 
+    // Declared before state_ so that it outlives the coroutines destroyed while closing the state.
+    CoroutinePool coroutine_pool_;
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
   };
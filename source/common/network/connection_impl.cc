@@ -5,6 +5,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 
@@ -134,14 +135,14 @@ void ConnectionImpl::close(ConnectionCloseType type) {
     return;
   }
 
-  uint64_t data_to_write = write_buffer_->length();
+  uint64_t data_to_write = write_buffer_->length() + splicePipeLength();
   ENVOY_CONN_LOG(debug, "closing data_to_write={} type={}", *this, data_to_write, enumToInt(type));
   if (data_to_write == 0 || type == ConnectionCloseType::NoFlush ||
       !transport_socket_->canFlushClose()) {
     if (data_to_write > 0) {
       // We aren't going to wait to flush, but try to write as much as we can if there is pending
       // data.
-      transport_socket_->doWrite(*write_buffer_);
+      doWriteInOrder();
     }
 
     closeSocket(ConnectionEvent::LocalClose);
@@ -171,6 +172,7 @@ void ConnectionImpl::closeSocket(ConnectionEvent close_type) {
 
   ENVOY_CONN_LOG(debug, "closing socket: {}", *this, static_cast<uint32_t>(close_type));
   transport_socket_->closeSocket(close_type);
+  stopSplice();
 
   // Drain input and output buffers.
   updateReadBufferStats(0, 0);
@@ -305,6 +307,10 @@ void ConnectionImpl::write(Buffer::Instance& data) {
   // NOTE: This is kind of a hack, but currently we don't support restart/continue on the write
   //       path, so we just pass around the buffer passed to us in this function. If we ever support
   //       buffer/restart/continue on the write path this needs to get more complicated.
+  // While data is being spliced in, anything written here could be overtaken by it. Once splicing
+  // stops, doWriteInOrder() flushes the pipe before anything written here.
+  ASSERT(splice_source_ == nullptr);
+
   current_write_buffer_ = &data;
   FilterStatus status = filter_manager_.onWrite();
   current_write_buffer_ = nullptr;
@@ -318,9 +324,9 @@ void ConnectionImpl::write(Buffer::Instance& data) {
     // TODO(mattklein123): All data currently gets moved from the source buffer to the write buffer.
     // This can lead to inefficient behavior if writing a bunch of small chunks. In this case, it
     // would likely be more efficient to copy data below a certain size. VERY IMPORTANT: If this is
-    // ever changed, read the comment in Ssl::ConnectionImpl::doWriteToSocket() VERY carefully.
-    // That code assumes that we never change existing write_buffer_ chain elements between calls
-    // to SSL_write(). That code will have to change if we ever copy here.
+    // ever changed, read the comment in Ssl::SslSocket::doWrite() VERY carefully. That code
+    // assumes that the data at the front of write_buffer_ never changes between calls to
+    // SSL_write(). That code will have to change if we ever modify data already buffered here.
     write_buffer_->move(data);
 
     // Activating a write event before the socket is connected has the side-effect of tricking
@@ -421,6 +427,11 @@ void ConnectionImpl::onReadReady() {
 
   ASSERT(!(state_ & InternalState::Connecting));
 
+  if (splice_destination_ != nullptr) {
+    onSpliceReadReady();
+    return;
+  }
+
   IoResult result = transport_socket_->doRead(read_buffer_);
   uint64_t new_buffer_size = read_buffer_.length();
   updateReadBufferStats(result.bytes_processed_, new_buffer_size);
@@ -459,8 +470,8 @@ void ConnectionImpl::onWriteReady() {
     }
   }
 
-  IoResult result = transport_socket_->doWrite(*write_buffer_);
-  uint64_t new_buffer_size = write_buffer_->length();
+  IoResult result = doWriteInOrder();
+  uint64_t new_buffer_size = write_buffer_->length() + splicePipeLength();
   updateWriteBufferStats(result.bytes_processed_, new_buffer_size);
 
   if (result.action_ == PostIoAction::Close) {
@@ -534,6 +545,145 @@ void ConnectionImpl::updateWriteBufferStats(uint64_t num_written, uint64_t new_s
                                            connection_stats_->write_current_);
 }
 
+bool ConnectionImpl::spliceTo(Connection& destination, BytesSplicedCb cb) {
+  ConnectionImpl* peer = dynamic_cast<ConnectionImpl*>(&destination);
+  if (peer == nullptr || peer == this || splice_destination_ != nullptr ||
+      peer->splice_source_ != nullptr || !canSplice() || !peer->canSplice()) {
+    return false;
+  }
+
+  // The pipe holds the data on its way to the destination, in place of its write buffer.
+  SplicePipePtr pipe = SplicePipe::create();
+  if (pipe == nullptr) {
+    ENVOY_CONN_LOG(debug, "unable to create splice pipe", *this);
+    return false;
+  }
+
+  ENVOY_CONN_LOG(debug, "splicing to [C{}]", *this, peer->id());
+  // The pipe can never hold more than its capacity, so the high watermark must be reachable for
+  // watermark callbacks to fire. A limit of 0 disables them, as it does for the write buffer.
+  if (peer->read_buffer_limit_ > 0) {
+    peer->splice_high_watermark_ =
+        std::min<uint64_t>(peer->read_buffer_limit_ + 1, pipe->capacity());
+  }
+  peer->splice_pipe_ = std::move(pipe);
+  peer->splice_source_ = this;
+  splice_destination_ = peer;
+  bytes_spliced_cb_ = cb;
+  return true;
+}
+
+bool ConnectionImpl::canSplice() const {
+  // Any other filter or a transport socket which transforms the data needs to see the bytes.
+  return state() == State::Open && !(state_ & InternalState::Connecting) &&
+         filter_manager_.singleReadFilter() &&
+         dynamic_cast<RawBufferSocket*>(transport_socket_.get()) != nullptr &&
+         read_buffer_.length() == 0 && write_buffer_->length() == 0;
+}
+
+void ConnectionImpl::onSpliceReadReady() {
+  ConnectionImpl& destination = *splice_destination_;
+  SplicePipe& pipe = *destination.splice_pipe_;
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_read = 0;
+  while (pipe.length() < pipe.capacity()) {
+    int rc = pipe.fill(fd_, pipe.capacity() - pipe.length());
+    ENVOY_CONN_LOG(trace, "splice read returns: {}", *this, rc);
+    if (rc == 0) {
+      action = PostIoAction::Close;
+      break;
+    } else if (rc == -1) {
+      ENVOY_CONN_LOG(trace, "splice read error: {}", *this, errno);
+      if (errno != EAGAIN) {
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+    bytes_read += rc;
+  }
+
+  updateReadBufferStats(bytes_read, read_buffer_.length());
+  if (bytes_read > 0) {
+    destination.onSplicedData();
+    bytes_spliced_cb_(bytes_read);
+  }
+
+  if (action == PostIoAction::Close && fd_ != -1) {
+    ENVOY_CONN_LOG(debug, "remote close", *this);
+    closeSocket(ConnectionEvent::RemoteClose);
+  }
+}
+
+void ConnectionImpl::onSplicedData() {
+  updateWriteBufferStats(0, write_buffer_->length() + splicePipeLength());
+  if (splice_high_watermark_ > 0 && !above_high_watermark_ &&
+      splicePipeLength() >= splice_high_watermark_) {
+    onHighWatermark();
+  }
+  file_event_->activate(Event::FileReadyType::Write);
+}
+
+IoResult ConnectionImpl::doWriteInOrder() {
+  if (splicePipeLength() == 0) {
+    return transport_socket_->doWrite(*write_buffer_);
+  }
+
+  // Anything in write_buffer_ was written once splicing stopped, after the data still in the pipe.
+  IoResult result = doSpliceWrite();
+  if (splicePipeLength() == 0 && result.action_ == PostIoAction::KeepOpen) {
+    IoResult write_result = transport_socket_->doWrite(*write_buffer_);
+    result.action_ = write_result.action_;
+    result.bytes_processed_ += write_result.bytes_processed_;
+  }
+  return result;
+}
+
+IoResult ConnectionImpl::doSpliceWrite() {
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_written = 0;
+  while (splice_pipe_->length() > 0) {
+    int rc = splice_pipe_->drain(fd_);
+    ENVOY_CONN_LOG(trace, "splice write returns: {}", *this, rc);
+    if (rc == -1) {
+      ENVOY_CONN_LOG(trace, "splice write error: {}", *this, errno);
+      if (errno != EAGAIN) {
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+    bytes_written += rc;
+  }
+
+  if (bytes_written > 0) {
+    if (above_high_watermark_ && splice_pipe_->length() <= splice_high_watermark_ / 2) {
+      onLowWatermark();
+    }
+    // An EAGAIN from the source does not tell whether its socket ran dry or the pipe filled up, in
+    // which case no further read event would arrive. Let the source try again now there is room.
+    if (splice_source_ != nullptr && splice_source_->readEnabled()) {
+      splice_source_->file_event_->activate(Event::FileReadyType::Read);
+    }
+  }
+
+  return {action, bytes_written};
+}
+
+void ConnectionImpl::stopSplice() {
+  if (splice_destination_ != nullptr) {
+    // The destination keeps the pipe so that it can still flush the data in it.
+    splice_destination_->splice_source_ = nullptr;
+    splice_destination_ = nullptr;
+    bytes_spliced_cb_ = nullptr;
+  }
+
+  if (splice_source_ != nullptr) {
+    splice_source_->splice_destination_ = nullptr;
+    splice_source_->bytes_spliced_cb_ = nullptr;
+    splice_source_ = nullptr;
+  }
+  splice_pipe_.reset();
+}
+
 ClientConnectionImpl::ClientConnectionImpl(Event::Dispatcher& dispatcher,
                                            const Address::InstanceConstSharedPtr& remote_address,
                                            const Address::InstanceConstSharedPtr& source_address)
@@ -15,6 +15,7 @@
 #include "common/common/logger.h"
 #include "common/event/libevent.h"
 #include "common/network/filter_manager_impl.h"
+#include "common/network/splice_pipe.h"
 
 namespace Envoy {
 namespace Network {
@@ -89,6 +90,7 @@ public:
   uint32_t bufferLimit() const override { return read_buffer_limit_; }
   bool usingOriginalDst() const override { return using_original_dst_; }
   bool aboveHighWatermark() const override { return above_high_watermark_; }
+  bool spliceTo(Connection& destination, BytesSplicedCb cb) override;
 
   // Network::BufferSource
   Buffer::Instance& getReadBuffer() override { return read_buffer_; }
@@ -143,6 +145,14 @@ private:
   void onWriteReady();
   void updateReadBufferStats(uint64_t num_read, uint64_t new_size);
   void updateWriteBufferStats(uint64_t num_written, uint64_t new_size);
+  bool canSplice() const;
+  void onSpliceReadReady();
+  void onSplicedData();
+  // Write the data spliced into the pipe, then write_buffer_ once the pipe is empty.
+  IoResult doWriteInOrder();
+  IoResult doSpliceWrite();
+  void stopSplice();
+  uint64_t splicePipeLength() const { return splice_pipe_ ? splice_pipe_->length() : 0; }
 
   static std::atomic<uint64_t> next_global_id_;
 
@@ -164,6 +174,14 @@ private:
   const bool using_original_dst_;
   bool above_high_watermark_{false};
   bool detect_early_close_{true};
+  // Set while data read from this connection is spliced to splice_destination_.
+  ConnectionImpl* splice_destination_{};
+  BytesSplicedCb bytes_spliced_cb_;
+  // Set while data read from splice_source_ is spliced to this connection. The pipe holds the
+  // data that has not been written to the socket yet and takes the place of the write buffer.
+  ConnectionImpl* splice_source_{};
+  SplicePipePtr splice_pipe_;
+  uint64_t splice_high_watermark_{};
 };
 
 /**
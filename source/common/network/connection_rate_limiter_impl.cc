@@ -0,0 +1,44 @@
+#include "common/network/connection_rate_limiter_impl.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+#include "common/common/assert.h"
+#include "common/common/utility.h"
+
+namespace Envoy {
+namespace Network {
+
+ConnectionRateLimiterImpl::ConnectionRateLimiterImpl(uint32_t connections_per_second)
+    : connections_per_second_(connections_per_second), tokens_(connections_per_second),
+      last_refill_(ProdMonotonicTimeSource::instance_.currentTime()) {
+  ASSERT(connections_per_second_ > 0);
+}
+
+std::chrono::milliseconds ConnectionRateLimiterImpl::consume() {
+  std::lock_guard<std::mutex> guard(lock_);
+  const MonotonicTime now = ProdMonotonicTimeSource::instance_.currentTime();
+  const double elapsed_seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(now - last_refill_).count();
+  tokens_ = std::min<double>(connections_per_second_,
+                             tokens_ + elapsed_seconds * connections_per_second_);
+  last_refill_ = now;
+  if (tokens_ >= 1) {
+    tokens_ -= 1;
+    return std::chrono::milliseconds(0);
+  }
+
+  // Round up so that the next token is due when the caller tries again.
+  return std::chrono::milliseconds(
+      static_cast<uint64_t>(std::ceil((1 - tokens_) * 1000 / connections_per_second_)));
+}
+
+void ConnectionRateLimiterImpl::refund() {
+  std::lock_guard<std::mutex> guard(lock_);
+  tokens_ = std::min<double>(connections_per_second_, tokens_ + 1);
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#include "envoy/common/time.h"
+#include "envoy/network/listener.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Token bucket implementation of ConnectionRateLimiter, holding up to one second worth of
+ * connections.
+ */
+class ConnectionRateLimiterImpl : public ConnectionRateLimiter {
+public:
+  ConnectionRateLimiterImpl(uint32_t connections_per_second);
+
+  // Network::ConnectionRateLimiter
+  std::chrono::milliseconds consume() override;
+  void refund() override;
+
+private:
+  const uint32_t connections_per_second_;
+  std::mutex lock_;
+  double tokens_;
+  MonotonicTime last_refill_;
+};
+
+} // namespace Network
+} // namespace Envoy
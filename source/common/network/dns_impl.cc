@@ -1,9 +1,12 @@
 #include "common/network/dns_impl.h"
 
+#include <arpa/inet.h>
+#include <arpa/nameser.h>
 #include <netdb.h>
 #include <netinet/ip.h>
 #include <sys/socket.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -11,6 +14,7 @@
 #include <string>
 
 #include "common/common/assert.h"
+#include "common/common/utility.h"
 #include "common/network/address_impl.h"
 #include "common/network/utility.h"
 
@@ -19,11 +23,84 @@
 namespace Envoy {
 namespace Network {
 
+namespace {
+
+// The number of records whose TTL is considered when caching a reply. Replies with more addresses
+// than this are still returned in full.
+const int MaxAddressTtls = 32;
+
+// The c-ares lookup order when the system configuration doesn't specify one: the hosts file ('f')
+// followed by DNS ('b').
+const char DefaultLookups[] = "fb";
+
+void addressListFromHostent(const hostent& hostent,
+                            std::list<Address::InstanceConstSharedPtr>& address_list) {
+  if (hostent.h_addrtype == AF_INET) {
+    for (int i = 0; hostent.h_addr_list[i] != nullptr; ++i) {
+      ASSERT(hostent.h_length == sizeof(in_addr));
+      sockaddr_in address;
+      memset(&address, 0, sizeof(address));
+      address.sin_family = AF_INET;
+      address.sin_port = 0;
+      address.sin_addr = *reinterpret_cast<in_addr*>(hostent.h_addr_list[i]);
+      address_list.emplace_back(new Address::Ipv4Instance(&address));
+    }
+  } else if (hostent.h_addrtype == AF_INET6) {
+    for (int i = 0; hostent.h_addr_list[i] != nullptr; ++i) {
+      ASSERT(hostent.h_length == sizeof(in6_addr));
+      sockaddr_in6 address;
+      memset(&address, 0, sizeof(address));
+      address.sin6_family = AF_INET6;
+      address.sin6_port = 0;
+      address.sin6_addr = *reinterpret_cast<in6_addr*>(hostent.h_addr_list[i]);
+      address_list.emplace_back(new Address::Ipv6Instance(address));
+    }
+  }
+}
+
+/**
+ * Parse an A or AAAA reply into a list of addresses and the lowest TTL of the records.
+ * @return the c-ares status of parsing the reply.
+ */
+int parseAddressReply(int family, const unsigned char* abuf, int alen,
+                      std::list<Address::InstanceConstSharedPtr>& address_list,
+                      std::chrono::seconds& ttl) {
+  hostent* hostent = nullptr;
+  int naddrttls = MaxAddressTtls;
+  int status;
+  int min_ttl = 0;
+  if (family == AF_INET) {
+    ares_addrttl addrttls[MaxAddressTtls];
+    status = ares_parse_a_reply(abuf, alen, &hostent, addrttls, &naddrttls);
+    for (int i = 0; status == ARES_SUCCESS && i < naddrttls; ++i) {
+      min_ttl = i == 0 ? addrttls[i].ttl : std::min(min_ttl, addrttls[i].ttl);
+    }
+  } else {
+    ares_addr6ttl addrttls[MaxAddressTtls];
+    status = ares_parse_aaaa_reply(abuf, alen, &hostent, addrttls, &naddrttls);
+    for (int i = 0; status == ARES_SUCCESS && i < naddrttls; ++i) {
+      min_ttl = i == 0 ? addrttls[i].ttl : std::min(min_ttl, addrttls[i].ttl);
+    }
+  }
+
+  if (status == ARES_SUCCESS) {
+    addressListFromHostent(*hostent, address_list);
+    ttl = std::chrono::seconds(std::max(min_ttl, 0));
+  }
+  if (hostent != nullptr) {
+    ares_free_hostent(hostent);
+  }
+  return status;
+}
+
+} // namespace
+
 DnsResolverImpl::DnsResolverImpl(
     Event::Dispatcher& dispatcher,
-    const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers)
+    const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers, Stats::Scope& scope)
     : dispatcher_(dispatcher),
-      timer_(dispatcher.createTimer([this] { onEventCallback(ARES_SOCKET_BAD, 0); })) {
+      timer_(dispatcher.createTimer([this] { onEventCallback(ARES_SOCKET_BAD, 0); })),
+      stats_{ALL_DNS_RESOLVER_STATS(POOL_COUNTER_PREFIX(scope, "dns."))} {
   // This is also done in main(), to satisfy the requirement that c-ares is
   // initialized prior to threading. The additional call to ares_library_init()
   // here is a nop in normal execution, but exists for testing where we don't
@@ -57,66 +134,89 @@ void DnsResolverImpl::initializeChannel(ares_options* options, int optmask) {
   };
   options->sock_state_cb_data = this;
   ares_init_options(&channel_, options, optmask | ARES_OPT_SOCK_STATE_CB);
+
+  // Latch the lookup order c-ares derived from the system configuration (e.g. nsswitch.conf), so
+  // that the hosts file is consulted before or after DNS the way ares_gethostbyname() would.
+  ares_options saved_options;
+  int saved_optmask;
+  lookups_ = DefaultLookups;
+  if (ares_save_options(channel_, &saved_options, &saved_optmask) == ARES_SUCCESS) {
+    if ((saved_optmask & ARES_OPT_LOOKUPS) && saved_options.lookups != nullptr) {
+      lookups_ = saved_options.lookups;
+    }
+    ares_destroy_options(&saved_options);
+  }
+}
+
+bool DnsResolverImpl::hostsFileBeforeDns() const {
+  const size_t file = lookups_.find('f');
+  return file != std::string::npos && file < lookups_.find('b');
+}
+
+bool DnsResolverImpl::hostsFileAfterDns() const {
+  const size_t file = lookups_.find('f');
+  return file != std::string::npos && lookups_.find('b') < file;
 }
 
-void DnsResolverImpl::PendingResolution::onAresHostCallback(int status, int timeouts,
-                                                            hostent* hostent) {
-  // We receive ARES_EDESTRUCTION when destructing with pending queries.
+void DnsResolverImpl::PendingResolution::onAresQueryCallback(int status, int timeouts,
+                                                             unsigned char* abuf, int alen) {
+  // We receive ARES_EDESTRUCTION when destructing with pending queries. The resolution is freed
+  // along with the resolver, without invoking any callbacks.
   if (status == ARES_EDESTRUCTION) {
-    ASSERT(owned_);
-    delete this;
     return;
   }
-  if (status == ARES_SUCCESS || !fallback_if_failed_) {
-    completed_ = true;
-  }
 
   std::list<Address::InstanceConstSharedPtr> address_list;
+  std::chrono::seconds ttl(0);
   if (status == ARES_SUCCESS) {
-    if (hostent->h_addrtype == AF_INET) {
-      for (int i = 0; hostent->h_addr_list[i] != nullptr; ++i) {
-        ASSERT(hostent->h_length == sizeof(in_addr));
-        sockaddr_in address;
-        memset(&address, 0, sizeof(address));
-        address.sin_family = AF_INET;
-        address.sin_port = 0;
-        address.sin_addr = *reinterpret_cast<in_addr*>(hostent->h_addr_list[i]);
-        address_list.emplace_back(new Address::Ipv4Instance(&address));
-      }
-    } else if (hostent->h_addrtype == AF_INET6) {
-      for (int i = 0; hostent->h_addr_list[i] != nullptr; ++i) {
-        ASSERT(hostent->h_length == sizeof(in6_addr));
-        sockaddr_in6 address;
-        memset(&address, 0, sizeof(address));
-        address.sin6_family = AF_INET6;
-        address.sin6_port = 0;
-        address.sin6_addr = *reinterpret_cast<in6_addr*>(hostent->h_addr_list[i]);
-        address_list.emplace_back(new Address::Ipv6Instance(address));
-      }
-    }
+    status = parseAddressReply(family_, abuf, alen, address_list, ttl);
   }
 
   if (timeouts > 0) {
     ENVOY_LOG(debug, "DNS request timed out {} times", timeouts);
   }
 
-  if (completed_) {
-    if (!cancelled_) {
-      callback_(std::move(address_list));
-    }
-    if (owned_) {
-      delete this;
-      return;
-    }
-  }
-
   if (status != ARES_SUCCESS && fallback_if_failed_) {
     fallback_if_failed_ = false;
-    getHostByName(AF_INET);
-    // Note: Nothing can follow this call to getHostByName due to deletion of this
+    search(AF_INET);
+    // Note: Nothing can follow this call to search due to deletion of this
     // object upon synchronous resolution.
     return;
   }
+
+  parent_.onResolutionComplete(*this, std::move(address_list), ttl);
+}
+
+void DnsResolverImpl::onResolutionComplete(
+    PendingResolution& resolution, std::list<Address::InstanceConstSharedPtr>&& address_list,
+    std::chrono::seconds ttl) {
+  // Take the resolution out of the map before invoking any callbacks, so that they can start a new
+  // resolution of the same name.
+  auto it = pending_resolutions_.find(resolution.key_);
+  ASSERT(it != pending_resolutions_.end() && it->second.get() == &resolution);
+  PendingResolutionPtr completed = std::move(it->second);
+  pending_resolutions_.erase(it);
+
+  if (address_list.empty() && hostsFileAfterDns()) {
+    resolveFromHostsFile(completed->key_.first, completed->key_.second, address_list);
+  } else if (!address_list.empty() && ttl.count() > 0) {
+    // Failures are not cached, so that they are retried on the next resolution.
+    const MonotonicTime now = ProdMonotonicTimeSource::instance_.currentTime();
+    sweepCache(now);
+    const auto existing = cache_.find(completed->key_);
+    if (existing != cache_.end()) {
+      eraseCacheEntry(existing);
+    }
+    cache_[completed->key_] = {address_list,
+                               cache_expiries_.emplace(now + ttl, completed->key_)};
+  }
+
+  for (const PendingQueryPtr& query : completed->queries_) {
+    if (!query->cancelled_) {
+      std::list<Address::InstanceConstSharedPtr> results = address_list;
+      query->callback_(std::move(results));
+    }
+  }
 }
 
 void DnsResolverImpl::updateAresTimer() {
@@ -161,45 +261,136 @@ void DnsResolverImpl::onAresSocketStateChange(int fd, int read, int write) {
                           (write ? Event::FileReadyType::Write : 0));
 }
 
+void DnsResolverImpl::sweepCache(MonotonicTime now) {
+  while (!cache_expiries_.empty() && cache_expiries_.begin()->first <= now) {
+    cache_.erase(cache_expiries_.begin()->second);
+    cache_expiries_.erase(cache_expiries_.begin());
+  }
+}
+
+void DnsResolverImpl::eraseCacheEntry(std::map<ResolutionKey, CacheEntry>::iterator entry) {
+  cache_expiries_.erase(entry->second.expiry_);
+  cache_.erase(entry);
+}
+
+bool DnsResolverImpl::resolveLiteral(const std::string& dns_name,
+                                     DnsLookupFamily dns_lookup_family,
+                                     std::list<Address::InstanceConstSharedPtr>& address_list) {
+  // A literal of a family excluded by the lookup family resolves to no addresses, as it would
+  // with ares_gethostbyname().
+  sockaddr_in address4;
+  memset(&address4, 0, sizeof(address4));
+  if (inet_pton(AF_INET, dns_name.c_str(), &address4.sin_addr) == 1) {
+    if (dns_lookup_family != DnsLookupFamily::V6Only) {
+      address4.sin_family = AF_INET;
+      address_list.emplace_back(new Address::Ipv4Instance(&address4));
+    }
+    return true;
+  }
+  sockaddr_in6 address6;
+  memset(&address6, 0, sizeof(address6));
+  if (inet_pton(AF_INET6, dns_name.c_str(), &address6.sin6_addr) == 1) {
+    if (dns_lookup_family != DnsLookupFamily::V4Only) {
+      address6.sin6_family = AF_INET6;
+      address_list.emplace_back(new Address::Ipv6Instance(address6));
+    }
+    return true;
+  }
+  return false;
+}
+
+bool DnsResolverImpl::resolveFromHostsFile(
+    const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+    std::list<Address::InstanceConstSharedPtr>& address_list) {
+  for (int family : {AF_INET6, AF_INET}) {
+    if ((family == AF_INET && dns_lookup_family == DnsLookupFamily::V6Only) ||
+        (family == AF_INET6 && dns_lookup_family == DnsLookupFamily::V4Only)) {
+      continue;
+    }
+    hostent* hostent;
+    if (ares_gethostbyname_file(channel_, dns_name.c_str(), family, &hostent) == ARES_SUCCESS) {
+      addressListFromHostent(*hostent, address_list);
+      ares_free_hostent(hostent);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
                                          DnsLookupFamily dns_lookup_family, ResolveCb callback) {
-  // TODO(hennna): Add DNS caching which will allow testing the edge case of a
-  // failed intial call to getHostbyName followed by a synchronous IPv4
-  // resolution.
-  std::unique_ptr<PendingResolution> pending_resolution(
-      new PendingResolution(callback, channel_, dns_name));
+  // Resolution does not need asynchronous behavior or network events for literal addresses and
+  // names in the hosts file. For example, localhost lookup. The hosts file is only consulted here
+  // when it precedes DNS in the lookup order, and DNS is not queried at all if it isn't in the
+  // lookup order.
+  std::list<Address::InstanceConstSharedPtr> address_list;
+  if (resolveLiteral(dns_name, dns_lookup_family, address_list) ||
+      (hostsFileBeforeDns() &&
+       resolveFromHostsFile(dns_name, dns_lookup_family, address_list)) ||
+      lookups_.find('b') == std::string::npos) {
+    callback(std::move(address_list));
+    return nullptr;
+  }
+
+  const ResolutionKey key(dns_name, dns_lookup_family);
+  const auto cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    if (cached->second.expiry_->first > ProdMonotonicTimeSource::instance_.currentTime()) {
+      stats_.cache_hit_.inc();
+      address_list = cached->second.address_list_;
+      callback(std::move(address_list));
+      return nullptr;
+    }
+    eraseCacheEntry(cached);
+  }
+  stats_.cache_miss_.inc();
+
+  PendingResolutionPtr& pending_resolution = pending_resolutions_[key];
+  if (pending_resolution != nullptr) {
+    // The name is already being resolved, wait for that resolution instead of sending another
+    // query.
+    stats_.query_coalesced_.inc();
+    pending_resolution->queries_.emplace_back(new PendingQuery(callback));
+    return pending_resolution->queries_.back().get();
+  }
+
+  pending_resolution.reset(new PendingResolution(*this, key));
+  PendingResolution* resolution = pending_resolution.get();
+  PendingQuery* query = new PendingQuery(callback);
+  resolution->queries_.emplace_back(query);
   if (dns_lookup_family == DnsLookupFamily::Auto) {
-    pending_resolution->fallback_if_failed_ = true;
+    resolution->fallback_if_failed_ = true;
   }
 
   if (dns_lookup_family == DnsLookupFamily::V4Only) {
-    pending_resolution->getHostByName(AF_INET);
+    resolution->search(AF_INET);
   } else {
-    pending_resolution->getHostByName(AF_INET6);
+    resolution->search(AF_INET6);
   }
 
-  if (pending_resolution->completed_) {
-    // Resolution does not need asynchronous behavior or network events. For
-    // example, localhost lookup.
+  const auto pending = pending_resolutions_.find(key);
+  if (pending == pending_resolutions_.end() || pending->second.get() != resolution) {
+    // The resolution completed synchronously, e.g. because the query could not be sent.
     return nullptr;
   } else {
     // Enable timer to wake us up if the request times out.
     updateAresTimer();
 
-    // The PendingResolution will self-delete when the request completes
-    // (including if cancelled or if ~DnsResolverImpl() happens).
-    pending_resolution->owned_ = true;
-    return pending_resolution.release();
+    // The PendingQuery is destroyed when the resolution completes (including if cancelled or if
+    // ~DnsResolverImpl() happens).
+    return query;
   }
 }
 
-void DnsResolverImpl::PendingResolution::getHostByName(int family) {
-  ares_gethostbyname(channel_, dns_name_.c_str(), family,
-                     [](void* arg, int status, int timeouts, hostent* hostent) {
-                       static_cast<PendingResolution*>(arg)->onAresHostCallback(status, timeouts,
-                                                                                hostent);
-                     },
-                     this);
+void DnsResolverImpl::PendingResolution::search(int family) {
+  family_ = family;
+  ares_search(parent_.channel_, key_.first.c_str(), C_IN, family == AF_INET ? T_A : T_AAAA,
+              [](void* arg, int status, int timeouts, unsigned char* abuf, int alen) {
+                static_cast<PendingResolution*>(arg)->onAresQueryCallback(status, timeouts, abuf,
+                                                                          alen);
+              },
+              this);
 }
 
 } // namespace Network
@@ -2,13 +2,20 @@
 
 #include <netdb.h>
 
+#include <chrono>
 #include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/file_event.h"
 #include "envoy/network/dns.h"
+#include "envoy/stats/stats.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "common/common/linked_object.h"
 #include "common/common/logger.h"
@@ -21,14 +28,36 @@ namespace Network {
 
 class DnsResolverImplPeer;
 
+/**
+ * All DNS resolver stats. @see stats_macros.h
+ */
+// clang-format off
+#define ALL_DNS_RESOLVER_STATS(COUNTER)                                                            \
+  COUNTER(cache_hit)                                                                               \
+  COUNTER(cache_miss)                                                                              \
+  COUNTER(query_coalesced)
+// clang-format on
+
+/**
+ * Struct definition for all DNS resolver stats. @see stats_macros.h
+ */
+struct DnsResolverStats {
+  ALL_DNS_RESOLVER_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * Implementation of DnsResolver that uses c-ares. All calls and callbacks are assumed to
  * happen on the thread that owns the creating dispatcher.
+ *
+ * Successful resolutions are cached for the TTL of the returned records, so that clusters sharing
+ * a host name, or refreshing more often than the records change, don't send redundant queries.
+ * Concurrent resolutions of the same name are coalesced into a single query.
  */
 class DnsResolverImpl : public DnsResolver, protected Logger::Loggable<Logger::Id::upstream> {
 public:
   DnsResolverImpl(Event::Dispatcher& dispatcher,
-                  const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers);
+                  const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers,
+                  Stats::Scope& scope);
   ~DnsResolverImpl() override;
 
   // Network::DnsResolver
@@ -37,44 +66,70 @@ public:
 
 private:
   friend class DnsResolverImplPeer;
-  struct PendingResolution : public ActiveDnsQuery {
-    // Network::ActiveDnsQuery
-    PendingResolution(ResolveCb callback, ares_channel channel, const std::string& dns_name)
-        : callback_(callback), channel_(channel), dns_name_(dns_name) {}
+  typedef std::pair<std::string, DnsLookupFamily> ResolutionKey;
+
+  /**
+   * A caller waiting for a PendingResolution to complete.
+   */
+  struct PendingQuery : public ActiveDnsQuery {
+    PendingQuery(ResolveCb callback) : callback_(callback) {}
 
+    // Network::ActiveDnsQuery
     void cancel() override {
-      // c-ares only supports channel-wide cancellation, so we just allow the
-      // network events to continue but don't invoke the callback on completion.
+      // c-ares only supports channel-wide cancellation, and other callers may be waiting for the
+      // same resolution, so we just don't invoke the callback on completion.
       cancelled_ = true;
     }
 
+    // Caller supplied callback to invoke on query completion or error.
+    const ResolveCb callback_;
+    // Was the query cancelled via cancel()?
+    bool cancelled_ = false;
+  };
+
+  typedef std::unique_ptr<PendingQuery> PendingQueryPtr;
+
+  /**
+   * An in flight resolution of a name, shared by all callers resolving that name with the same
+   * lookup family.
+   */
+  struct PendingResolution {
+    PendingResolution(DnsResolverImpl& parent, const ResolutionKey& key)
+        : parent_(parent), key_(key) {}
+
     /**
-     * c-ares ares_gethostbyname() query callback.
-     * @param status return status of call to ares_gethostbyname.
+     * c-ares ares_search() query callback.
+     * @param status return status of call to ares_search.
      * @param timeouts the number of times the request timed out.
-     * @param hostent structure that stores information about a given host.
+     * @param abuf supplies the DNS reply.
+     * @param alen supplies the length of the DNS reply.
      */
-    void onAresHostCallback(int status, int timeouts, hostent* hostent);
+    void onAresQueryCallback(int status, int timeouts, unsigned char* abuf, int alen);
     /**
-     * wrapper function of call to ares_gethostbyname.
+     * wrapper function of call to ares_search for A or AAAA records.
      * @param family currently AF_INET and AF_INET6 are supported.
      */
-    void getHostByName(int family);
+    void search(int family);
 
-    // Caller supplied callback to invoke on query completion or error.
-    const ResolveCb callback_;
-    // Does the object own itself? Resource reclamation occurs via self-deleting
-    // on query completion or error.
-    bool owned_ = false;
-    // Has the query completed? Only meaningful if !owned_;
-    bool completed_ = false;
-    // Was the query cancelled via cancel()?
-    bool cancelled_ = false;
+    DnsResolverImpl& parent_;
+    const ResolutionKey key_;
+    std::list<PendingQueryPtr> queries_;
+    // The address family currently being searched.
+    int family_ = AF_UNSPEC;
     // If dns_lookup_family is "fallback", fallback to v4 address if v6
     // resolution failed.
     bool fallback_if_failed_ = false;
-    const ares_channel channel_;
-    const std::string dns_name_;
+  };
+
+  typedef std::unique_ptr<PendingResolution> PendingResolutionPtr;
+
+  // Cached resolutions ordered by expiry time, so that expired entries can be swept from the front.
+  typedef std::multimap<MonotonicTime, ResolutionKey> CacheExpiries;
+
+  struct CacheEntry {
+    std::list<Address::InstanceConstSharedPtr> address_list_;
+    // The entry's position in cache_expiries_, keyed by its expiry time.
+    CacheExpiries::iterator expiry_;
   };
 
   // Callback for events on sockets tracked in events_.
@@ -86,11 +141,36 @@ private:
   void initializeChannel(ares_options* options, int optmask);
   // Update timer for c-ares timeouts.
   void updateAresTimer();
+  // Resolve an IP address literal, honoring the lookup family. Returns false if the name is not a
+  // literal.
+  bool resolveLiteral(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+                      std::list<Address::InstanceConstSharedPtr>& address_list);
+  // Resolve a name from the hosts file. Returns false if the name is not in the hosts file.
+  bool resolveFromHostsFile(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+                            std::list<Address::InstanceConstSharedPtr>& address_list);
+  // Whether the hosts file is consulted before or after DNS in the c-ares lookup order.
+  bool hostsFileBeforeDns() const;
+  bool hostsFileAfterDns() const;
+  // Remove the cache entries that have expired, so that names which are no longer resolved don't
+  // accumulate. This only visits the expired entries.
+  void sweepCache(MonotonicTime now);
+  void eraseCacheEntry(std::map<ResolutionKey, CacheEntry>::iterator entry);
+  // Cache the result of a completed resolution and invoke the callbacks waiting for it. This
+  // destroys the resolution.
+  void onResolutionComplete(PendingResolution& resolution,
+                            std::list<Address::InstanceConstSharedPtr>&& address_list,
+                            std::chrono::seconds ttl);
 
   Event::Dispatcher& dispatcher_;
   Event::TimerPtr timer_;
   ares_channel channel_;
   std::unordered_map<int, Event::FileEventPtr> events_;
+  std::map<ResolutionKey, PendingResolutionPtr> pending_resolutions_;
+  std::map<ResolutionKey, CacheEntry> cache_;
+  CacheExpiries cache_expiries_;
+  // The c-ares lookup order, e.g. "fb" to consult the hosts file ('f') before DNS ('b').
+  std::string lookups_;
+  DnsResolverStats stats_;
 };
 
 } // namespace Network
@@ -44,6 +44,14 @@ public:
   void onRead();
   FilterStatus onWrite();
 
+  /**
+   * @return true if there is a single read filter and no write filters, i.e. no filter other than
+   *         the one consuming the data needs to see it.
+   */
+  bool singleReadFilter() const {
+    return upstream_filters_.size() == 1 && downstream_filters_.empty();
+  }
+
 private:
   struct ActiveReadFilter : public ReadFilterCallbacks, LinkedObject<ActiveReadFilter> {
     ActiveReadFilter(FilterManagerImpl& parent, ReadFilterSharedPtr filter)
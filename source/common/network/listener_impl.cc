@@ -1,11 +1,18 @@
 #include "common/network/listener_impl.h"
 
+#include <fcntl.h>
+#include <sys/socket.h>
 #include <sys/un.h>
 
+#include <cerrno>
+#include <chrono>
+
 #include "envoy/common/exception.h"
 #include "envoy/network/connection_handler.h"
 
+#include "common/common/assert.h"
 #include "common/common/empty_string.h"
+#include "common/common/utility.h"
 #include "common/event/dispatcher_impl.h"
 #include "common/event/file_event_impl.h"
 #include "common/network/address_impl.h"
@@ -13,7 +20,6 @@
 #include "common/network/utility.h"
 #include "common/ssl/connection_impl.h"
 
-#include "event2/listener.h"
 #include "fmt/format.h"
 
 namespace Envoy {
@@ -27,9 +33,87 @@ Address::InstanceConstSharedPtr ListenerImpl::getOriginalDst(int fd) {
   return Utility::getOriginalDst(fd);
 }
 
-void ListenerImpl::listenCallback(evconnlistener*, evutil_socket_t fd, sockaddr* remote_addr,
-                                  int remote_addr_len, void* arg) {
-  ListenerImpl* listener = static_cast<ListenerImpl*>(arg);
+const uint32_t ListenerImpl::DEFAULT_MAX_CONNECTIONS_PER_ACCEPT;
+
+void ListenerImpl::onSocketEvent() {
+  const MonotonicTime start_time = ProdMonotonicTimeSource::instance_.currentTime();
+  uint32_t accepted = 0;
+
+  while (true) {
+    if (accepted == max_connections_per_accept_) {
+      // Leave the rest in the kernel backlog. The socket event is level triggered, so we come back
+      // for them on the next event loop iteration, after the events that are already pending.
+      // Whether anything was actually left behind is only known once we come back.
+      accept_budget_exhausted_ = true;
+      // Only full loops are timed, so that the histogram gets at most one sample per batch of
+      // connections and shows how long a connection storm holds up the worker.
+      stats_.downstream_cx_accept_loop_us_.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              ProdMonotonicTimeSource::instance_.currentTime() - start_time)
+              .count());
+      break;
+    }
+
+    if (!checkRateLimit()) {
+      break;
+    }
+
+    sockaddr_storage remote_addr;
+    socklen_t remote_addr_len = sizeof(remote_addr);
+#if defined(__APPLE__)
+    const int fd = ::accept(socket_.fd(), reinterpret_cast<sockaddr*>(&remote_addr),
+                            &remote_addr_len);
+    if (fd != -1) {
+      RELEASE_ASSERT(fcntl(fd, F_SETFL, O_NONBLOCK) != -1);
+    }
+#else
+    const int fd = ::accept4(socket_.fd(), reinterpret_cast<sockaddr*>(&remote_addr),
+                             &remote_addr_len, SOCK_NONBLOCK);
+#endif
+
+    if (fd == -1) {
+      if (options_.connection_rate_limiter_ != nullptr) {
+        options_.connection_rate_limiter_->refund();
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        accept_budget_exhausted_ = false;
+        break;
+      } else if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      // This can happen if we run out of FDs or memory. In those cases just crash.
+      PANIC(fmt::format("listener accept failure: {}", strerror(errno)));
+    }
+
+    if (accept_budget_exhausted_) {
+      stats_.downstream_cx_accept_budget_exhausted_.inc();
+      accept_budget_exhausted_ = false;
+    }
+    accepted++;
+    onAccept(fd, remote_addr, remote_addr_len);
+  }
+}
+
+bool ListenerImpl::checkRateLimit() {
+  if (options_.connection_rate_limiter_ == nullptr) {
+    return true;
+  }
+
+  const std::chrono::milliseconds wait = options_.connection_rate_limiter_->consume();
+  if (wait.count() == 0) {
+    return true;
+  }
+
+  // Shape rather than drop: new connections wait in the kernel backlog until the next token.
+  stats_.downstream_cx_accept_rate_limited_.inc();
+  file_event_->setEnabled(0);
+  rate_limit_timer_->enableTimer(wait);
+  return false;
+}
+
+void ListenerImpl::onAccept(int fd, const sockaddr_storage& remote_addr,
+                            socklen_t remote_addr_len) {
+  ListenerImpl* listener = this;
   Address::InstanceConstSharedPtr final_local_address = listener->socket_.localAddress();
   bool using_original_dst = false;
 
@@ -67,15 +151,14 @@ void ListenerImpl::listenCallback(evconnlistener*, evutil_socket_t fd, sockaddr*
     listener->proxy_protocol_.newConnection(listener->dispatcher_, fd, *listener);
   } else {
     Address::InstanceConstSharedPtr final_remote_address;
-    if (remote_addr->sa_family == AF_UNIX) {
+    if (remote_addr.ss_family == AF_UNIX) {
       // The accept() call that filled in remote_addr doesn't fill in more than the sa_family field
       // for Unix domain sockets; apparently there isn't a mechanism in the kernel to get the
       // sockaddr_un associated with the client socket when starting from the server socket.
       // We work around this by using our own name for the socket in this case.
       final_remote_address = Address::peerAddressFromFd(fd);
     } else {
-      final_remote_address = Address::addressFromSockAddr(
-          *reinterpret_cast<const sockaddr_storage*>(remote_addr), remote_addr_len);
+      final_remote_address = Address::addressFromSockAddr(remote_addr, remote_addr_len);
     }
     // TODO(jamessynge): We need to keep per-family stats. BUT, should it be based on the original
     // family or the local family? Probably local family, as the original proxy can take care of
@@ -89,25 +172,27 @@ ListenerImpl::ListenerImpl(Network::ConnectionHandler& conn_handler,
                            ListenerCallbacks& cb, Stats::Scope& scope,
                            const Network::ListenerOptions& listener_options)
     : connection_handler_(conn_handler), dispatcher_(dispatcher), socket_(socket), cb_(cb),
-      proxy_protocol_(scope), options_(listener_options), listener_(nullptr) {
+      proxy_protocol_(scope), options_(listener_options),
+      stats_{ALL_LISTENER_ACCEPT_STATS(POOL_COUNTER(scope), POOL_HISTOGRAM(scope))},
+      max_connections_per_accept_(options_.max_connections_per_accept_ > 0
+                                      ? options_.max_connections_per_accept_
+                                      : DEFAULT_MAX_CONNECTIONS_PER_ACCEPT) {
 
   if (options_.bind_to_port_) {
-    listener_.reset(
-        evconnlistener_new(&dispatcher_.base(), listenCallback, this, 0, -1, socket.fd()));
-
-    if (!listener_) {
+    if (::listen(socket.fd(), 128) == -1) {
       throw CreateListenerException(
           fmt::format("cannot listen on socket: {}", socket.localAddress()->asString()));
     }
 
-    evconnlistener_set_error_cb(listener_.get(), errorCallback);
-  }
-}
+    file_event_ = dispatcher_.createFileEvent(socket.fd(), [this](uint32_t) { onSocketEvent(); },
+                                              Event::FileTriggerType::Level,
+                                              Event::FileReadyType::Read);
 
-void ListenerImpl::errorCallback(evconnlistener*, void*) {
-  // We should never get an error callback. This can happen if we run out of FDs or memory. In those
-  // cases just crash.
-  PANIC(fmt::format("listener accept failure: {}", strerror(errno)));
+    if (options_.connection_rate_limiter_ != nullptr) {
+      rate_limit_timer_ = dispatcher_.createTimer(
+          [this]() -> void { file_event_->setEnabled(Event::FileReadyType::Read); });
+    }
+  }
 }
 
 void ListenerImpl::newConnection(int fd, Address::InstanceConstSharedPtr remote_address,
@@ -1,18 +1,38 @@
 #pragma once
 
+#include <sys/socket.h>
+
+#include "envoy/common/time.h"
+#include "envoy/event/file_event.h"
+#include "envoy/event/timer.h"
 #include "envoy/network/connection_handler.h"
 #include "envoy/network/listener.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "common/event/dispatcher_impl.h"
-#include "common/event/libevent.h"
 #include "common/network/listen_socket_impl.h"
 #include "common/network/proxy_protocol.h"
 
-#include "event2/event.h"
-
 namespace Envoy {
 namespace Network {
 
+/**
+ * All stats for the listener accept loop. @see stats_macros.h
+ */
+// clang-format off
+#define ALL_LISTENER_ACCEPT_STATS(COUNTER, HISTOGRAM)                                              \
+  COUNTER  (downstream_cx_accept_budget_exhausted)                                                 \
+  COUNTER  (downstream_cx_accept_rate_limited)                                                     \
+  HISTOGRAM(downstream_cx_accept_loop_us)
+// clang-format on
+
+/**
+ * Definition of all stats for the listener accept loop. @see stats_macros.h
+ */
+struct ListenerAcceptStats {
+  ALL_LISTENER_ACCEPT_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
 /**
  * libevent implementation of Network::Listener.
  */
@@ -37,6 +57,9 @@ public:
    */
   ListenSocket& socket() { return socket_; }
 
+  // The number of connections accepted per wakeup when the listener options don't specify one.
+  static const uint32_t DEFAULT_MAX_CONNECTIONS_PER_ACCEPT = 64;
+
 protected:
   virtual Address::InstanceConstSharedPtr getLocalAddress(int fd);
   virtual Address::InstanceConstSharedPtr getOriginalDst(int fd);
@@ -49,11 +72,22 @@ protected:
   const ListenerOptions options_;
 
 private:
-  static void errorCallback(evconnlistener* listener, void* context);
-  static void listenCallback(evconnlistener*, evutil_socket_t fd, sockaddr* remote_addr,
-                             int remote_addr_len, void* arg);
+  void onSocketEvent();
+  void onAccept(int fd, const sockaddr_storage& remote_addr, socklen_t remote_addr_len);
+  /**
+   * Take a token from the connection rate limiter for another connection. If there is none, stop
+   * accepting until the limiter expects one.
+   * @return true if another connection may be accepted now.
+   */
+  bool checkRateLimit();
 
-  Event::Libevent::ListenerPtr listener_;
+  ListenerAcceptStats stats_;
+  const uint32_t max_connections_per_accept_;
+  // Set when the last wakeup stopped at max_connections_per_accept_. It is counted as exhausted
+  // once the next wakeup finds a connection that was left behind.
+  bool accept_budget_exhausted_{};
+  Event::FileEventPtr file_event_;
+  Event::TimerPtr rate_limit_timer_;
 };
 
 class SslListenerImpl : public ListenerImpl {
@@ -1,8 +1,12 @@
 #include "common/network/proxy_protocol.h"
 
+#include <arpa/inet.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -12,14 +16,94 @@
 #include "envoy/stats/stats.h"
 
 #include "common/common/empty_string.h"
-#include "common/common/utility.h"
 #include "common/network/address_impl.h"
 #include "common/network/listener_impl.h"
-#include "common/network/utility.h"
 
 namespace Envoy {
 namespace Network {
 
+namespace {
+
+const char PROXY_PROTO_V1_SIGNATURE[] = "PROXY ";
+const uint8_t PROXY_PROTO_V2_SIGNATURE[] = {0x0d, 0x0a, 0x0d, 0x0a, 0x00, 0x0d,
+                                            0x0a, 0x51, 0x55, 0x49, 0x54, 0x0a};
+const size_t PROXY_PROTO_V1_FIELDS = 6;
+const uint8_t PROXY_PROTO_V2_VERSION = 0x20;
+const uint8_t PROXY_PROTO_V2_LOCAL = 0x00;
+const uint8_t PROXY_PROTO_V2_PROXY = 0x01;
+const uint8_t PROXY_PROTO_V2_AF_UNSPEC = 0x00;
+const uint8_t PROXY_PROTO_V2_TCP4 = 0x11;
+const uint8_t PROXY_PROTO_V2_TCP6 = 0x21;
+const size_t PROXY_PROTO_V2_ADDR_LEN_INET = 12;
+const size_t PROXY_PROTO_V2_ADDR_LEN_INET6 = 36;
+
+/**
+ * Parse a port of a V1 header, a decimal number between 0 and 65535.
+ * @return bool true if the port is valid.
+ */
+bool parseV1Port(const char* str, uint16_t& port) {
+  uint32_t value = 0;
+  size_t digits = 0;
+  for (; *str != '\0'; str++, digits++) {
+    if (*str < '0' || *str > '9' || digits == 5) {
+      return false;
+    }
+    value = value * 10 + (*str - '0');
+  }
+  if (digits == 0 || value > 65535) {
+    return false;
+  }
+  port = value;
+  return true;
+}
+
+/**
+ * Parse an address and port of a V1 header without allocating anything but the address itself.
+ * throws EnvoyException if either of them is malformed.
+ */
+Address::InstanceConstSharedPtr parseV1Address(int family, const char* address, const char* port) {
+  uint16_t port_value;
+  if (!parseV1Port(port, port_value)) {
+    throw EnvoyException("failed to read proxy protocol");
+  }
+
+  if (family == AF_INET) {
+    sockaddr_in sin;
+    memset(&sin, 0, sizeof(sin));
+    if (inet_pton(AF_INET, address, &sin.sin_addr) != 1) {
+      throw EnvoyException("failed to read proxy protocol");
+    }
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(port_value);
+    return std::make_shared<Address::Ipv4Instance>(&sin);
+  }
+
+  sockaddr_in6 sin6;
+  memset(&sin6, 0, sizeof(sin6));
+  if (inet_pton(AF_INET6, address, &sin6.sin6_addr) != 1) {
+    throw EnvoyException("failed to read proxy protocol");
+  }
+  sin6.sin6_family = AF_INET6;
+  sin6.sin6_port = htons(port_value);
+  return std::make_shared<Address::Ipv6Instance>(sin6);
+}
+
+/**
+ * Check that both addresses are valid unicast addresses, as required for TCP.
+ * throws EnvoyException otherwise.
+ */
+void checkUnicast(const Address::Instance& remote_address, const Address::Instance& local_address) {
+  if (!remote_address.ip()->isUnicastAddress() || !local_address.ip()->isUnicastAddress()) {
+    throw EnvoyException("failed to read proxy protocol");
+  }
+}
+
+} // namespace
+
+const size_t ProxyProtocol::ActiveConnection::MAX_PROXY_PROTO_V1_LEN;
+const size_t ProxyProtocol::ActiveConnection::MAX_PROXY_PROTO_V2_ADDR_LEN;
+const size_t ProxyProtocol::ActiveConnection::MAX_PROXY_PROTO_LEN;
+
 ProxyProtocol::ProxyProtocol(Stats::Scope& scope)
     : stats_{ALL_PROXY_PROTOCOL_STATS(POOL_COUNTER(scope))} {}
 
@@ -58,74 +142,149 @@ void ProxyProtocol::ActiveConnection::onRead() {
 }
 
 void ProxyProtocol::ActiveConnection::onReadWorker() {
-  std::string proxy_line;
-  if (!readLine(fd_, proxy_line)) {
+  if (!header_parsed_) {
+    const size_t header_len = readHeader();
+    if (header_len == 0) {
+      return;
+    }
+
+    if (buf_[0] == PROXY_PROTO_V2_SIGNATURE[0]) {
+      parseV2();
+    } else {
+      parseV1(header_len);
+    }
+    header_parsed_ = true;
+  }
+
+  if (!discardTlvs()) {
     return;
   }
 
-  // Remove the line feed at the end
-  StringUtil::rtrim(proxy_line);
+  finishConnection(remote_address_, local_address_);
+}
 
-  // Parse proxy protocol line with format: PROXY TCP4/TCP6/UNKNOWN SOURCE_ADDRESS
-  // DESTINATION_ADDRESS SOURCE_PORT DESTINATION_PORT.
-  const auto line_parts = StringUtil::split(proxy_line, " ", true);
+void ProxyProtocol::ActiveConnection::parseV1(size_t header_len) {
+  // Split the line with format: PROXY TCP4/TCP6/UNKNOWN SOURCE_ADDRESS DESTINATION_ADDRESS
+  // SOURCE_PORT DESTINATION_PORT into its fields in place, terminating each of them with a NUL.
+  const char* fields[PROXY_PROTO_V1_FIELDS];
+  size_t num_fields = 0;
+  char* const end = buf_ + header_len - 2;
+  *end = '\0';
+  for (char* p = buf_; p < end;) {
+    if (*p == ' ') {
+      *p++ = '\0';
+      continue;
+    }
+    if (num_fields < PROXY_PROTO_V1_FIELDS) {
+      fields[num_fields] = p;
+    }
+    num_fields++;
+    while (p < end && *p != ' ') {
+      p++;
+    }
+  }
 
-  if (line_parts.size() < 2 || line_parts[0] != "PROXY") {
+  if (num_fields < 2 || strcmp(fields[0], "PROXY") != 0) {
     throw EnvoyException("failed to read proxy protocol");
   }
 
-  if (line_parts[1] == "UNKNOWN") {
-    // At this point we know it's a proxy protocol line, so we can remove it from the socket
-    // and continue.
-    Address::InstanceConstSharedPtr local_address = Envoy::Network::Address::addressFromFd(fd_);
-    Address::InstanceConstSharedPtr remote_address;
-    // The remote address not known.
-    if (local_address->ip()->version() == Address::IpVersion::v4) {
-      remote_address = std::make_shared<Address::Ipv4Instance>(Address::Ipv4Instance("0.0.0.0"));
-    } else {
-      remote_address = std::make_shared<Address::Ipv6Instance>(Address::Ipv6Instance("::"));
-    }
-    finishConnection(remote_address, local_address);
+  if (strcmp(fields[1], "UNKNOWN") == 0) {
+    setUnknownAddresses();
     return;
   }
 
   // If protocol not UNKNOWN, src and dst adresses have to be present.
-  if (line_parts.size() != 6) {
+  if (num_fields != PROXY_PROTO_V1_FIELDS) {
     throw EnvoyException("failed to read proxy protocol");
   }
 
-  Address::IpVersion protocol_version;
-  Address::InstanceConstSharedPtr remote_address;
-  Address::InstanceConstSharedPtr local_address;
-  if (line_parts[1] == "TCP4") {
-    protocol_version = Address::IpVersion::v4;
-    remote_address = Utility::parseInternetAddressAndPort(line_parts[2] + ":" + line_parts[4]);
-    local_address = Utility::parseInternetAddressAndPort(line_parts[3] + ":" + line_parts[5]);
-  } else if (line_parts[1] == "TCP6") {
-    protocol_version = Address::IpVersion::v6;
-    remote_address =
-        Utility::parseInternetAddressAndPort("[" + line_parts[2] + "]:" + line_parts[4]);
-    local_address =
-        Utility::parseInternetAddressAndPort("[" + line_parts[3] + "]:" + line_parts[5]);
+  if (strcmp(fields[1], "TCP4") == 0) {
+    remote_address_ = parseV1Address(AF_INET, fields[2], fields[4]);
+    local_address_ = parseV1Address(AF_INET, fields[3], fields[5]);
+  } else if (strcmp(fields[1], "TCP6") == 0) {
+    remote_address_ = parseV1Address(AF_INET6, fields[2], fields[4]);
+    local_address_ = parseV1Address(AF_INET6, fields[3], fields[5]);
   } else {
     throw EnvoyException("failed to read proxy protocol");
   }
 
-  // Error check the source and destination fields. Most errors are cought by the address
-  // parsing above, but a malformed IPv6 address may combine with a malformed port and parse as
-  // an IPv6 address when parsing for an IPv4 address. Remote address refers to the source
-  // address.
-  const auto remote_version = remote_address->ip()->version();
-  const auto local_version = local_address->ip()->version();
-  if (remote_version != protocol_version || local_version != protocol_version) {
+  checkUnicast(*remote_address_, *local_address_);
+}
+
+void ProxyProtocol::ActiveConnection::parseV2() {
+  const uint8_t* header = reinterpret_cast<const uint8_t*>(buf_);
+  const size_t addr_len =
+      std::min<size_t>((header[14] << 8) | header[15], MAX_PROXY_PROTO_V2_ADDR_LEN);
+  const uint8_t* addr = header + PROXY_PROTO_V2_HEADER_LEN;
+
+  switch (header[12] & 0x0f) {
+  case PROXY_PROTO_V2_LOCAL:
+    // Health checks and the like from the proxy itself, which carry no addresses of their own.
+    remote_address_ = Address::peerAddressFromFd(fd_);
+    local_address_ = Address::addressFromFd(fd_);
+    return;
+  case PROXY_PROTO_V2_PROXY:
+    break;
+  default:
     throw EnvoyException("failed to read proxy protocol");
   }
-  // Check that both addresses are valid unicast addresses, as required for TCP
-  if (!remote_address->ip()->isUnicastAddress() || !local_address->ip()->isUnicastAddress()) {
+
+  switch (header[13]) {
+  case PROXY_PROTO_V2_AF_UNSPEC:
+    setUnknownAddresses();
+    return;
+  case PROXY_PROTO_V2_TCP4: {
+    if (addr_len < PROXY_PROTO_V2_ADDR_LEN_INET) {
+      throw EnvoyException("failed to read proxy protocol");
+    }
+    sockaddr_in remote;
+    sockaddr_in local;
+    memset(&remote, 0, sizeof(remote));
+    memset(&local, 0, sizeof(local));
+    remote.sin_family = local.sin_family = AF_INET;
+    memcpy(&remote.sin_addr, addr, 4);
+    memcpy(&local.sin_addr, addr + 4, 4);
+    memcpy(&remote.sin_port, addr + 8, 2);
+    memcpy(&local.sin_port, addr + 10, 2);
+    remote_address_ = std::make_shared<Address::Ipv4Instance>(&remote);
+    local_address_ = std::make_shared<Address::Ipv4Instance>(&local);
+    break;
+  }
+  case PROXY_PROTO_V2_TCP6: {
+    if (addr_len < PROXY_PROTO_V2_ADDR_LEN_INET6) {
+      throw EnvoyException("failed to read proxy protocol");
+    }
+    sockaddr_in6 remote;
+    sockaddr_in6 local;
+    memset(&remote, 0, sizeof(remote));
+    memset(&local, 0, sizeof(local));
+    remote.sin6_family = local.sin6_family = AF_INET6;
+    memcpy(&remote.sin6_addr, addr, 16);
+    memcpy(&local.sin6_addr, addr + 16, 16);
+    memcpy(&remote.sin6_port, addr + 32, 2);
+    memcpy(&local.sin6_port, addr + 34, 2);
+    remote_address_ = std::make_shared<Address::Ipv6Instance>(remote);
+    local_address_ = std::make_shared<Address::Ipv6Instance>(local);
+    break;
+  }
+  default:
+    // UDP and Unix domain socket addresses can't describe a TCP connection.
     throw EnvoyException("failed to read proxy protocol");
   }
 
-  finishConnection(remote_address, local_address);
+  checkUnicast(*remote_address_, *local_address_);
+}
+
+void ProxyProtocol::ActiveConnection::setUnknownAddresses() {
+  // At this point we know it's a proxy protocol header, so we can remove it from the socket
+  // and continue.
+  local_address_ = Address::addressFromFd(fd_);
+  // The remote address not known.
+  if (local_address_->ip()->version() == Address::IpVersion::v4) {
+    remote_address_ = std::make_shared<Address::Ipv4Instance>(Address::Ipv4Instance("0.0.0.0"));
+  } else {
+    remote_address_ = std::make_shared<Address::Ipv6Instance>(Address::Ipv6Instance("::"));
+  }
 }
 
 void ProxyProtocol::ActiveConnection::finishConnection(
@@ -146,41 +305,84 @@ void ProxyProtocol::ActiveConnection::close() {
   removeFromList(parent_.connections_);
 }
 
-bool ProxyProtocol::ActiveConnection::readLine(int fd, std::string& s) {
-  while (buf_off_ < MAX_PROXY_PROTO_LEN) {
-    ssize_t nread = recv(fd, buf_ + buf_off_, MAX_PROXY_PROTO_LEN - buf_off_, MSG_PEEK);
+size_t ProxyProtocol::ActiveConnection::readHeader() {
+  while (true) {
+    const ssize_t nread = recv(fd_, buf_ + buf_off_, MAX_PROXY_PROTO_LEN - buf_off_, MSG_PEEK);
 
     if (nread == -1 && errno == EAGAIN) {
-      return false;
+      return 0;
     } else if (nread < 1) {
       throw EnvoyException("failed to read proxy protocol");
     }
 
-    bool found = false;
-    // continue searching buf_ from where we left off
-    for (; search_index_ < buf_off_ + nread; search_index_++) {
-      if (buf_[search_index_] == '\n' && buf_[search_index_ - 1] == '\r') {
-        search_index_++;
-        found = true;
-        break;
+    const size_t available = buf_off_ + nread;
+    // The length of the header in buf_ once it is complete, or 0 if it is not complete yet.
+    size_t header_len = 0;
+    if (buf_[0] == PROXY_PROTO_V2_SIGNATURE[0]) {
+      if (memcmp(buf_, PROXY_PROTO_V2_SIGNATURE,
+                 std::min(available, sizeof(PROXY_PROTO_V2_SIGNATURE))) != 0) {
+        throw EnvoyException("failed to read proxy protocol");
+      }
+      if (available >= PROXY_PROTO_V2_HEADER_LEN) {
+        const uint8_t* header = reinterpret_cast<const uint8_t*>(buf_);
+        if ((header[12] & 0xf0) != PROXY_PROTO_V2_VERSION) {
+          throw EnvoyException("failed to read proxy protocol");
+        }
+        // Only the addresses are buffered. Anything beyond them is made of TLVs, which are read
+        // and discarded afterwards.
+        const size_t len = (header[14] << 8) | header[15];
+        const size_t buffered_len = std::min(len, MAX_PROXY_PROTO_V2_ADDR_LEN);
+        if (available >= PROXY_PROTO_V2_HEADER_LEN + buffered_len) {
+          header_len = PROXY_PROTO_V2_HEADER_LEN + buffered_len;
+          tlv_remaining_ = len - buffered_len;
+        }
+      }
+    } else {
+      if (memcmp(buf_, PROXY_PROTO_V1_SIGNATURE,
+                 std::min(available, strlen(PROXY_PROTO_V1_SIGNATURE))) != 0) {
+        throw EnvoyException("failed to read proxy protocol");
+      }
+      // Continue searching buf_ from where we left off.
+      for (; search_index_ < std::min(available, MAX_PROXY_PROTO_V1_LEN); search_index_++) {
+        if (buf_[search_index_] == '\n' && buf_[search_index_ - 1] == '\r') {
+          header_len = search_index_ + 1;
+          break;
+        }
+      }
+      if (header_len == 0 && available >= MAX_PROXY_PROTO_V1_LEN) {
+        throw EnvoyException("failed to read proxy protocol");
       }
     }
 
-    // Read the data upto and including the line feed, if available, but not past it.
-    // This should never fail, as search_index_ - buf_off_ <= nread, so we're asking
-    // only for bytes we have already seen.
-    nread = recv(fd, buf_ + buf_off_, search_index_ - buf_off_, 0);
-    ASSERT(size_t(nread) == search_index_ - buf_off_);
+    // Read the data up to the end of the header, if available, but not past it. All data we have
+    // peeked at belongs to the header while it is incomplete. This should never fail, as we're
+    // asking only for bytes we have already seen.
+    const size_t read_len = (header_len != 0 ? header_len : available) - buf_off_;
+    const ssize_t nconsumed = recv(fd_, buf_ + buf_off_, read_len, 0);
+    ASSERT(size_t(nconsumed) == read_len);
+    UNREFERENCED_PARAMETER(nconsumed);
+    buf_off_ += read_len;
+
+    if (header_len != 0) {
+      return header_len;
+    }
+  }
+}
 
-    buf_off_ += nread;
+bool ProxyProtocol::ActiveConnection::discardTlvs() {
+  while (tlv_remaining_ > 0) {
+    const ssize_t nread = recv(fd_, buf_, std::min(tlv_remaining_, MAX_PROXY_PROTO_LEN), 0);
 
-    if (found) {
-      s.assign(buf_, buf_off_);
-      return true;
+    if (nread == -1 && errno == EAGAIN) {
+      return false;
+    } else if (nread < 1) {
+      throw EnvoyException("failed to read proxy protocol");
     }
+
+    tlv_remaining_ -= nread;
   }
 
-  throw EnvoyException("failed to read proxy protocol");
+  return true;
 }
 
 } // namespace Network
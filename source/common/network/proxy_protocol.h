@@ -5,6 +5,7 @@
 #include <string>
 
 #include "envoy/event/dispatcher.h"
+#include "envoy/network/address.h"
 #include "envoy/stats/stats_macros.h"
 
 #include "common/common/linked_object.h"
@@ -30,8 +31,8 @@ struct ProxyProtocolStats {
 };
 
 /**
- * Implementation the PROXY Protocol V1
- * (http://www.haproxy.org/download/1.5/doc/proxy-protocol.txt)
+ * Implementation the PROXY Protocol V1 and V2
+ * (http://www.haproxy.org/download/1.8/doc/proxy-protocol.txt)
  */
 class ProxyProtocol {
 public:
@@ -42,17 +43,54 @@ public:
     ~ActiveConnection();
 
   private:
-    static const size_t MAX_PROXY_PROTO_LEN = 108;
+    // The longest V1 header, including the trailing '\r\n'.
+    static const size_t MAX_PROXY_PROTO_V1_LEN = 108;
+    // The V2 signature, version/command, family/protocol and length fields.
+    static const size_t PROXY_PROTO_V2_HEADER_LEN = 16;
+    // The longest V2 address block, used by AF_UNIX addresses.
+    static const size_t MAX_PROXY_PROTO_V2_ADDR_LEN = 216;
+    static const size_t MAX_PROXY_PROTO_LEN =
+        PROXY_PROTO_V2_HEADER_LEN + MAX_PROXY_PROTO_V2_ADDR_LEN;
 
     void onRead();
     void onReadWorker();
 
     /**
-     * Helper function that attempts to read a line (delimited by '\r\n') from the socket.
+     * Helper function that reads the header from the socket, without reading past its end. The
+     * header is peeked at and then read in one go once it is complete, so that in the common case
+     * of a header arriving in one segment it costs two system calls. Any V2 TLVs following the
+     * addresses are not buffered, see discardTlvs().
+     * throws EnvoyException on any socket errors or a malformed header.
+     * @return size_t the length of the header in buf_, or 0 if more data is needed.
+     */
+    size_t readHeader();
+
+    /**
+     * Helper function that reads and discards the V2 TLVs following the addresses. They are not
+     * used for anything yet.
      * throws EnvoyException on any socket errors.
-     * @return bool true if a line should be read, false if more data is needed.
+     * @return bool true if all TLVs have been read, false if more data is needed.
+     */
+    bool discardTlvs();
+
+    /**
+     * Parse the V1 header in buf_ in place, without allocating.
+     * throws EnvoyException on a malformed header.
+     */
+    void parseV1(size_t header_len);
+
+    /**
+     * Parse the V2 header in buf_.
+     * throws EnvoyException on a malformed header.
+     */
+    void parseV2();
+
+    /**
+     * Use the local address of the socket and an unspecified remote address, for headers that
+     * don't carry addresses.
      */
-    bool readLine(int fd, std::string& s);
+    void setUnknownAddresses();
+
     void close();
 
     /**
@@ -72,7 +110,17 @@ public:
     // The index in buf_ where the search for '\r\n' should continue from
     size_t search_index_;
 
-    // Stores the portion of the first line that has been read so far.
+    // Whether the header has been read and parsed, and only TLVs remain to be discarded.
+    bool header_parsed_{};
+
+    // The number of V2 TLV bytes that still have to be read and discarded.
+    size_t tlv_remaining_{};
+
+    // The addresses carried by the header, once it has been parsed.
+    Address::InstanceConstSharedPtr remote_address_;
+    Address::InstanceConstSharedPtr local_address_;
+
+    // Stores the portion of the header that has been read so far.
     char buf_[MAX_PROXY_PROTO_LEN];
   };
 
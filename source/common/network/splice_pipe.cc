@@ -0,0 +1,69 @@
+#include "common/network/splice_pipe.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Network {
+
+SplicePipe::~SplicePipe() {
+  ::close(read_fd_);
+  ::close(write_fd_);
+}
+
+#ifdef __linux__
+
+SplicePipePtr SplicePipe::create() {
+  int fds[2];
+  if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+    return nullptr;
+  }
+
+  const int capacity = fcntl(fds[1], F_GETPIPE_SZ);
+  if (capacity <= 0) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return nullptr;
+  }
+
+  return SplicePipePtr{new SplicePipe(fds[0], fds[1], capacity)};
+}
+
+int SplicePipe::fill(int fd, uint64_t max_length) {
+  ASSERT(max_length > 0);
+  const ssize_t rc =
+      splice(fd, nullptr, write_fd_, nullptr, max_length, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (rc > 0) {
+    length_ += rc;
+  }
+  return rc;
+}
+
+int SplicePipe::drain(int fd) {
+  ASSERT(length_ > 0);
+  const ssize_t rc =
+      splice(read_fd_, nullptr, fd, nullptr, length_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  if (rc > 0) {
+    ASSERT(static_cast<uint64_t>(rc) <= length_);
+    length_ -= rc;
+  }
+  return rc;
+}
+
+#else
+
+SplicePipePtr SplicePipe::create() { return nullptr; }
+
+int SplicePipe::fill(int, uint64_t) { NOT_REACHED; }
+
+int SplicePipe::drain(int) { NOT_REACHED; }
+
+#endif
+
+} // namespace Network
+} // namespace Envoy
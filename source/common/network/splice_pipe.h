@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Envoy {
+namespace Network {
+
+class SplicePipe;
+typedef std::unique_ptr<SplicePipe> SplicePipePtr;
+
+/**
+ * A kernel pipe used to move data between two sockets with splice() without copying it through
+ * user space. The pipe keeps track of how many bytes it holds.
+ */
+class SplicePipe {
+public:
+  ~SplicePipe();
+
+  /**
+   * Create a pipe with the system default capacity. Growing it would count against the per user
+   * pipe buffer limit (/proc/sys/fs/pipe-user-pages-soft), beyond which the kernel shrinks new
+   * pipes to a single page. Each pipe uses two file descriptors.
+   * @return the pipe, or nullptr if splice() is not supported on this platform or the pipe could
+   *         not be created.
+   */
+  static SplicePipePtr create();
+
+  /**
+   * Move data from a socket into the pipe.
+   * @param fd supplies the socket to read from.
+   * @param max_length supplies the maximum number of bytes to move.
+   * @return the number of bytes moved, 0 if the peer closed the socket or -1 on error, in which
+   *         case errno is set. EAGAIN is reported both when the socket has no data and when the
+   *         pipe is full.
+   */
+  int fill(int fd, uint64_t max_length);
+
+  /**
+   * Move data from the pipe to a socket.
+   * @param fd supplies the socket to write to.
+   * @return the number of bytes moved or -1 on error, in which case errno is set.
+   */
+  int drain(int fd);
+
+  /**
+   * @return the number of bytes in the pipe.
+   */
+  uint64_t length() const { return length_; }
+
+  /**
+   * @return the capacity of the pipe in bytes. The pipe may hold less if the data arrived in small
+   *         segments, as each segment takes up a page of the pipe.
+   */
+  uint64_t capacity() const { return capacity_; }
+
+private:
+  SplicePipe(int read_fd, int write_fd, uint64_t capacity)
+      : read_fd_(read_fd), write_fd_(write_fd), capacity_(capacity) {}
+
+  const int read_fd_;
+  const int write_fd_;
+  const uint64_t capacity_;
+  uint64_t length_{};
+};
+
+} // namespace Network
+} // namespace Envoy
@@ -157,7 +157,7 @@ void Filter::chargeUpstreamCode(uint64_t response_status_code,
       cluster_->loadReportStats().upstream_rq_dropped_.inc();
     }
     if (upstream_host && Http::CodeUtility::is5xx(response_status_code)) {
-      upstream_host->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_host, false);
     }
   }
 }
@@ -253,6 +253,22 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::HeaderMap& headers, bool e
     return Http::FilterHeadersStatus::StopIteration;
   }
 
+  // Shed the request early if the cluster's adaptive concurrency limit has been reached.
+  Upstream::AdaptiveResource& adaptive_requests =
+      cluster_->resourceManager(route_entry_->priority()).adaptiveRequests();
+  if (adaptive_requests.enabled()) {
+    if (!adaptive_requests.canCreate()) {
+      callbacks_->requestInfo().setResponseFlag(RequestInfo::ResponseFlag::UpstreamOverflow);
+      chargeUpstreamCode(Http::Code::ServiceUnavailable, nullptr, true);
+      sendLocalReply(Http::Code::ServiceUnavailable, "concurrency limit exceeded", true);
+      cluster_->stats().upstream_rq_concurrency_limited_.inc();
+      return Http::FilterHeadersStatus::StopIteration;
+    }
+
+    adaptive_requests.inc();
+    adaptive_request_ = &adaptive_requests;
+  }
+
   // Fetch a connection pool for the upstream cluster.
   Http::ConnectionPool::Instance* conn_pool = getConnPool();
   if (!conn_pool) {
@@ -368,6 +384,25 @@ void Filter::cleanup() {
     response_timeout_->disableTimer();
     response_timeout_.reset();
   }
+  if (adaptive_request_) {
+    adaptive_request_->dec();
+    adaptive_request_ = nullptr;
+  }
+}
+
+void Filter::recordAdaptiveResponseTime(bool failed) {
+  if (!adaptive_request_ || !DateUtil::timePointValid(downstream_request_complete_time_)) {
+    return;
+  }
+
+  const std::chrono::milliseconds response_time =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                            downstream_request_complete_time_);
+  if (failed) {
+    adaptive_request_->recordFailure(response_time);
+  } else {
+    adaptive_request_->recordResponseTime(response_time);
+  }
 }
 
 void Filter::maybeDoShadowing() {
@@ -459,7 +494,7 @@ void Filter::onUpstreamReset(UpstreamResetType type,
         retry_state_->shouldRetry(nullptr, reset_reason, [this]() -> void { doRetry(); });
     if (retry_status == RetryStatus::Yes && setupRetry(true)) {
       if (upstream_host) {
-        upstream_host->stats().rq_error_.inc();
+        config_.cm_.recordLoadReport(upstream_host, false);
       }
       return;
     } else if (retry_status == RetryStatus::NoOverflow) {
@@ -467,11 +502,15 @@ void Filter::onUpstreamReset(UpstreamResetType type,
     }
   }
 
+  // A timeout takes at least as long as the timeout, but a reset can come quickly. Neither should
+  // make the upstream look faster than it is to the adaptive concurrency limit.
+  recordAdaptiveResponseTime(type == UpstreamResetType::Reset);
+
   // If we have not yet sent anything downstream, send a response with an appropriate status code.
   // Otherwise just reset the ongoing response.
   if (downstream_response_started_) {
     if (upstream_request_ != nullptr && upstream_request_->grpc_rq_success_deferred_) {
-      upstream_request_->upstream_host_->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_request_->upstream_host_, false);
     }
     // This will destroy any created retry timers.
     cleanup();
@@ -502,7 +541,7 @@ void Filter::onUpstreamReset(UpstreamResetType type,
     // timeout_response_code_ is used for code above, where this member can
     // assume values such as 204 (NoContent).
     if (upstream_host != nullptr && !Http::CodeUtility::is5xx(enumToInt(code))) {
-      upstream_host->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_host, false);
     }
     sendLocalReply(code, body, dropped);
   }
@@ -536,15 +575,15 @@ void Filter::handleNon5xxResponseHeaders(const Http::HeaderMap& headers, bool en
       Optional<Grpc::Status::GrpcStatus> grpc_status = Grpc::Common::getGrpcStatus(headers);
       if (grpc_status.valid() &&
           !Http::CodeUtility::is5xx(Grpc::Common::grpcToHttpStatus(grpc_status.value()))) {
-        upstream_request_->upstream_host_->stats().rq_success_.inc();
+        config_.cm_.recordLoadReport(upstream_request_->upstream_host_, true);
       } else {
-        upstream_request_->upstream_host_->stats().rq_error_.inc();
+        config_.cm_.recordLoadReport(upstream_request_->upstream_host_, false);
       }
     } else {
       upstream_request_->grpc_rq_success_deferred_ = true;
     }
   } else {
-    upstream_request_->upstream_host_->stats().rq_success_.inc();
+    config_.cm_.recordLoadReport(upstream_request_->upstream_host_, true);
   }
 }
 
@@ -568,7 +607,7 @@ void Filter::onUpstreamHeaders(const uint64_t response_code, Http::HeaderMapPtr&
     if (retry_status == RetryStatus::Yes && setupRetry(end_stream)) {
       Http::CodeUtility::chargeBasicResponseStat(cluster_->statsScope(), "retry.",
                                                  static_cast<Http::Code>(response_code));
-      upstream_host->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_host, false);
       return;
     } else if (retry_status == RetryStatus::NoOverflow) {
       callbacks_->requestInfo().setResponseFlag(RequestInfo::ResponseFlag::UpstreamOverflow);
@@ -620,7 +659,7 @@ void Filter::onUpstreamData(Buffer::Instance& data, bool end_stream) {
   if (end_stream) {
     // gRPC request termination without trailers is an error.
     if (upstream_request_->grpc_rq_success_deferred_) {
-      upstream_request_->upstream_host_->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_request_->upstream_host_, false);
     }
     onUpstreamComplete();
   }
@@ -633,9 +672,9 @@ void Filter::onUpstreamTrailers(Http::HeaderMapPtr&& trailers) {
     Optional<Grpc::Status::GrpcStatus> grpc_status = Grpc::Common::getGrpcStatus(*trailers);
     if (grpc_status.valid() &&
         !Http::CodeUtility::is5xx(Grpc::Common::grpcToHttpStatus(grpc_status.value()))) {
-      upstream_request_->upstream_host_->stats().rq_success_.inc();
+      config_.cm_.recordLoadReport(upstream_request_->upstream_host_, true);
     } else {
-      upstream_request_->upstream_host_->stats().rq_error_.inc();
+      config_.cm_.recordLoadReport(upstream_request_->upstream_host_, false);
     }
   }
   onUpstreamComplete();
@@ -647,6 +686,8 @@ void Filter::onUpstreamComplete() {
     upstream_request_->resetStream();
   }
 
+  recordAdaptiveResponseTime(false);
+
   if (config_.emit_dynamic_stats_ && !callbacks_->requestInfo().healthCheck() &&
       DateUtil::timePointValid(downstream_request_complete_time_)) {
     std::chrono::milliseconds response_time = std::chrono::duration_cast<std::chrono::milliseconds>(
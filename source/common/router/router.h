@@ -295,6 +295,13 @@ private:
                                          Upstream::ResourcePriority priority) PURE;
   Http::ConnectionPool::Instance* getConnPool();
   void maybeDoShadowing();
+  /**
+   * Record the time since the request was sent with the adaptive concurrency limit, if this request
+   * is counted against it.
+   * @param failed supplies whether the request failed without a meaningful response time, in
+   *        which case it is recorded as a failure.
+   */
+  void recordAdaptiveResponseTime(bool failed);
   void onRequestComplete();
   void onResponseTimeout();
   void onUpstreamHeaders(uint64_t response_code, Http::HeaderMapPtr&& headers, bool end_stream);
@@ -322,6 +329,8 @@ private:
   FilterUtility::TimeoutData timeout_;
   Http::Code timeout_response_code_ = Http::Code::GatewayTimeout;
   UpstreamRequestPtr upstream_request_;
+  // Set while this request is counted against the cluster's adaptive concurrency limit.
+  Upstream::AdaptiveResource* adaptive_request_{};
   bool grpc_request_{};
   Http::HeaderMap* downstream_headers_{};
   Http::HeaderMap* downstream_trailers_{};
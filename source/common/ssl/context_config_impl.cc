@@ -99,39 +99,7 @@ ServerContextConfigImpl::ServerContextConfigImpl(const envoy::api::v2::Downstrea
     : ContextConfigImpl(config.common_tls_context()),
       require_client_certificate_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, require_client_certificate, false)),
-      session_ticket_keys_([&config] {
-        std::vector<SessionTicketKey> ret;
-
-        switch (config.session_ticket_keys_type_case()) {
-        case envoy::api::v2::DownstreamTlsContext::kSessionTicketKeys:
-          for (const auto& datasource : config.session_ticket_keys().keys()) {
-            switch (datasource.specifier_case()) {
-            case envoy::api::v2::DataSource::kFilename: {
-              validateAndAppendKey(ret, Filesystem::fileReadToEnd(datasource.filename()));
-              break;
-            }
-            case envoy::api::v2::DataSource::kInline: {
-              validateAndAppendKey(ret, datasource.inline_());
-              break;
-            }
-            default:
-              throw EnvoyException(fmt::format("Unexpected DataSource::specifier_case(): {}",
-                                               datasource.specifier_case()));
-            }
-          }
-          break;
-        case envoy::api::v2::DownstreamTlsContext::kSessionTicketKeysSdsSecretConfig:
-          NOT_IMPLEMENTED;
-          break;
-        case envoy::api::v2::DownstreamTlsContext::SESSION_TICKET_KEYS_TYPE_NOT_SET:
-          break;
-        default:
-          throw EnvoyException(fmt::format("Unexpected case for oneof session_ticket_keys: {}",
-                                           config.session_ticket_keys_type_case()));
-        }
-
-        return ret;
-      }()) {
+      session_ticket_keys_(readSessionTicketKeys(config)) {
   // TODO(PiotrSikora): Support multiple TLS certificates.
   // TODO(mattklein123): All of the ASSERTs in this file need to be converted to exceptions with
   //                     proper error handling.
@@ -150,6 +118,41 @@ ServerContextConfigImpl::ServerContextConfigImpl(const Json::Object& config)
         return downstream_tls_context;
       }()) {}
 
+std::vector<ServerContextConfig::SessionTicketKey>
+ServerContextConfigImpl::readSessionTicketKeys(const envoy::api::v2::DownstreamTlsContext& config) {
+  std::vector<SessionTicketKey> ret;
+
+  switch (config.session_ticket_keys_type_case()) {
+  case envoy::api::v2::DownstreamTlsContext::kSessionTicketKeys:
+    for (const auto& datasource : config.session_ticket_keys().keys()) {
+      switch (datasource.specifier_case()) {
+      case envoy::api::v2::DataSource::kFilename: {
+        validateAndAppendKey(ret, Filesystem::fileReadToEnd(datasource.filename()));
+        break;
+      }
+      case envoy::api::v2::DataSource::kInline: {
+        validateAndAppendKey(ret, datasource.inline_());
+        break;
+      }
+      default:
+        throw EnvoyException(fmt::format("Unexpected DataSource::specifier_case(): {}",
+                                         datasource.specifier_case()));
+      }
+    }
+    break;
+  case envoy::api::v2::DownstreamTlsContext::kSessionTicketKeysSdsSecretConfig:
+    NOT_IMPLEMENTED;
+    break;
+  case envoy::api::v2::DownstreamTlsContext::SESSION_TICKET_KEYS_TYPE_NOT_SET:
+    break;
+  default:
+    throw EnvoyException(fmt::format("Unexpected case for oneof session_ticket_keys: {}",
+                                     config.session_ticket_keys_type_case()));
+  }
+
+  return ret;
+}
+
 // Append a SessionTicketKey to keys, initializing it with key_data.
 // Throws if key_data is invalid.
 void ServerContextConfigImpl::validateAndAppendKey(
@@ -75,6 +75,15 @@ public:
     return session_ticket_keys_;
   }
 
+  /**
+   * Read the session ticket keys of a TLS context. Keys in files are read from disk, so this can
+   * be used to pick up rotated keys. Throws if any of the keys is invalid.
+   * @param config supplies the TLS context.
+   * @return the keys, the first of which is used for encrypting new tickets.
+   */
+  static std::vector<SessionTicketKey>
+  readSessionTicketKeys(const envoy::api::v2::DownstreamTlsContext& config);
+
 private:
   const bool require_client_certificate_;
   const std::vector<SessionTicketKey> session_ticket_keys_;
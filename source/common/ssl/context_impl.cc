@@ -12,8 +12,10 @@
 #include "common/common/hex.h"
 
 #include "fmt/format.h"
+#include "openssl/evp.h"
 #include "openssl/hmac.h"
 #include "openssl/rand.h"
+#include "openssl/rsa.h"
 #include "openssl/x509v3.h"
 
 namespace Envoy {
@@ -27,6 +29,119 @@ int ContextImpl::sslContextIndex() {
   }());
 }
 
+int ContextImpl::sslPrivateKeyOperationIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int ssl_private_key_operation_index =
+        SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+    RELEASE_ASSERT(ssl_private_key_operation_index >= 0);
+    return ssl_private_key_operation_index;
+  }());
+}
+
+namespace {
+
+bool signWithPrivateKey(EVP_PKEY* key, uint16_t signature_algorithm,
+                        const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm);
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (md == nullptr || !EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, key)) {
+    return false;
+  }
+
+  // A salt length of -1 means the salt is as long as the digest, as TLS 1.3 requires.
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+
+  size_t output_len = EVP_PKEY_size(key);
+  output.resize(output_len);
+  if (!EVP_DigestSignUpdate(ctx.get(), input.data(), input.size()) ||
+      !EVP_DigestSignFinal(ctx.get(), output.data(), &output_len)) {
+    return false;
+  }
+  output.resize(output_len);
+  return true;
+}
+
+bool decryptWithPrivateKey(EVP_PKEY* key, const std::vector<uint8_t>& input,
+                           std::vector<uint8_t>& output) {
+  RSA* rsa = EVP_PKEY_get0_RSA(key);
+  if (rsa == nullptr) {
+    return false;
+  }
+
+  // BoringSSL removes the padding itself.
+  size_t output_len;
+  output.resize(RSA_size(rsa));
+  if (!RSA_decrypt(rsa, &output_len, output.data(), output.size(), input.data(), input.size(),
+                   RSA_NO_PADDING)) {
+    return false;
+  }
+  output.resize(output_len);
+  return true;
+}
+
+PrivateKeyOperationCallbacks& privateKeyOperationCallbacks(SSL* ssl, int index) {
+  PrivateKeyOperationCallbacks* callbacks =
+      static_cast<PrivateKeyOperationCallbacks*>(SSL_get_ex_data(ssl, index));
+  RELEASE_ASSERT(callbacks != nullptr);
+  return *callbacks;
+}
+
+// The connection's private key, which the operation keeps alive while it runs.
+std::shared_ptr<EVP_PKEY> privateKey(SSL* ssl) {
+  EVP_PKEY* key = SSL_get_privatekey(ssl);
+  RELEASE_ASSERT(key != nullptr);
+  EVP_PKEY_up_ref(key);
+  return std::shared_ptr<EVP_PKEY>(key, EVP_PKEY_free);
+}
+
+} // namespace
+
+void ContextImpl::setPrivateKeyOperationCallbacks(SSL* ssl,
+                                                  PrivateKeyOperationCallbacks& callbacks) {
+  static const SSL_PRIVATE_KEY_METHOD* method = []() -> SSL_PRIVATE_KEY_METHOD* {
+    SSL_PRIVATE_KEY_METHOD* private_key_method = new SSL_PRIVATE_KEY_METHOD();
+    private_key_method->sign = [](SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                      uint16_t signature_algorithm, const uint8_t* in,
+                      size_t in_len) -> ssl_private_key_result_t {
+      std::shared_ptr<EVP_PKEY> key = privateKey(ssl);
+      std::vector<uint8_t> input(in, in + in_len);
+      return privateKeyOperationCallbacks(ssl, sslPrivateKeyOperationIndex())
+          .startPrivateKeyOperation(
+              [key, signature_algorithm, input](std::vector<uint8_t>& output) -> bool {
+                return signWithPrivateKey(key.get(), signature_algorithm, input, output);
+              },
+              out, out_len, max_out);
+    };
+    private_key_method->decrypt = [](SSL* ssl, uint8_t* out, size_t* out_len, size_t max_out,
+                         const uint8_t* in, size_t in_len) -> ssl_private_key_result_t {
+      std::shared_ptr<EVP_PKEY> key = privateKey(ssl);
+      std::vector<uint8_t> input(in, in + in_len);
+      return privateKeyOperationCallbacks(ssl, sslPrivateKeyOperationIndex())
+          .startPrivateKeyOperation(
+              [key, input](std::vector<uint8_t>& output) -> bool {
+                return decryptWithPrivateKey(key.get(), input, output);
+              },
+              out, out_len, max_out);
+    };
+    private_key_method->complete = [](SSL* ssl, uint8_t* out, size_t* out_len,
+                          size_t max_out) -> ssl_private_key_result_t {
+      return privateKeyOperationCallbacks(ssl, sslPrivateKeyOperationIndex())
+          .completePrivateKeyOperation(out, out_len, max_out);
+    };
+    return private_key_method;
+  }();
+
+  int rc = SSL_set_ex_data(ssl, sslPrivateKeyOperationIndex(), &callbacks);
+  RELEASE_ASSERT(rc == 1);
+  UNREFERENCED_PARAMETER(rc);
+  SSL_set_private_key_method(ssl, method);
+}
+
 ContextImpl::ContextImpl(ContextManagerImpl& parent, Stats::Scope& scope,
                          const ContextConfig& config)
     : parent_(parent), ctx_(SSL_CTX_new(TLS_method())), scope_(scope), stats_(generateStats(scope)),
@@ -266,6 +381,14 @@ bool ContextImpl::verifyCertificateHash(X509* cert, const std::vector<uint8_t>&
   return computed_hash == expected_hash;
 }
 
+bool ContextImpl::dynamicRecordSizing() const {
+  return parent_.runtime().snapshot().featureEnabled("ssl.dynamic_record_sizing", 0);
+}
+
+bool ContextImpl::asyncPrivateKeyOperations() const {
+  return parent_.runtime().snapshot().featureEnabled("ssl.async_private_key_operations", 0);
+}
+
 SslStats ContextImpl::generateStats(Stats::Scope& store) {
   std::string prefix("ssl.");
   return {ALL_SSL_STATS(POOL_COUNTER_PREFIX(store, prefix), POOL_GAUGE_PREFIX(store, prefix),
@@ -347,6 +470,57 @@ ClientContextImpl::ClientContextImpl(ContextManagerImpl& parent, Stats::Scope& s
   }
 
   server_name_indication_ = config.serverNameIndication();
+
+  SSL_CTX_set_session_cache_mode(ctx_.get(), SSL_SESS_CACHE_CLIENT);
+  SSL_CTX_sess_set_new_cb(ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+    ContextImpl* context_impl = static_cast<ContextImpl*>(
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), sslContextIndex()));
+    ClientContextImpl* client_context_impl = dynamic_cast<ClientContextImpl*>(context_impl);
+    RELEASE_ASSERT(client_context_impl != nullptr); // for Coverity
+    return client_context_impl->newSession(ssl, session);
+  });
+}
+
+int ClientContextImpl::sslPeerIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int ssl_peer_index = SSL_get_ex_new_index(
+        0, nullptr, nullptr, nullptr,
+        [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) -> void {
+          delete static_cast<std::string*>(ptr);
+        });
+    RELEASE_ASSERT(ssl_peer_index >= 0);
+    return ssl_peer_index;
+  }());
+}
+
+void ClientContextImpl::resumeSession(SSL* ssl, const std::string& peer) {
+  int rc = SSL_set_ex_data(ssl, sslPeerIndex(), new std::string(peer));
+  RELEASE_ASSERT(rc == 1);
+  UNREFERENCED_PARAMETER(rc);
+
+  bssl::UniquePtr<SSL_SESSION> session = session_cache_.lookup(peer);
+  if (session == nullptr) {
+    stats_.session_cache_miss_.inc();
+    return;
+  }
+
+  stats_.session_cache_hit_.inc();
+  // SSL_set_session() takes its own reference to the session.
+  SSL_set_session(ssl, session.get());
+}
+
+void ClientContextImpl::removeSession(const std::string& peer) { session_cache_.remove(peer); }
+
+int ClientContextImpl::newSession(SSL* ssl, SSL_SESSION* session) {
+  const std::string* peer = static_cast<const std::string*>(SSL_get_ex_data(ssl, sslPeerIndex()));
+  if (peer == nullptr) {
+    // The connection wasn't set up for resumption.
+    return 0;
+  }
+
+  // Returning 1 takes ownership of the reference BoringSSL passed in.
+  session_cache_.insert(*peer, bssl::UniquePtr<SSL_SESSION>(session));
+  return 1;
 }
 
 bssl::UniquePtr<SSL> ClientContextImpl::newSsl() const {
@@ -367,7 +541,7 @@ ServerContextImpl::ServerContextImpl(ContextManagerImpl& parent, const std::stri
                                      bool skip_context_update, Runtime::Loader& runtime)
     : ContextImpl(parent, scope, config), listener_name_(listener_name),
       server_names_(server_names), skip_context_update_(skip_context_update), runtime_(runtime),
-      session_ticket_keys_(config.sessionTicketKeys()) {
+      session_ticket_keys_(std::make_shared<const SessionTicketKeys>(config.sessionTicketKeys())) {
   SSL_CTX_set_select_certificate_cb(
       ctx_.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
         ContextImpl* context_impl = static_cast<ContextImpl*>(
@@ -400,7 +574,24 @@ ServerContextImpl::ServerContextImpl(ContextManagerImpl& parent, const std::stri
                                this);
   }
 
-  if (!session_ticket_keys_.empty()) {
+  // Session ID resumption uses the session cache shared by all server contexts instead of the
+  // per-SSL_CTX internal one, so that a client can resume on any worker and on contexts that
+  // replaced the one it originally connected to.
+  SSL_CTX_set_session_cache_mode(ctx_.get(), SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+  SSL_CTX_sess_set_new_cb(ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+    return fromSslCtx(SSL_get_SSL_CTX(ssl))->newSession(session);
+  });
+  SSL_CTX_sess_set_get_cb(
+      ctx_.get(), [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+        // The returned session already carries a reference for the caller.
+        *out_copy = 0;
+        return fromSslCtx(SSL_get_SSL_CTX(ssl))->getSession(id, id_len);
+      });
+  SSL_CTX_sess_set_remove_cb(ctx_.get(), [](SSL_CTX* ctx, SSL_SESSION* session) -> void {
+    fromSslCtx(ctx)->removeSession(session);
+  });
+
+  if (!session_ticket_keys_->empty()) {
     SSL_CTX_set_tlsext_ticket_key_cb(
         ctx_.get(),
         [](SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx,
@@ -549,6 +740,14 @@ void ServerContextImpl::updateConnectionContext(SSL* ssl) {
   SSL_set_SSL_CTX(ssl, ctx_.get());
   ASSERT(SSL_CTX_get_ex_data(ctx_.get(), sslContextIndex()) == this);
 
+  // The private key method is reset along with the certificate.
+  PrivateKeyOperationCallbacks* private_key_operation_callbacks =
+      static_cast<PrivateKeyOperationCallbacks*>(
+          SSL_get_ex_data(ssl, sslPrivateKeyOperationIndex()));
+  if (private_key_operation_callbacks != nullptr) {
+    setPrivateKeyOperationCallbacks(ssl, *private_key_operation_callbacks);
+  }
+
   // Update SSL-level settings and parameters that are inherited from SSL_CTX during SSL_new().
   // TODO(PiotrSikora): add SSL_early_set_SSL_CTX() to BoringSSL.
 
@@ -566,19 +765,80 @@ void ServerContextImpl::updateConnectionContext(SSL* ssl) {
   UNREFERENCED_PARAMETER(rc);
 }
 
+ServerContextImpl* ServerContextImpl::fromSslCtx(const SSL_CTX* ctx) {
+  ContextImpl* context_impl =
+      static_cast<ContextImpl*>(SSL_CTX_get_ex_data(ctx, sslContextIndex()));
+  ServerContextImpl* server_context_impl = dynamic_cast<ServerContextImpl*>(context_impl);
+  RELEASE_ASSERT(server_context_impl != nullptr); // for Coverity
+  return server_context_impl;
+}
+
+int ServerContextImpl::newSession(SSL_SESSION* session) {
+  unsigned id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  if (id_len == 0) {
+    // Sessions that were issued a ticket have no ID and don't need to be cached.
+    return 0;
+  }
+
+  // Returning 1 takes ownership of the reference BoringSSL passed in.
+  parent_.sessionCache().insert(std::string(reinterpret_cast<const char*>(id), id_len),
+                                bssl::UniquePtr<SSL_SESSION>(session));
+  return 1;
+}
+
+void ServerContextImpl::removeSession(SSL_SESSION* session) {
+  unsigned id_len;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_len);
+  parent_.sessionCache().remove(std::string(reinterpret_cast<const char*>(id), id_len));
+}
+
+SSL_SESSION* ServerContextImpl::getSession(const uint8_t* id, int id_len) {
+  bssl::UniquePtr<SSL_SESSION> session =
+      parent_.sessionCache().lookup(std::string(reinterpret_cast<const char*>(id), id_len));
+  if (session == nullptr) {
+    stats_.session_cache_miss_.inc();
+    return nullptr;
+  }
+
+  stats_.session_cache_hit_.inc();
+  return session.release();
+}
+
+void ServerContextImpl::setSessionTicketKeys(const SessionTicketKeys& keys) {
+  if (keys.empty()) {
+    return;
+  }
+
+  auto new_keys = std::make_shared<const SessionTicketKeys>(keys);
+  std::unique_lock<std::shared_timed_mutex> lock(session_ticket_keys_lock_);
+  // The ticket key callback is only installed when keys were configured, see the constructor.
+  if (session_ticket_keys_->empty()) {
+    return;
+  }
+  session_ticket_keys_ = std::move(new_keys);
+  stats_.session_ticket_keys_rotated_.inc();
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
   const EVP_CIPHER* cipher = EVP_aes_256_cbc();
 
+  std::shared_ptr<const SessionTicketKeys> keys;
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(session_ticket_keys_lock_);
+    keys = session_ticket_keys_;
+  }
+
   if (encrypt == 1) {
     // Encrypt
-    RELEASE_ASSERT(session_ticket_keys_.size() >= 1);
+    RELEASE_ASSERT(keys->size() >= 1);
     // TODO(ggreenway): validate in SDS that session_ticket_keys_ cannot be empty,
     // or if we allow it to be emptied, reconfigure the context so this callback
     // isn't set.
 
-    const ServerContextConfig::SessionTicketKey& key = session_ticket_keys_.front();
+    const ServerContextConfig::SessionTicketKey& key = keys->front();
 
     static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
                   "Expected key.name length");
@@ -603,7 +863,7 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
   } else {
     // Decrypt
     bool is_enc_key = true; // first element is the encryption key
-    for (const ServerContextConfig::SessionTicketKey& key : session_ticket_keys_) {
+    for (const ServerContextConfig::SessionTicketKey& key : *keys) {
       static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
                     "Expected key.name length");
       if (std::equal(key.name_.begin(), key.name_.end(), key_name)) {
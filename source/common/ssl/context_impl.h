@@ -1,8 +1,12 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
+#include "envoy/common/pure.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/context_config.h"
@@ -11,6 +15,7 @@
 
 #include "common/ssl/context_impl.h"
 #include "common/ssl/context_manager_impl.h"
+#include "common/ssl/session_cache.h"
 
 #include "openssl/ssl.h"
 
@@ -21,17 +26,26 @@ namespace Envoy {
 
 namespace Ssl {
 
+// record_written counts the TLS records written and write_calls the doWrite() calls that wrote at
+// least one record, so record_written / write_calls is the average number of records per write.
 // clang-format off
 #define ALL_SSL_STATS(COUNTER, GAUGE, HISTOGRAM)                                                   \
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
   COUNTER(session_reused)                                                                          \
+  COUNTER(session_cache_hit)                                                                       \
+  COUNTER(session_cache_miss)                                                                      \
+  COUNTER(session_ticket_keys_rotated)                                                             \
+  COUNTER(private_key_op_offloaded)                                                                \
+  COUNTER(private_key_op_inline)                                                                   \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_no_sni_match)                                                                       \
   COUNTER(fail_verify_no_cert)                                                                     \
   COUNTER(fail_verify_error)                                                                       \
   COUNTER(fail_verify_san)                                                                         \
-  COUNTER(fail_verify_cert_hash)
+  COUNTER(fail_verify_cert_hash)                                                                   \
+  COUNTER(record_written)                                                                          \
+  COUNTER(write_calls)
 // clang-format on
 
 /**
@@ -41,6 +55,35 @@ struct SslStats {
   ALL_SSL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
+/**
+ * Runs the private key operations of a single connection, e.g. on the crypto thread pool.
+ * @see ContextImpl::setPrivateKeyOperationCallbacks().
+ */
+class PrivateKeyOperationCallbacks {
+public:
+  virtual ~PrivateKeyOperationCallbacks() {}
+
+  /**
+   * A private key operation. It may run on any thread, and writes its result to output.
+   * @return false if the operation failed.
+   */
+  typedef std::function<bool(std::vector<uint8_t>& output)> Operation;
+
+  /**
+   * Start a private key operation. If it completes synchronously, its result is written to out.
+   * @return the BoringSSL result, ssl_private_key_retry if the operation is still running.
+   */
+  virtual ssl_private_key_result_t startPrivateKeyOperation(Operation operation, uint8_t* out,
+                                                            size_t* out_len, size_t max_out) PURE;
+
+  /**
+   * Called by BoringSSL when it retries the handshake after a started private key operation.
+   * @return the BoringSSL result, ssl_private_key_retry if the operation is still running.
+   */
+  virtual ssl_private_key_result_t completePrivateKeyOperation(uint8_t* out, size_t* out_len,
+                                                               size_t max_out) PURE;
+};
+
 class ContextImpl : public virtual Context {
 public:
   virtual bssl::UniquePtr<SSL> newSsl() const;
@@ -68,8 +111,33 @@ public:
    */
   static bool dNSNameMatch(const std::string& dnsName, const char* pattern);
 
+  /**
+   * Hand the private key operations of a connection to callbacks, instead of running them inline
+   * in the handshake.
+   * @param ssl supplies the connection.
+   * @param callbacks supplies the callbacks, which must outlive the connection.
+   */
+  static void setPrivateKeyOperationCallbacks(SSL* ssl, PrivateKeyOperationCallbacks& callbacks);
+
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return whether a new connection should use dynamic TLS record sizing, i.e. start with records
+   *         that fit in a single TCP segment and only use full-size records once enough data has
+   *         been sent. This is controlled by the ssl.dynamic_record_sizing runtime key, which
+   *         defaults to 0%.
+   */
+  bool dynamicRecordSizing() const;
+
+  /**
+   * @return whether a new server connection should run its private key operations on the crypto
+   *         thread pool instead of inline on the worker. This is controlled by the
+   *         ssl.async_private_key_operations runtime key, which defaults to 0%.
+   */
+  bool asyncPrivateKeyOperations() const;
+
+  CryptoThreadPool& cryptoThreadPool() { return parent_.cryptoThreadPool(); }
+
   // Ssl::Context
   size_t daysUntilFirstCertExpires() const override;
   std::string getCaCertInformation() const override;
@@ -84,6 +152,12 @@ protected:
    */
   static int sslContextIndex();
 
+  /**
+   * The global SSL-library index used for storing the PrivateKeyOperationCallbacks of a
+   * connection in the SSL instance.
+   */
+  static int sslPrivateKeyOperationIndex();
+
   static int verifyCallback(X509_STORE_CTX* store_ctx, void* arg);
   int verifyCertificate(X509* cert);
 
@@ -131,8 +205,31 @@ public:
 
   bssl::UniquePtr<SSL> newSsl() const override;
 
+  /**
+   * Offer the session cached for a peer, if any, on a new connection to it. Sessions that the
+   * peer hands out on the connection replace the cached one. The cache is shared by all workers.
+   * @param ssl supplies the new connection.
+   * @param peer supplies the key of the peer, i.e. the address of the upstream host.
+   */
+  void resumeSession(SSL* ssl, const std::string& peer);
+
+  /**
+   * Forget the session cached for a peer, e.g. because a handshake with it failed.
+   * @param peer supplies the key of the peer.
+   */
+  void removeSession(const std::string& peer);
+
 private:
+  /**
+   * The global SSL-library index used for storing the peer key of a connection in the SSL
+   * instance, for retrieval in the new session callback.
+   */
+  static int sslPeerIndex();
+
+  int newSession(SSL* ssl, SSL_SESSION* session);
+
   std::string server_name_indication_;
+  SessionCache session_cache_;
 };
 
 class ServerContextImpl : public ContextImpl, public ServerContext {
@@ -143,7 +240,14 @@ public:
                     Runtime::Loader& runtime);
   ~ServerContextImpl() { parent_.releaseServerContext(this, listener_name_, server_names_); }
 
+  typedef std::vector<ServerContextConfig::SessionTicketKey> SessionTicketKeys;
+
+  // Ssl::ServerContext
+  void setSessionTicketKeys(const SessionTicketKeys& keys) override;
+
 private:
+  static ServerContextImpl* fromSslCtx(const SSL_CTX* ctx);
+
   ssl_select_cert_result_t processClientHello(const SSL_CLIENT_HELLO* client_hello);
   void updateConnectionContext(SSL* ssl);
 
@@ -151,13 +255,19 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  int newSession(SSL_SESSION* session);
+  void removeSession(SSL_SESSION* session);
+  SSL_SESSION* getSession(const uint8_t* id, int id_len);
 
   const std::string listener_name_;
   const std::vector<std::string> server_names_;
   const bool skip_context_update_;
   Runtime::Loader& runtime_;
   std::vector<uint8_t> parsed_alt_alpn_protocols_;
-  const std::vector<ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  // Replaced as a whole on rotation. Handshakes on the workers take a reference to the current
+  // keys, so the lock is only held long enough to copy the pointer.
+  std::shared_ptr<const SessionTicketKeys> session_ticket_keys_;
+  mutable std::shared_timed_mutex session_ticket_keys_lock_;
 };
 
 } // namespace Ssl
@@ -1,7 +1,9 @@
 #include "common/ssl/context_manager_impl.h"
 
+#include <algorithm>
 #include <functional>
 #include <shared_mutex>
+#include <thread>
 
 #include "common/common/assert.h"
 #include "common/common/empty_string.h"
@@ -10,8 +12,30 @@
 namespace Envoy {
 namespace Ssl {
 
+namespace {
+// Bounds the handshakes waiting for a crypto thread, per thread. Beyond that, operations run inline
+// on the workers.
+const uint32_t MaxPendingCryptoOperationsPerThread = 64;
+} // namespace
+
 ContextManagerImpl::~ContextManagerImpl() { ASSERT(contexts_.empty()); }
 
+CryptoThreadPool& ContextManagerImpl::cryptoThreadPool() {
+  std::call_once(crypto_thread_pool_once_, [this]() -> void {
+    const uint32_t num_threads = std::max(1U, std::thread::hardware_concurrency());
+    crypto_thread_pool_.reset(
+        new CryptoThreadPool(num_threads, num_threads * MaxPendingCryptoOperationsPerThread));
+  });
+  return *crypto_thread_pool_;
+}
+
+void ContextManagerImpl::shutdown() {
+  // The workers have stopped, so nothing can start the pool concurrently.
+  if (crypto_thread_pool_ != nullptr) {
+    crypto_thread_pool_->shutdown();
+  }
+}
+
 void ContextManagerImpl::releaseClientContext(ClientContext* context) {
   std::unique_lock<std::shared_timed_mutex> lock(contexts_lock_);
 
@@ -27,27 +51,18 @@ void ContextManagerImpl::releaseServerContext(ServerContext* context,
   std::unique_lock<std::shared_timed_mutex> lock(contexts_lock_);
 
   // Remove mappings.
-  auto& listener_map_exact = map_exact_[listener_name];
-  if (server_names.empty()) {
-    const auto ctx = listener_map_exact.find(EMPTY_STRING);
-    if (ctx != listener_map_exact.end() && ctx->second == context) {
-      listener_map_exact.erase(ctx);
-    }
-  } else {
-    auto& listener_map_wildcard = map_wildcard_[listener_name];
-    for (const auto& name : server_names) {
-      if (isWildcardServerName(name)) {
-        const auto ctx = listener_map_wildcard.find(name);
-        if (ctx != listener_map_wildcard.end() && ctx->second == context) {
-          listener_map_wildcard.erase(ctx);
-        }
-      } else {
-        const auto ctx = listener_map_exact.find(name);
-        if (ctx != listener_map_exact.end() && ctx->second == context) {
-          listener_map_exact.erase(ctx);
-        }
+  const auto index = server_name_indexes_.find(listener_name);
+  if (index != server_name_indexes_.end()) {
+    if (server_names.empty()) {
+      index->second.remove(EMPTY_STRING, context);
+    } else {
+      for (const auto& name : server_names) {
+        index->second.remove(name, context);
       }
     }
+    if (index->second.empty()) {
+      server_name_indexes_.erase(index);
+    }
   }
 
   // context may not be found, in the case that a subclass of Context throws
@@ -64,10 +79,6 @@ ClientContextPtr ContextManagerImpl::createSslClientContext(Stats::Scope& scope,
   return context;
 }
 
-bool ContextManagerImpl::isWildcardServerName(const std::string& name) {
-  return name.size() > 2 && name[0] == '*' && name[1] == '.';
-}
-
 ServerContextPtr ContextManagerImpl::createSslServerContext(
     const std::string& listener_name, const std::vector<std::string>& server_names,
     Stats::Scope& scope, const ServerContextConfig& config, bool skip_context_update) {
@@ -77,15 +88,12 @@ ServerContextPtr ContextManagerImpl::createSslServerContext(
   contexts_.emplace_back(context.get());
 
   // Save mappings.
+  ServerNameIndex& index = server_name_indexes_[listener_name];
   if (server_names.empty()) {
-    map_exact_[listener_name][EMPTY_STRING] = context.get();
+    index.add(EMPTY_STRING, context.get());
   } else {
     for (const auto& name : server_names) {
-      if (isWildcardServerName(name)) {
-        map_wildcard_[listener_name][name] = context.get();
-      } else {
-        map_exact_[listener_name][name] = context.get();
-      }
+      index.add(name, context.get());
     }
   }
 
@@ -94,45 +102,11 @@ ServerContextPtr ContextManagerImpl::createSslServerContext(
 
 ServerContext* ContextManagerImpl::findSslServerContext(const std::string& listener_name,
                                                         const std::string& server_name) const {
-  // Find Ssl::ServerContext to use. The algorithm for "www.example.com" is as follows:
-  // 1. Try exact match on domain, i.e. "www.example.com"
-  // 2. Try exact match on wildcard, i.e. "*.example.com"
-  // 3. Try "no SNI" match, i.e. ""
-  // 4. Return no context and reject connection.
-
   // TODO(PiotrSikora): make this lockless.
   std::shared_lock<std::shared_timed_mutex> lock(contexts_lock_);
 
-  // TODO(PiotrSikora): refactor and combine code with RouteMatcher::findVirtualHost().
-  const auto listener_map_exact = map_exact_.find(listener_name);
-  if (listener_map_exact != map_exact_.end()) {
-    const auto ctx = listener_map_exact->second.find(server_name);
-    if (ctx != listener_map_exact->second.end()) {
-      return ctx->second;
-    }
-  }
-
-  // Try to construct and match wildcard domain.
-  const size_t pos = server_name.find('.');
-  if (pos > 0 && pos < server_name.size() - 1) {
-    const std::string wildcard = '*' + server_name.substr(pos);
-    const auto listener_map_wildcard = map_wildcard_.find(listener_name);
-    if (listener_map_wildcard != map_wildcard_.end()) {
-      const auto ctx = listener_map_wildcard->second.find(wildcard);
-      if (ctx != listener_map_wildcard->second.end()) {
-        return ctx->second;
-      }
-    }
-  }
-
-  if (listener_map_exact != map_exact_.end()) {
-    const auto ctx = listener_map_exact->second.find(EMPTY_STRING);
-    if (ctx != listener_map_exact->second.end()) {
-      return ctx->second;
-    }
-  }
-
-  return nullptr;
+  const auto index = server_name_indexes_.find(listener_name);
+  return index != server_name_indexes_.end() ? index->second.find(server_name) : nullptr;
 }
 
 size_t ContextManagerImpl::daysUntilFirstCertExpires() const {
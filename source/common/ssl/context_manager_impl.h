@@ -2,12 +2,18 @@
 
 #include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
 
 #include "envoy/runtime/runtime.h"
 #include "envoy/ssl/context_manager.h"
 
+#include "common/ssl/crypto_thread_pool.h"
+#include "common/ssl/server_name_index.h"
+#include "common/ssl/session_cache.h"
+
 namespace Envoy {
 namespace Ssl {
 
@@ -45,14 +51,34 @@ public:
   size_t daysUntilFirstCertExpires() const override;
   void iterateContexts(std::function<void(const Context&)> callback) override;
 
-private:
-  static bool isWildcardServerName(const std::string& name);
+  Runtime::Loader& runtime() { return runtime_; }
+
+  /**
+   * @return the session cache shared by all server contexts.
+   */
+  SessionCache& sessionCache() { return session_cache_; }
+
+  /**
+   * @return the thread pool that runs asynchronous private key operations for all contexts. The
+   *         threads are only started on first use.
+   */
+  CryptoThreadPool& cryptoThreadPool();
+
+  /**
+   * Stop the crypto threads if they were started. Operations post their results to the workers'
+   * dispatchers, so this must be called once the workers have stopped, but before their
+   * dispatchers are destroyed.
+   */
+  void shutdown();
 
+private:
   Runtime::Loader& runtime_;
+  SessionCache session_cache_;
+  std::once_flag crypto_thread_pool_once_;
+  std::unique_ptr<CryptoThreadPool> crypto_thread_pool_;
   std::list<Context*> contexts_;
   mutable std::shared_timed_mutex contexts_lock_;
-  std::unordered_map<std::string, std::unordered_map<std::string, ServerContext*>> map_exact_;
-  std::unordered_map<std::string, std::unordered_map<std::string, ServerContext*>> map_wildcard_;
+  std::unordered_map<std::string, ServerNameIndex> server_name_indexes_;
 };
 
 } // namespace Ssl
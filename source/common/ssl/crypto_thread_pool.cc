@@ -0,0 +1,58 @@
+#include "common/ssl/crypto_thread_pool.h"
+
+namespace Envoy {
+namespace Ssl {
+
+CryptoThreadPool::CryptoThreadPool(uint32_t num_threads, uint32_t max_pending)
+    : max_pending_(max_pending) {
+  for (uint32_t i = 0; i < num_threads; i++) {
+    threads_.emplace_back(new Thread::Thread([this]() -> void { threadRoutine(); }));
+  }
+}
+
+CryptoThreadPool::~CryptoThreadPool() { shutdown(); }
+
+void CryptoThreadPool::shutdown() {
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    exit_ = true;
+  }
+  pending_event_.notify_all();
+
+  // Operations that are still queued are run before the threads exit.
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+  threads_.clear();
+}
+
+bool CryptoThreadPool::post(Operation operation) {
+  {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (exit_ || pending_.size() >= max_pending_) {
+      return false;
+    }
+    pending_.push_back(std::move(operation));
+  }
+  pending_event_.notify_one();
+  return true;
+}
+
+void CryptoThreadPool::threadRoutine() {
+  while (true) {
+    Operation operation;
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      pending_event_.wait(lock, [this]() -> bool { return exit_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      operation = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    operation();
+  }
+}
+
+} // namespace Ssl
+} // namespace Envoy
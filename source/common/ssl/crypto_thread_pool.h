@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
+
+#include "common/common/thread.h"
+
+namespace Envoy {
+namespace Ssl {
+
+/**
+ * A fixed set of threads that run CPU heavy TLS operations, such as private key signatures, off the
+ * workers. The queue of pending operations is bounded, so that a handshake storm can't queue up
+ * an unbounded amount of work. Callers are expected to run the operation inline when the queue is
+ * full.
+ */
+class CryptoThreadPool {
+public:
+  typedef std::function<void()> Operation;
+
+  /**
+   * @param num_threads supplies the number of threads to run operations on.
+   * @param max_pending supplies the maximum number of operations waiting for a thread.
+   */
+  CryptoThreadPool(uint32_t num_threads, uint32_t max_pending);
+  ~CryptoThreadPool();
+
+  /**
+   * Queue an operation to run on one of the threads.
+   * @param operation supplies the operation.
+   * @return false if the queue is full and the operation was not queued.
+   */
+  bool post(Operation operation);
+
+  /**
+   * Run the operations that are still queued and stop the threads. Later posts fail. Operations
+   * complete on the workers' dispatchers, so this must be called before they are torn down. It is
+   * also called by the destructor.
+   */
+  void shutdown();
+
+private:
+  void threadRoutine();
+
+  const uint32_t max_pending_;
+  std::mutex lock_;
+  std::condition_variable pending_event_;
+  std::list<Operation> pending_;
+  bool exit_{};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+} // namespace Ssl
+} // namespace Envoy
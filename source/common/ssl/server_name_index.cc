@@ -0,0 +1,130 @@
+#include "common/ssl/server_name_index.h"
+
+#include <vector>
+
+#include "common/common/empty_string.h"
+
+namespace Envoy {
+namespace Ssl {
+
+namespace {
+
+/**
+ * Invoke a callback for each label of the domain starting at domain[begin], from the rightmost
+ * label to the leftmost one, until the callback returns false. The labels passed to the callback
+ * view the domain.
+ * @return false if the callback stopped the iteration.
+ */
+template <class Callback>
+bool forEachLabelReversed(const std::string& domain, size_t begin, Callback callback) {
+  const absl::string_view labels(domain.data() + begin, domain.size() - begin);
+  size_t end = labels.size();
+  while (true) {
+    const size_t dot = end > 0 ? labels.rfind('.', end - 1) : absl::string_view::npos;
+    const size_t start = dot == absl::string_view::npos ? 0 : dot + 1;
+    if (!callback(labels.substr(start, end - start))) {
+      return false;
+    }
+    if (start == 0) {
+      return true;
+    }
+    end = start - 1;
+  }
+}
+
+} // namespace
+
+bool ServerNameIndex::isWildcardServerName(const std::string& name) {
+  return name.size() > 2 && name[0] == '*' && name[1] == '.';
+}
+
+void ServerNameIndex::add(const std::string& server_name, ServerContext* context) {
+  if (!isWildcardServerName(server_name)) {
+    exact_[server_name] = context;
+    return;
+  }
+
+  Node* node = &wildcard_;
+  forEachLabelReversed(server_name, 2, [&node](absl::string_view label) -> bool {
+    const auto child = node->children_.find(label);
+    if (child != node->children_.end()) {
+      node = child->second.get();
+      return true;
+    }
+    std::unique_ptr<Node> new_child(new Node());
+    new_child->label_ = std::string(label);
+    Node* next = new_child.get();
+    node->children_.emplace(absl::string_view(next->label_), std::move(new_child));
+    node = next;
+    return true;
+  });
+  node->context_ = context;
+}
+
+void ServerNameIndex::remove(const std::string& server_name, const ServerContext* context) {
+  if (!isWildcardServerName(server_name)) {
+    const auto ctx = exact_.find(server_name);
+    if (ctx != exact_.end() && ctx->second == context) {
+      exact_.erase(ctx);
+    }
+    return;
+  }
+
+  // Remember the path to the node, so that nodes left without a context or children can be
+  // pruned on the way back up.
+  std::vector<std::pair<Node*, absl::string_view>> path;
+  Node* node = &wildcard_;
+  const bool found = forEachLabelReversed(server_name, 2, [&](absl::string_view label) -> bool {
+    const auto child = node->children_.find(label);
+    if (child == node->children_.end()) {
+      return false;
+    }
+    path.emplace_back(node, label);
+    node = child->second.get();
+    return true;
+  });
+  if (!found || node->context_ != context) {
+    return;
+  }
+
+  node->context_ = nullptr;
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    const auto child = it->first->children_.find(it->second);
+    if (child->second->context_ != nullptr || !child->second->children_.empty()) {
+      break;
+    }
+    it->first->children_.erase(child);
+  }
+}
+
+ServerContext* ServerNameIndex::find(const std::string& server_name) const {
+  const auto ctx = exact_.find(server_name);
+  if (ctx != exact_.end()) {
+    return ctx->second;
+  }
+
+  // Wildcards only match a single label, so "*.example.com" is looked up with the labels of
+  // "www.example.com" that follow the first dot.
+  const size_t pos = server_name.find('.');
+  if (pos > 0 && pos < server_name.size() - 1) {
+    const Node* node = &wildcard_;
+    const bool found =
+        forEachLabelReversed(server_name, pos + 1, [&node](absl::string_view label) -> bool {
+          const auto child = node->children_.find(label);
+          if (child == node->children_.end()) {
+            return false;
+          }
+          node = child->second.get();
+          return true;
+        });
+    if (found && node->context_ != nullptr) {
+      return node->context_;
+    }
+  }
+
+  const auto no_sni_ctx = exact_.find(EMPTY_STRING);
+  return no_sni_ctx != exact_.end() ? no_sni_ctx->second : nullptr;
+}
+
+} // namespace Ssl
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "envoy/ssl/context.h"
+
+#include "common/common/hash.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Ssl {
+
+/**
+ * Maps the server names (SNI) served by a listener to the server contexts serving them. Exact
+ * names are kept in a hash map and wildcard names (e.g. "*.example.com") in a trie keyed on the
+ * labels of the domain in reverse order, so that a lookup takes a number of steps proportional to
+ * the number of labels in the server name, independent of how many names the listener serves.
+ */
+class ServerNameIndex {
+public:
+  /**
+   * Add a server name. A server name that is already present is remapped to the new context.
+   * @param server_name supplies an exact name, a wildcard name, or "" for connections without a
+   *        matching SNI.
+   * @param context supplies the context serving the name.
+   */
+  void add(const std::string& server_name, ServerContext* context);
+
+  /**
+   * Remove a server name, but only if it is still mapped to the given context.
+   * @param server_name supplies the name passed to add().
+   * @param context supplies the context passed to add().
+   */
+  void remove(const std::string& server_name, const ServerContext* context);
+
+  /**
+   * Find the context for a server name. The algorithm for "www.example.com" is as follows:
+   * 1. Try exact match on domain, i.e. "www.example.com"
+   * 2. Try match on wildcard, i.e. "*.example.com"
+   * 3. Try "no SNI" match, i.e. ""
+   * @return ServerContext* or nullptr in case there is no match.
+   */
+  ServerContext* find(const std::string& server_name) const;
+
+  /**
+   * @return true if no server names are mapped.
+   */
+  bool empty() const { return exact_.empty() && wildcard_.children_.empty(); }
+
+  static bool isWildcardServerName(const std::string& name);
+
+private:
+  struct LabelHash {
+    size_t operator()(absl::string_view label) const { return HashUtil::xxHash64(label); }
+  };
+
+  struct Node {
+    // Label leading to this node from its parent. The parent's key for this node views it, so
+    // that lookups can use views of the server name without copying each label.
+    std::string label_;
+    std::unordered_map<absl::string_view, std::unique_ptr<Node>, LabelHash> children_;
+    // Context serving "*.<labels leading to this node>", if any.
+    ServerContext* context_{};
+  };
+
+  std::unordered_map<std::string, ServerContext*> exact_;
+  Node wildcard_;
+};
+
+} // namespace Ssl
+} // namespace Envoy
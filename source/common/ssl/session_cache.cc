@@ -0,0 +1,74 @@
+#include "common/ssl/session_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Envoy {
+namespace Ssl {
+
+const size_t SessionCache::DEFAULT_CAPACITY;
+const size_t SessionCache::NUM_SHARDS;
+
+SessionCache::SessionCache(size_t capacity)
+    : shard_capacity_(std::max<size_t>(1, capacity / NUM_SHARDS)) {}
+
+SessionCache::Shard& SessionCache::shardFor(const std::string& id) {
+  return shards_[std::hash<std::string>()(id) % NUM_SHARDS];
+}
+
+void SessionCache::insert(const std::string& id, bssl::UniquePtr<SSL_SESSION> session) {
+  Shard& shard = shardFor(id);
+  std::unique_lock<std::mutex> lock(shard.lock_);
+
+  auto it = shard.map_.find(id);
+  if (it != shard.map_.end()) {
+    it->second->second = std::move(session);
+    shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+    return;
+  }
+
+  if (shard.lru_.size() >= shard_capacity_) {
+    shard.map_.erase(shard.lru_.back().first);
+    shard.lru_.pop_back();
+  }
+  shard.lru_.emplace_front(id, std::move(session));
+  shard.map_.emplace(id, shard.lru_.begin());
+}
+
+bssl::UniquePtr<SSL_SESSION> SessionCache::lookup(const std::string& id) {
+  Shard& shard = shardFor(id);
+  std::unique_lock<std::mutex> lock(shard.lock_);
+
+  auto it = shard.map_.find(id);
+  if (it == shard.map_.end()) {
+    return nullptr;
+  }
+
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, it->second);
+  SSL_SESSION* session = it->second->second.get();
+  SSL_SESSION_up_ref(session);
+  return bssl::UniquePtr<SSL_SESSION>(session);
+}
+
+void SessionCache::remove(const std::string& id) {
+  Shard& shard = shardFor(id);
+  std::unique_lock<std::mutex> lock(shard.lock_);
+
+  auto it = shard.map_.find(id);
+  if (it != shard.map_.end()) {
+    shard.lru_.erase(it->second);
+    shard.map_.erase(it);
+  }
+}
+
+size_t SessionCache::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    std::unique_lock<std::mutex> lock(shard.lock_);
+    size += shard.lru_.size();
+  }
+  return size;
+}
+
+} // namespace Ssl
+} // namespace Envoy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Ssl {
+
+/**
+ * A bounded cache of TLS sessions, keyed by a string whose meaning depends on the user:
+ * - Server side, the key is the session ID. A single instance is shared by all server contexts and
+ *   therefore by all workers, so a client that reconnects to a different worker (or to a context
+ *   that replaced the one it originally connected to) can still resume its session.
+ * - Client side, the key is the peer address. Each client context has its own instance holding
+ *   the last session it got from each peer, to offer on the next connection to that peer.
+ * The cache is split into shards, each with its own lock and LRU list, so concurrent handshakes on
+ * different workers rarely contend on the same lock.
+ */
+class SessionCache {
+public:
+  /**
+   * @param capacity supplies the maximum number of sessions held across all shards.
+   */
+  explicit SessionCache(size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Insert a session, evicting the least recently used session of its shard if the shard is full.
+   * An existing session with the same key is replaced.
+   * @param id supplies the session ID or peer address.
+   * @param session supplies the session.
+   */
+  void insert(const std::string& id, bssl::UniquePtr<SSL_SESSION> session);
+
+  /**
+   * @param id supplies the session ID or peer address.
+   * @return a new reference to the cached session, or nullptr if there is none.
+   */
+  bssl::UniquePtr<SSL_SESSION> lookup(const std::string& id);
+
+  /**
+   * Remove a session, e.g. because BoringSSL found it to be invalid or expired.
+   * @param id supplies the session ID or peer address.
+   */
+  void remove(const std::string& id);
+
+  /**
+   * @return the number of cached sessions.
+   */
+  size_t size() const;
+
+  // Same as the size of BoringSSL's internal session cache.
+  static const size_t DEFAULT_CAPACITY = 20 * 1024;
+  static const size_t NUM_SHARDS = 16;
+
+private:
+  struct Shard {
+    typedef std::list<std::pair<std::string, bssl::UniquePtr<SSL_SESSION>>> LruList;
+
+    mutable std::mutex lock_;
+    // Most recently used session first.
+    LruList lru_;
+    std::unordered_map<std::string, LruList::iterator> map_;
+  };
+
+  Shard& shardFor(const std::string& id);
+
+  const size_t shard_capacity_;
+  std::array<Shard, NUM_SHARDS> shards_;
+};
+
+} // namespace Ssl
+} // namespace Envoy
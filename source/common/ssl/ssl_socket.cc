@@ -1,8 +1,15 @@
 #include "common/ssl/ssl_socket.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+
 #include "common/common/assert.h"
 #include "common/common/empty_string.h"
 #include "common/common/hex.h"
+#include "common/common/utility.h"
 
 #include "openssl/err.h"
 #include "openssl/x509v3.h"
@@ -12,14 +19,48 @@ using Envoy::Network::PostIoAction;
 namespace Envoy {
 namespace Ssl {
 
+namespace {
+// The largest amount of plaintext a TLS record can carry.
+const uint64_t MaxRecordSize = 16384;
+// With dynamic record sizing, records start small enough for a record to fit in a single TCP
+// segment, so the peer can decrypt data as soon as each segment arrives while the congestion
+// window is small. Once this many bytes have been written without the connection going idle for
+// longer than the idle timeout, full-size records are used to minimize framing overhead.
+// - SmallRecordSize: a 1500 byte Ethernet MTU leaves about 1430 bytes of TCP payload once IPv6,
+//   TCP and common TCP option headers are taken off, and a record adds up to about 30 bytes of
+//   header, MAC and padding to its plaintext.
+// - RecordSizeBoostThreshold: with a 10 segment initial congestion window, slow start has grown
+//   the window past 1MB after about 7 round trips, by which time the peer is receiving several
+//   full-size records per round trip anyway.
+// - RecordSizeIdleTimeout: the initial TCP retransmission timeout (RFC 6298). Senders that reset
+//   their congestion window after an idle period, as Linux does by default, do so after an idle
+//   period of one retransmission timeout, so the connection starts with a small window again.
+const uint64_t SmallRecordSize = 1400;
+const uint64_t RecordSizeBoostThreshold = 1024 * 1024;
+const std::chrono::milliseconds RecordSizeIdleTimeout(1000);
+} // namespace
+
 SslSocket::SslSocket(Context& ctx, InitialState state)
-    : ctx_(dynamic_cast<Ssl::ContextImpl&>(ctx)), ssl_(ctx_.newSsl()) {
+    : ctx_(dynamic_cast<Ssl::ContextImpl&>(ctx)),
+      client_ctx_(state == InitialState::Client ? dynamic_cast<ClientContextImpl*>(&ctx_)
+                                                : nullptr),
+      ssl_(ctx_.newSsl()),
+      dynamic_record_sizing_(ctx_.dynamicRecordSizing()) {
   SSL_set_mode(ssl_.get(), SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
   if (state == InitialState::Client) {
     SSL_set_connect_state(ssl_.get());
   } else {
     ASSERT(state == InitialState::Server);
     SSL_set_accept_state(ssl_.get());
+    if (ctx_.asyncPrivateKeyOperations()) {
+      ContextImpl::setPrivateKeyOperationCallbacks(ssl_.get(), *this);
+    }
+  }
+}
+
+SslSocket::~SslSocket() {
+  if (pending_private_key_operation_ != nullptr) {
+    pending_private_key_operation_->socket_ = nullptr;
   }
 }
 
@@ -29,6 +70,10 @@ void SslSocket::setTransportSocketCallbacks(Network::TransportSocketCallbacks& c
 
   BIO* bio = BIO_new_socket(callbacks_->fd(), 0);
   SSL_set_bio(ssl_.get(), bio, bio);
+
+  if (client_ctx_ != nullptr) {
+    client_ctx_->resumeSession(ssl_.get(), callbacks_->connection().remoteAddress()->asString());
+  }
 }
 
 Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
@@ -104,14 +149,83 @@ PostIoAction SslSocket::doHandshake() {
     switch (err) {
     case SSL_ERROR_WANT_READ:
     case SSL_ERROR_WANT_WRITE:
+    // The handshake is resumed when the private key operation completes, see
+    // onPrivateKeyOperationComplete().
+    case SSL_ERROR_WANT_PRIVATE_KEY_OPERATION:
       return PostIoAction::KeepOpen;
     default:
       drainErrorQueue();
+      if (client_ctx_ != nullptr) {
+        // Don't offer a session again that the peer may have failed the handshake for.
+        client_ctx_->removeSession(callbacks_->connection().remoteAddress()->asString());
+      }
       return PostIoAction::Close;
     }
   }
 }
 
+ssl_private_key_result_t SslSocket::startPrivateKeyOperation(Operation operation, uint8_t* out,
+                                                             size_t* out_len, size_t max_out) {
+  ASSERT(pending_private_key_operation_ == nullptr);
+  PendingPrivateKeyOperationSharedPtr pending = std::make_shared<PendingPrivateKeyOperation>(*this);
+  Event::Dispatcher& dispatcher = callbacks_->connection().dispatcher();
+  const bool posted = ctx_.cryptoThreadPool().post([pending, operation, &dispatcher]() -> void {
+    pending->succeeded_ = operation(pending->output_);
+    dispatcher.post([pending]() -> void {
+      pending->done_ = true;
+      if (pending->socket_ != nullptr) {
+        pending->socket_->onPrivateKeyOperationComplete();
+      }
+    });
+  });
+
+  if (!posted) {
+    // All crypto threads are busy and enough handshakes are already waiting for them.
+    ctx_.stats().private_key_op_inline_.inc();
+    std::vector<uint8_t> output;
+    if (!operation(output)) {
+      return ssl_private_key_failure;
+    }
+    return copyPrivateKeyOperationOutput(output, out, out_len, max_out);
+  }
+
+  ENVOY_CONN_LOG(debug, "private key operation offloaded", callbacks_->connection());
+  ctx_.stats().private_key_op_offloaded_.inc();
+  pending_private_key_operation_ = pending;
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t SslSocket::completePrivateKeyOperation(uint8_t* out, size_t* out_len,
+                                                                size_t max_out) {
+  ASSERT(pending_private_key_operation_ != nullptr);
+  if (!pending_private_key_operation_->done_) {
+    return ssl_private_key_retry;
+  }
+
+  PendingPrivateKeyOperationSharedPtr pending = std::move(pending_private_key_operation_);
+  if (!pending->succeeded_) {
+    return ssl_private_key_failure;
+  }
+  return copyPrivateKeyOperationOutput(pending->output_, out, out_len, max_out);
+}
+
+ssl_private_key_result_t
+SslSocket::copyPrivateKeyOperationOutput(const std::vector<uint8_t>& output, uint8_t* out,
+                                         size_t* out_len, size_t max_out) {
+  if (output.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(output.begin(), output.end(), out);
+  *out_len = output.size();
+  return ssl_private_key_success;
+}
+
+void SslSocket::onPrivateKeyOperationComplete() {
+  ENVOY_CONN_LOG(debug, "private key operation complete", callbacks_->connection());
+  // Retry the handshake from the connection's read path, which handles closing on failure.
+  callbacks_->setReadBufferReady();
+}
+
 void SslSocket::drainErrorQueue() {
   bool saw_error = false;
   bool saw_counted_error = false;
@@ -144,57 +258,75 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer) {
     }
   }
 
+  if (dynamic_record_sizing_) {
+    const MonotonicTime now = ProdMonotonicTimeSource::instance_.currentTime();
+    if (now - last_write_time_ > RecordSizeIdleTimeout) {
+      bytes_since_idle_ = 0;
+    }
+    last_write_time_ = now;
+  }
+
   uint64_t original_buffer_length = write_buffer.length();
   uint64_t total_bytes_written = 0;
-  bool keep_writing = true;
-  while ((original_buffer_length != total_bytes_written) && keep_writing) {
-    // Protect against stack overflow if the buffer has a very large buffer chain.
-    // TODO(mattklein123): See the comment on getRawSlices() for why we have to also check
-    // original_buffer_length != total_bytes_written during loop iteration.
-    // TODO(mattklein123): As it relates to our fairness efforts, we might want to limit the number
-    // of iterations of this loop, either by pure iterations, bytes written, etc.
-    const uint64_t MAX_SLICES = 32;
-    Buffer::RawSlice slices[MAX_SLICES];
-    uint64_t num_slices = write_buffer.getRawSlices(slices, MAX_SLICES);
-
-    uint64_t inner_bytes_written = 0;
-    for (uint64_t i = 0; (i < num_slices) && (original_buffer_length != total_bytes_written); i++) {
-      // SSL_write() requires that if a previous call returns SSL_ERROR_WANT_WRITE, we need to call
-      // it again with the same parameters. Most implementations keep track of the last write size.
-      // In our case we don't need to do that because: a) SSL_write() will not write partial
-      // buffers. b) We only move() into the write buffer, which means that it's impossible for a
-      // particular chain to increase in size. So as long as we start writing where we left off we
-      // are guaranteed to call SSL_write() with the same parameters.
-      int rc = SSL_write(ssl_.get(), slices[i].mem_, slices[i].len_);
-      ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
-      if (rc > 0) {
-        inner_bytes_written += rc;
-        total_bytes_written += rc;
-      } else {
-        int err = SSL_get_error(ssl_.get(), rc);
-        switch (err) {
-        case SSL_ERROR_WANT_WRITE:
-          keep_writing = false;
-          break;
-        case SSL_ERROR_WANT_READ:
-          // Renegotiation has started. We don't handle renegotiation so just fall through.
-        default:
-          drainErrorQueue();
-          return {PostIoAction::Close, total_bytes_written};
-        }
-
+  uint64_t records_written = 0;
+  PostIoAction action = PostIoAction::KeepOpen;
+  // TODO(mattklein123): As it relates to our fairness efforts, we might want to limit the number
+  // of iterations of this loop, either by pure iterations, bytes written, etc.
+  while (original_buffer_length != total_bytes_written) {
+    // Gather the front of the buffer into a single record rather than writing a record per slice,
+    // as codecs tend to produce many small slices and every record costs a MAC, padding and
+    // usually a separate write() to the socket. linearize() only copies if the front slice is
+    // shorter than the record.
+    //
+    // SSL_write() requires that if a previous call returns SSL_ERROR_WANT_WRITE, we need to call
+    // it again with the same length. SSL_write() does not write partial records and the buffer is
+    // only drained after a successful write, so the same bytes are still at the front of the
+    // buffer. They may have moved, which SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER allows.
+    const uint64_t bytes_to_write =
+        bytes_to_retry_ > 0
+            ? bytes_to_retry_
+            : std::min(original_buffer_length - total_bytes_written, recordSize());
+    ASSERT(bytes_to_write <= write_buffer.length());
+    int rc = SSL_write(ssl_.get(), write_buffer.linearize(bytes_to_write), bytes_to_write);
+    ENVOY_CONN_LOG(trace, "ssl write returns: {}", callbacks_->connection(), rc);
+    if (rc > 0) {
+      ASSERT(static_cast<uint64_t>(rc) == bytes_to_write);
+      bytes_to_retry_ = 0;
+      write_buffer.drain(rc);
+      total_bytes_written += rc;
+      bytes_since_idle_ += rc;
+      records_written++;
+    } else {
+      int err = SSL_get_error(ssl_.get(), rc);
+      switch (err) {
+      case SSL_ERROR_WANT_WRITE:
+        bytes_to_retry_ = bytes_to_write;
+        break;
+      case SSL_ERROR_WANT_READ:
+        // Renegotiation has started. We don't handle renegotiation so just fall through.
+      default:
+        drainErrorQueue();
+        action = PostIoAction::Close;
         break;
       }
-    }
 
-    // Draining must be done within the inner loop, otherwise we will keep getting the same slices
-    // at the beginning of the buffer.
-    if (inner_bytes_written > 0) {
-      write_buffer.drain(inner_bytes_written);
+      break;
     }
   }
 
-  return {PostIoAction::KeepOpen, total_bytes_written};
+  if (records_written > 0) {
+    ctx_.stats().record_written_.add(records_written);
+    ctx_.stats().write_calls_.inc();
+  }
+
+  return {action, total_bytes_written};
+}
+
+uint64_t SslSocket::recordSize() const {
+  if (!dynamic_record_sizing_ || bytes_since_idle_ >= RecordSizeBoostThreshold) {
+    return MaxRecordSize;
+  }
+  return SmallRecordSize;
 }
 
 void SslSocket::onConnected() { ASSERT(!handshake_complete_); }
@@ -283,6 +415,11 @@ std::string SslSocket::getUriSanFromCertificate(X509* cert) {
 }
 
 void SslSocket::closeSocket(Network::ConnectionEvent) {
+  if (pending_private_key_operation_ != nullptr) {
+    // The connection stops handling events once it is closed, so the result is of no use anymore.
+    pending_private_key_operation_->socket_ = nullptr;
+  }
+
   if (handshake_complete_ &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
     // Attempt to send a shutdown before closing the socket. It's possible this won't go out if
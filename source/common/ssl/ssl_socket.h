@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "envoy/common/time.h"
 #include "envoy/network/transport_socket.h"
 
 #include "common/common/logger.h"
@@ -17,9 +20,11 @@ enum class InitialState { Client, Server };
 
 class SslSocket : public Network::TransportSocket,
                   public Connection,
+                  public PrivateKeyOperationCallbacks,
                   protected Logger::Loggable<Logger::Id::connection> {
 public:
   SslSocket(Context& ctx, InitialState state);
+  ~SslSocket();
 
   // Ssl::Connection
   bool peerCertificatePresented() const override;
@@ -37,17 +42,51 @@ public:
   Network::IoResult doWrite(Buffer::Instance& write_buffer) override;
   void onConnected() override;
 
+  // Ssl::PrivateKeyOperationCallbacks
+  ssl_private_key_result_t startPrivateKeyOperation(Operation operation, uint8_t* out,
+                                                    size_t* out_len, size_t max_out) override;
+  ssl_private_key_result_t completePrivateKeyOperation(uint8_t* out, size_t* out_len,
+                                                       size_t max_out) override;
+
   SSL* rawSslForTest() { return ssl_.get(); }
 
 private:
+  // A private key operation running on the crypto thread pool. It is shared with the pool, so it
+  // stays valid if the connection is closed while the operation runs.
+  struct PendingPrivateKeyOperation {
+    PendingPrivateKeyOperation(SslSocket& socket) : socket_(&socket) {}
+
+    // Cleared when the socket is closed or destroyed. Only accessed on the worker thread.
+    SslSocket* socket_;
+    bool done_{};
+    bool succeeded_{};
+    std::vector<uint8_t> output_;
+  };
+  typedef std::shared_ptr<PendingPrivateKeyOperation> PendingPrivateKeyOperationSharedPtr;
+
+  static ssl_private_key_result_t copyPrivateKeyOperationOutput(const std::vector<uint8_t>& output,
+                                                                uint8_t* out, size_t* out_len,
+                                                                size_t max_out);
+  void onPrivateKeyOperationComplete();
   Network::PostIoAction doHandshake();
+  uint64_t recordSize() const;
   void drainErrorQueue();
   std::string getUriSanFromCertificate(X509* cert);
 
   Network::TransportSocketCallbacks* callbacks_{};
   ContextImpl& ctx_;
+  // Set for client connections, which resume sessions with their peer.
+  ClientContextImpl* const client_ctx_;
   bssl::UniquePtr<SSL> ssl_;
   bool handshake_complete_{};
+  // Set when SSL_write() returned SSL_ERROR_WANT_WRITE. The write must be retried with the same
+  // length, and the data is still at the front of the write buffer.
+  uint64_t bytes_to_retry_{};
+  const bool dynamic_record_sizing_;
+  // Bytes written since the connection was last idle, used for dynamic record sizing.
+  uint64_t bytes_since_idle_{};
+  MonotonicTime last_write_time_;
+  PendingPrivateKeyOperationSharedPtr pending_private_key_operation_;
 };
 
 } // namespace Ssl
@@ -0,0 +1,89 @@
+#include "common/upstream/alias_table.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "common/common/assert.h"
+
+namespace Envoy {
+namespace Upstream {
+
+bool AliasTable::rebuild(const std::vector<uint64_t>& weights) {
+  if (weights == weights_) {
+    return false;
+  }
+
+  weights_ = weights;
+  entries_.clear();
+  total_weight_ = 0;
+
+  const uint64_t size = weights.size();
+  if (size == 0) {
+    return true;
+  }
+
+  // Scale the weights down until their sum fits in 32 bits. This keeps the scaled bucket weights
+  // below from overflowing, and lets pick() draw both the bucket and the coin toss from a single
+  // 64 bit random number with negligible bias. Non-zero weights are never scaled down to zero.
+  const uint64_t max_weight = *std::max_element(weights.begin(), weights.end());
+  uint32_t shift = 0;
+  while ((max_weight >> shift) > (UINT32_MAX / size)) {
+    shift++;
+  }
+
+  std::vector<uint64_t> scaled_weights(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    scaled_weights[i] = weights[i] > 0 ? std::max<uint64_t>(weights[i] >> shift, 1) : 0;
+    total_weight_ += scaled_weights[i];
+  }
+  if (total_weight_ == 0) {
+    return true;
+  }
+
+  // Each bucket covers total_weight_. Indexes whose scaled weight is below that fill the rest of
+  // their bucket with the remainder of an index whose scaled weight is above it.
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint64_t i = 0; i < size; ++i) {
+    scaled_weights[i] *= size;
+    if (scaled_weights[i] < total_weight_) {
+      small.push_back(i);
+    } else {
+      large.push_back(i);
+    }
+  }
+
+  entries_.resize(size);
+  while (!small.empty() && !large.empty()) {
+    const uint32_t less = small.back();
+    small.pop_back();
+    const uint32_t more = large.back();
+    entries_[less] = {scaled_weights[less], more};
+    scaled_weights[more] -= total_weight_ - scaled_weights[less];
+    if (scaled_weights[more] < total_weight_) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // Integer arithmetic is exact, so whatever is left fills its own bucket completely.
+  for (uint32_t i : large) {
+    entries_[i] = {total_weight_, i};
+  }
+  for (uint32_t i : small) {
+    entries_[i] = {total_weight_, i};
+  }
+
+  return true;
+}
+
+uint32_t AliasTable::pick(uint64_t random) const {
+  ASSERT(!empty());
+  const uint64_t index = random % entries_.size();
+  const Entry& entry = entries_[index];
+  return (random / entries_.size()) % total_weight_ < entry.threshold_ ? index : entry.alias_;
+}
+
+} // namespace Upstream
+} // namespace Envoy
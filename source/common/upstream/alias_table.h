@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Weighted random selection in O(1) per pick using Vose's alias method. Building the table is
+ * O(N) in the number of weights, so it is meant to be rebuilt only when the weights change.
+ */
+class AliasTable {
+public:
+  /**
+   * Rebuild the table for a new set of weights. This is a no-op if the weights have not changed
+   * since the last rebuild.
+   * @param weights supplies the weight of each index. Indexes with a zero weight are never picked.
+   * @return true if the table was rebuilt.
+   */
+  bool rebuild(const std::vector<uint64_t>& weights);
+
+  /**
+   * @return true if there is nothing to pick from, i.e. there are no weights or all weights are 0.
+   */
+  bool empty() const { return entries_.empty(); }
+
+  /**
+   * Pick an index with a probability proportional to its weight. The table must not be empty.
+   * @param random supplies a uniformly distributed random number.
+   * @return the picked index.
+   */
+  uint32_t pick(uint64_t random) const;
+
+private:
+  struct Entry {
+    // Keep the bucket's own index when the scaled coin toss is below this value, otherwise use
+    // alias_.
+    uint64_t threshold_;
+    uint32_t alias_;
+  };
+
+  std::vector<uint64_t> weights_;
+  std::vector<Entry> entries_;
+  // The sum of the (possibly scaled down) weights. Every bucket covers exactly this much weight.
+  uint64_t total_weight_{};
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -1,10 +1,14 @@
 #include "common/upstream/cluster_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "envoy/event/dispatcher.h"
@@ -168,8 +172,9 @@ ClusterManagerImpl::ClusterManagerImpl(const envoy::api::v2::Bootstrap& bootstra
                                        const LocalInfo::LocalInfo& local_info,
                                        AccessLog::AccessLogManager& log_manager,
                                        Event::Dispatcher& primary_dispatcher)
-    : factory_(factory), runtime_(runtime), stats_(stats), tls_(tls.allocateSlot()),
-      random_(random), local_info_(local_info), cm_stats_(generateStats(stats)),
+    : factory_(factory), primary_dispatcher_(primary_dispatcher), runtime_(runtime), stats_(stats),
+      tls_(tls.allocateSlot()), random_(random), local_info_(local_info),
+      cm_stats_(generateStats(stats)),
       init_helper_([this](Cluster& cluster) { onClusterInit(cluster); }) {
   const auto& ads_config = bootstrap.dynamic_resources().ads_config();
   if (ads_config.cluster_name().empty()) {
@@ -307,6 +312,10 @@ bool ClusterManagerImpl::addOrUpdatePrimaryCluster(const envoy::api::v2::Cluster
     return false;
   }
 
+  // Pending updates refer to the cluster being replaced and must reach the workers before it is
+  // gone.
+  postPendingThreadLocalUpdates();
+
   if (existing_cluster != primary_clusters_.end()) {
     init_helper_.removeCluster(*existing_cluster->second.cluster_);
   }
@@ -344,6 +353,9 @@ bool ClusterManagerImpl::removePrimaryCluster(const std::string& cluster_name) {
     return false;
   }
 
+  // As above, pending updates for the removed cluster must reach the workers first.
+  postPendingThreadLocalUpdates();
+
   init_helper_.removeCluster(*existing_cluster->second.cluster_);
   primary_clusters_.erase(existing_cluster);
   cm_stats_.cluster_removed_.inc();
@@ -443,31 +455,131 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(
     const Cluster& primary_cluster, uint32_t priority,
     const std::vector<HostSharedPtr>& hosts_added,
     const std::vector<HostSharedPtr>& hosts_removed) {
-  const auto& host_set = primary_cluster.prioritySet().hostSetsPerPriority()[priority];
+  auto window_entry = host_set_update_window_.emplace(std::make_pair(&primary_cluster, priority),
+                                                      PendingHostSetUpdate{});
+  if (window_entry.second) {
+    // The first update to a host set since the last batch goes out right away, so that the thread
+    // local views (including the main thread's) are current at startup and after a quiet period.
+    postThreadLocalHostSetUpdates({snapshotHostSet(primary_cluster, priority, hosts_added,
+                                                   hosts_removed)},
+                                  {});
+    schedulePendingThreadLocalUpdates();
+    return;
+  }
 
-  HostVectorConstSharedPtr hosts_copy(new std::vector<HostSharedPtr>(host_set->hosts()));
-  HostVectorConstSharedPtr healthy_hosts_copy(
-      new std::vector<HostSharedPtr>(host_set->healthyHosts()));
-  HostListsConstSharedPtr hosts_per_locality_copy(
-      new std::vector<std::vector<HostSharedPtr>>(host_set->hostsPerLocality()));
-  HostListsConstSharedPtr healthy_hosts_per_locality_copy(
-      new std::vector<std::vector<HostSharedPtr>>(host_set->healthyHostsPerLocality()));
-
-  tls_->runOnAllThreads([
-    this, name = primary_cluster.info()->name(), priority, hosts_copy, healthy_hosts_copy,
-    hosts_per_locality_copy, healthy_hosts_per_locality_copy, hosts_added, hosts_removed
-  ]()
-                            ->void {
-                              ThreadLocalClusterManagerImpl::updateClusterMembership(
-                                  name, priority, hosts_copy, healthy_hosts_copy,
-                                  hosts_per_locality_copy, healthy_hosts_per_locality_copy,
-                                  hosts_added, hosts_removed, *tls_);
-                            });
+  // Further updates are merged and posted as one snapshot once the current event is done.
+  PendingHostSetUpdate& update = window_entry.first->second;
+  cm_stats_.thread_local_update_coalesced_.inc();
+  if (!update.pending_) {
+    update.pending_ = true;
+    cm_stats_.thread_local_update_pending_.inc();
+  }
+
+  if (!update.hosts_added_.empty() && !hosts_removed.empty()) {
+    // A host that is added and then removed again before the workers see it is dropped entirely.
+    std::unordered_set<HostSharedPtr> removed(hosts_removed.begin(), hosts_removed.end());
+    update.hosts_added_.erase(std::remove_if(update.hosts_added_.begin(),
+                                             update.hosts_added_.end(),
+                                             [&removed](const HostSharedPtr& host) -> bool {
+                                               return removed.erase(host) > 0;
+                                             }),
+                              update.hosts_added_.end());
+    for (const HostSharedPtr& host : hosts_removed) {
+      if (removed.count(host) > 0) {
+        update.hosts_removed_.push_back(host);
+      }
+    }
+  } else {
+    update.hosts_removed_.insert(update.hosts_removed_.end(), hosts_removed.begin(),
+                                 hosts_removed.end());
+  }
+  update.hosts_added_.insert(update.hosts_added_.end(), hosts_added.begin(), hosts_added.end());
 }
 
 void ClusterManagerImpl::postThreadLocalHealthFailure(const HostSharedPtr& host) {
-  tls_->runOnAllThreads(
-      [this, host] { ThreadLocalClusterManagerImpl::onHostHealthFailure(host, *tls_); });
+  if (!health_failure_window_.insert(host).second) {
+    // The workers are already closing this host's connections.
+    cm_stats_.thread_local_update_coalesced_.inc();
+    return;
+  }
+
+  postThreadLocalHostSetUpdates({}, {host});
+  schedulePendingThreadLocalUpdates();
+}
+
+ClusterManagerImpl::HostSetUpdate
+ClusterManagerImpl::snapshotHostSet(const Cluster& primary_cluster, uint32_t priority,
+                                    std::vector<HostSharedPtr> hosts_added,
+                                    std::vector<HostSharedPtr> hosts_removed) {
+  const auto& host_set = primary_cluster.prioritySet().hostSetsPerPriority()[priority];
+  return {primary_cluster.info()->name(),
+          priority,
+          std::make_shared<const std::vector<HostSharedPtr>>(host_set->hosts()),
+          std::make_shared<const std::vector<HostSharedPtr>>(host_set->healthyHosts()),
+          std::make_shared<const std::vector<std::vector<HostSharedPtr>>>(
+              host_set->hostsPerLocality()),
+          std::make_shared<const std::vector<std::vector<HostSharedPtr>>>(
+              host_set->healthyHostsPerLocality()),
+          host_set->localityWeights(),
+          std::move(hosts_added),
+          std::move(hosts_removed)};
+}
+
+void ClusterManagerImpl::postThreadLocalHostSetUpdates(
+    std::vector<HostSetUpdate>&& host_set_updates, std::vector<HostSharedPtr>&& health_failures) {
+  cm_stats_.thread_local_update_batch_.inc();
+  std::shared_ptr<const std::vector<HostSetUpdate>> shared_host_set_updates(
+      new std::vector<HostSetUpdate>(std::move(host_set_updates)));
+  std::shared_ptr<const std::vector<HostSharedPtr>> shared_health_failures(
+      new std::vector<HostSharedPtr>(std::move(health_failures)));
+
+  tls_->runOnAllThreads([this, shared_host_set_updates, shared_health_failures]() -> void {
+    for (const HostSetUpdate& update : *shared_host_set_updates) {
+      ThreadLocalClusterManagerImpl::updateClusterMembership(
+          update.cluster_name_, update.priority_, update.hosts_, update.healthy_hosts_,
+          update.hosts_per_locality_, update.healthy_hosts_per_locality_, update.locality_weights_,
+          update.hosts_added_, update.hosts_removed_, *tls_);
+    }
+    for (const HostSharedPtr& host : *shared_health_failures) {
+      ThreadLocalClusterManagerImpl::onHostHealthFailure(host, *tls_);
+    }
+  });
+}
+
+void ClusterManagerImpl::schedulePendingThreadLocalUpdates() {
+  if (pending_updates_scheduled_) {
+    return;
+  }
+
+  // Posting to our own dispatcher runs the batch once the current event has been processed, after
+  // all of the updates it caused have been merged.
+  pending_updates_scheduled_ = true;
+  primary_dispatcher_.post([this]() -> void {
+    pending_updates_scheduled_ = false;
+    postPendingThreadLocalUpdates();
+  });
+}
+
+void ClusterManagerImpl::postPendingThreadLocalUpdates() {
+  // Snapshot the current state of every host set with merged updates. This is the only copy made
+  // no matter how many updates were merged into it.
+  std::vector<HostSetUpdate> host_set_updates;
+  for (auto& window_entry : host_set_update_window_) {
+    PendingHostSetUpdate& update = window_entry.second;
+    if (update.pending_) {
+      host_set_updates.push_back(snapshotHostSet(*window_entry.first.first,
+                                                 window_entry.first.second,
+                                                 std::move(update.hosts_added_),
+                                                 std::move(update.hosts_removed_)));
+    }
+  }
+
+  host_set_update_window_.clear();
+  health_failure_window_.clear();
+  cm_stats_.thread_local_update_pending_.set(0);
+  if (!host_set_updates.empty()) {
+    postThreadLocalHostSetUpdates(std::move(host_set_updates), {});
+  }
 }
 
 Host::CreateConnectionData ClusterManagerImpl::tcpConnForCluster(const std::string& cluster,
@@ -498,6 +610,78 @@ Http::AsyncClient& ClusterManagerImpl::httpAsyncClientForCluster(const std::stri
   }
 }
 
+void ClusterManagerImpl::recordLoadReport(const HostDescriptionConstSharedPtr& host, bool success) {
+  ThreadLocalClusterManagerImpl& cluster_manager = tls_->getTyped<ThreadLocalClusterManagerImpl>();
+  if (cluster_manager.load_reports_.empty()) {
+    return;
+  }
+
+  auto entry = cluster_manager.load_reports_.find(host->cluster().name());
+  if (entry == cluster_manager.load_reports_.end()) {
+    return;
+  }
+
+  HostLoadReport& load_report = entry->second[host];
+  if (success) {
+    load_report.rq_success_++;
+  } else {
+    load_report.rq_error_++;
+  }
+}
+
+void ClusterManagerImpl::harvestLoadReports(const std::vector<std::string>& clusters,
+                                            LoadReportsCb cb) {
+  struct Harvest {
+    std::mutex lock_;
+    HostLoadReportMap load_reports_;
+  };
+
+  std::shared_ptr<const std::vector<std::string>> shared_clusters(
+      new std::vector<std::string>(clusters));
+  std::shared_ptr<Harvest> harvest(new Harvest());
+  tls_->runOnAllThreads(
+      [this, shared_clusters, harvest]() -> void {
+        std::unordered_map<std::string, HostLoadReportMap> load_reports;
+        for (const std::string& cluster : *shared_clusters) {
+          load_reports[cluster];
+        }
+        load_reports.swap(tls_->getTyped<ThreadLocalClusterManagerImpl>().load_reports_);
+
+        std::unique_lock<std::mutex> lock(harvest->lock_);
+        for (const auto& cluster_load_reports : load_reports) {
+          for (const auto& host_load_report : cluster_load_reports.second) {
+            HostLoadReport& load_report = harvest->load_reports_[host_load_report.first];
+            load_report.rq_success_ += host_load_report.second.rq_success_;
+            load_report.rq_error_ += host_load_report.second.rq_error_;
+          }
+        }
+      },
+      [harvest, cb]() -> void {
+        // Every thread has handed its reports over by now, so the lock is no longer needed.
+        cb(std::move(harvest->load_reports_));
+      });
+}
+
+void ClusterManagerImpl::updateLoadReportClusters(const std::vector<std::string>& clusters) {
+  std::shared_ptr<const std::vector<std::string>> shared_clusters(
+      new std::vector<std::string>(clusters));
+  tls_->runOnAllThreads([this, shared_clusters]() -> void {
+    std::unordered_map<std::string, HostLoadReportMap>& load_reports =
+        tls_->getTyped<ThreadLocalClusterManagerImpl>().load_reports_;
+    std::unordered_map<std::string, HostLoadReportMap> updated_load_reports;
+    for (const std::string& cluster : *shared_clusters) {
+      // Reports accumulated for a cluster that is still tracked are kept for the next harvest.
+      auto entry = load_reports.find(cluster);
+      if (entry != load_reports.end()) {
+        updated_load_reports[cluster] = std::move(entry->second);
+      } else {
+        updated_load_reports[cluster];
+      }
+    }
+    load_reports.swap(updated_load_reports);
+  });
+}
+
 const std::string ClusterManagerImpl::versionInfo() const {
   if (cds_api_) {
     return cds_api_->versionInfo();
@@ -599,6 +783,7 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
     const std::string& name, uint32_t priority, HostVectorConstSharedPtr hosts,
     HostVectorConstSharedPtr healthy_hosts, HostListsConstSharedPtr hosts_per_locality,
     HostListsConstSharedPtr healthy_hosts_per_locality,
+    HostSet::LocalityWeightsConstSharedPtr locality_weights,
     const std::vector<HostSharedPtr>& hosts_added, const std::vector<HostSharedPtr>& hosts_removed,
     ThreadLocal::Slot& tls) {
 
@@ -609,7 +794,8 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
   ENVOY_LOG(debug, "membership update for TLS cluster {}", name);
   cluster_entry->priority_set_.getOrCreateHostSet(priority).updateHosts(
       std::move(hosts), std::move(healthy_hosts), std::move(hosts_per_locality),
-      std::move(healthy_hosts_per_locality), hosts_added, hosts_removed);
+      std::move(healthy_hosts_per_locality), std::move(locality_weights), hosts_added,
+      hosts_removed);
 
   // If an LB is thread aware, create a new worker local LB on membership changes.
   if (cluster_entry->lb_factory_ != nullptr) {
@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "envoy/http/codes.h"
@@ -129,6 +131,9 @@ private:
   COUNTER(cluster_added)                                                                           \
   COUNTER(cluster_modified)                                                                        \
   COUNTER(cluster_removed)                                                                         \
+  COUNTER(thread_local_update_batch)                                                               \
+  COUNTER(thread_local_update_coalesced)                                                           \
+  GAUGE  (thread_local_update_pending)                                                             \
   GAUGE  (total_clusters)
 // clang-format on
 
@@ -171,6 +176,9 @@ public:
   Host::CreateConnectionData tcpConnForCluster(const std::string& cluster,
                                                LoadBalancerContext* context) override;
   Http::AsyncClient& httpAsyncClientForCluster(const std::string& cluster) override;
+  void recordLoadReport(const HostDescriptionConstSharedPtr& host, bool success) override;
+  void harvestLoadReports(const std::vector<std::string>& clusters, LoadReportsCb cb) override;
+  void updateLoadReportClusters(const std::vector<std::string>& clusters) override;
   bool removePrimaryCluster(const std::string& cluster) override;
   void shutdown() override {
     cds_api_.reset();
@@ -237,6 +245,7 @@ private:
                                         HostVectorConstSharedPtr healthy_hosts,
                                         HostListsConstSharedPtr hosts_per_locality,
                                         HostListsConstSharedPtr healthy_hosts_per_locality,
+                                        HostSet::LocalityWeightsConstSharedPtr locality_weights,
                                         const std::vector<HostSharedPtr>& hosts_added,
                                         const std::vector<HostSharedPtr>& hosts_removed,
                                         ThreadLocal::Slot& tls);
@@ -247,6 +256,9 @@ private:
     std::unordered_map<std::string, ClusterEntryPtr> thread_local_clusters_;
     std::unordered_map<HostConstSharedPtr, ConnPoolsContainer> host_http_conn_pool_map_;
     const PrioritySet* local_priority_set_{};
+    // Load reports accumulated on this thread by cluster name. Only the clusters that are being
+    // reported on have an entry.
+    std::unordered_map<std::string, HostLoadReportMap> load_reports_;
   };
 
   struct PrimaryClusterData {
@@ -268,6 +280,32 @@ private:
     ThreadAwareLoadBalancerPtr thread_aware_lb_;
   };
 
+  /**
+   * Host set membership changes for a cluster priority that were merged after its first update in
+   * the current batch window. The hosts themselves are snapshotted when the batch is posted.
+   */
+  struct PendingHostSetUpdate {
+    std::vector<HostSharedPtr> hosts_added_;
+    std::vector<HostSharedPtr> hosts_removed_;
+    // Whether anything was merged, i.e. whether the batch has to post this host set again.
+    bool pending_{};
+  };
+
+  /**
+   * A snapshot of a cluster's host set at one priority, as applied by every worker.
+   */
+  struct HostSetUpdate {
+    std::string cluster_name_;
+    uint32_t priority_;
+    HostVectorConstSharedPtr hosts_;
+    HostVectorConstSharedPtr healthy_hosts_;
+    HostListsConstSharedPtr hosts_per_locality_;
+    HostListsConstSharedPtr healthy_hosts_per_locality_;
+    HostSet::LocalityWeightsConstSharedPtr locality_weights_;
+    std::vector<HostSharedPtr> hosts_added_;
+    std::vector<HostSharedPtr> hosts_removed_;
+  };
+
   static ClusterManagerStats generateStats(Stats::Scope& scope);
   void loadCluster(const envoy::api::v2::Cluster& cluster, bool added_via_api);
   void onClusterInit(Cluster& cluster);
@@ -275,8 +313,16 @@ private:
                                     const std::vector<HostSharedPtr>& hosts_added,
                                     const std::vector<HostSharedPtr>& hosts_removed);
   void postThreadLocalHealthFailure(const HostSharedPtr& host);
+  HostSetUpdate snapshotHostSet(const Cluster& cluster, uint32_t priority,
+                                std::vector<HostSharedPtr> hosts_added,
+                                std::vector<HostSharedPtr> hosts_removed);
+  void postThreadLocalHostSetUpdates(std::vector<HostSetUpdate>&& host_set_updates,
+                                     std::vector<HostSharedPtr>&& health_failures);
+  void schedulePendingThreadLocalUpdates();
+  void postPendingThreadLocalUpdates();
 
   ClusterManagerFactory& factory_;
+  Event::Dispatcher& primary_dispatcher_;
   Runtime::Loader& runtime_;
   Stats::Store& stats_;
   ThreadLocal::SlotPtr tls_;
@@ -293,6 +339,13 @@ private:
   LoadStatsReporterPtr load_stats_reporter_;
   // The name of the local cluster of this Envoy instance if defined, else the empty string.
   std::string local_cluster_name_;
+  // The first cross-thread update to a cluster priority (or health failure of a host) is posted
+  // right away. Until the main thread is done with its current event, further updates to the same
+  // cluster priority are merged and reach the workers as a single snapshot, and further failures
+  // of the same host are dropped.
+  std::map<std::pair<const Cluster*, uint32_t>, PendingHostSetUpdate> host_set_update_window_;
+  std::unordered_set<HostSharedPtr> health_failure_window_;
+  bool pending_updates_scheduled_{};
 };
 
 } // namespace Upstream
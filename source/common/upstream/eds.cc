@@ -18,6 +18,9 @@
 namespace Envoy {
 namespace Upstream {
 
+// The weight of a locality without one when others in the same priority have one.
+static const uint32_t DefaultLocalityWeight = 1;
+
 EdsClusterImpl::EdsClusterImpl(const envoy::api::v2::Cluster& cluster, Runtime::Loader& runtime,
                                Stats::Store& stats, Ssl::ContextManager& ssl_context_manager,
                                const LocalInfo::LocalInfo& local_info, ClusterManager& cm,
@@ -28,7 +31,9 @@ EdsClusterImpl::EdsClusterImpl(const envoy::api::v2::Cluster& cluster, Runtime::
       cm_(cm), local_info_(local_info),
       cluster_name_(cluster.eds_cluster_config().service_name().empty()
                         ? cluster.name()
-                        : cluster.eds_cluster_config().service_name()) {
+                        : cluster.eds_cluster_config().service_name()),
+      locality_weighted_lb_runtime_key_(
+          fmt::format("upstream.locality_weighted_lb.{}", cluster.name())) {
   Config::Utility::checkLocalInfo("eds", local_info);
   const auto& eds_config = cluster.eds_cluster_config().eds_config();
   subscription_ = Config::SubscriptionFactory::subscriptionFromConfigSource<
@@ -47,6 +52,7 @@ void EdsClusterImpl::startPreInit() { subscription_->start({cluster_name_}, *thi
 void EdsClusterImpl::onConfigUpdate(const ResourceVector& resources) {
   typedef std::unique_ptr<std::vector<HostSharedPtr>> HostListPtr;
   std::vector<HostListPtr> new_hosts(1);
+  std::vector<LocalityWeightsMap> new_locality_weights_map(1);
   if (resources.empty()) {
     ENVOY_LOG(debug, "Missing ClusterLoadAssignment for {} in onConfigUpdate()", cluster_name_);
     info_->stats().update_empty_.inc();
@@ -63,6 +69,10 @@ void EdsClusterImpl::onConfigUpdate(const ResourceVector& resources) {
     throw EnvoyException(fmt::format("Unexpected EDS cluster (expecting {}): {}", cluster_name_,
                                      cluster_load_assignment.cluster_name()));
   }
+  // Locality weights take precedence over zone aware routing, so they are only used when the
+  // cluster opts in.
+  const bool locality_weighted_lb =
+      runtime_.snapshot().featureEnabled(locality_weighted_lb_runtime_key_, 0);
   for (const auto& locality_lb_endpoint : cluster_load_assignment.endpoints()) {
     const uint32_t priority = locality_lb_endpoint.priority();
     if (priority > 0 && !cluster_name_.empty() && cluster_name_ == cm_.localClusterName()) {
@@ -71,10 +81,15 @@ void EdsClusterImpl::onConfigUpdate(const ResourceVector& resources) {
     }
     if (new_hosts.size() <= priority) {
       new_hosts.resize(priority + 1);
+      new_locality_weights_map.resize(priority + 1);
     }
     if (new_hosts[priority] == nullptr) {
       new_hosts[priority] = HostListPtr{new std::vector<HostSharedPtr>};
     }
+    if (locality_weighted_lb && locality_lb_endpoint.has_load_balancing_weight()) {
+      new_locality_weights_map[priority][Locality(locality_lb_endpoint.locality())] =
+          locality_lb_endpoint.load_balancing_weight().value();
+    }
     for (const auto& lb_endpoint : locality_lb_endpoint.lb_endpoints()) {
       new_hosts[priority]->emplace_back(new HostImpl(
           info_, "", Network::Address::resolveProtoAddress(lb_endpoint.endpoint().address()),
@@ -85,7 +100,8 @@ void EdsClusterImpl::onConfigUpdate(const ResourceVector& resources) {
 
   for (size_t i = 0; i < new_hosts.size(); ++i) {
     if (new_hosts[i] != nullptr) {
-      updateHostsPerLocality(priority_set_.getOrCreateHostSet(i), *new_hosts[i]);
+      updateHostsPerLocality(priority_set_.getOrCreateHostSet(i), *new_hosts[i],
+                             new_locality_weights_map[i]);
     }
   }
 
@@ -95,42 +111,68 @@ void EdsClusterImpl::onConfigUpdate(const ResourceVector& resources) {
 }
 
 void EdsClusterImpl::updateHostsPerLocality(HostSet& host_set,
-                                            std::vector<HostSharedPtr>& new_hosts) {
+                                            std::vector<HostSharedPtr>& new_hosts,
+                                            LocalityWeightsMap& new_locality_weights_map) {
   HostVectorSharedPtr current_hosts_copy(new std::vector<HostSharedPtr>(host_set.hosts()));
 
+  if (locality_weights_map_.size() <= host_set.priority()) {
+    locality_weights_map_.resize(host_set.priority() + 1);
+  }
+  LocalityWeightsMap& locality_weights_map = locality_weights_map_[host_set.priority()];
+
   std::vector<HostSharedPtr> hosts_added;
   std::vector<HostSharedPtr> hosts_removed;
-  if (updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added, hosts_removed,
-                            health_checker_ != nullptr)) {
-    ENVOY_LOG(debug, "EDS hosts changed for cluster: {} ({}) priority {}", info_->name(),
-              host_set.hosts().size(), host_set.priority());
+  // A change of locality weights alone must also be published to the load balancers.
+  const bool hosts_updated = updateDynamicHostList(new_hosts, *current_hosts_copy, hosts_added,
+                                                   hosts_removed, health_checker_ != nullptr);
+  if (hosts_updated || locality_weights_map != new_locality_weights_map) {
+    ENVOY_LOG(debug, "EDS hosts or locality weights changed for cluster: {} ({}) priority {}",
+              info_->name(), host_set.hosts().size(), host_set.priority());
+    locality_weights_map = std::move(new_locality_weights_map);
     HostListsSharedPtr per_locality(new std::vector<std::vector<HostSharedPtr>>());
+    HostSet::LocalityWeightsConstSharedPtr locality_weights;
 
-    // If local locality is not defined then skip populating per locality hosts.
+    // Index 0 of per_locality is reserved for the local locality. If the local locality is not
+    // defined or has no upstream hosts, per locality hosts are only populated when locality
+    // weights were supplied, as only locality weighted load balancing can use them then.
     const Locality local_locality(local_info_.node().locality());
     ENVOY_LOG(trace, "Local locality: {}", local_info_.node().locality().DebugString());
-    if (!local_locality.empty()) {
-      std::map<Locality, std::vector<HostSharedPtr>> hosts_per_locality;
-
-      for (const HostSharedPtr& host : *current_hosts_copy) {
-        hosts_per_locality[Locality(host->locality())].push_back(host);
+    std::map<Locality, std::vector<HostSharedPtr>> hosts_per_locality;
+    for (const HostSharedPtr& host : *current_hosts_copy) {
+      hosts_per_locality[Locality(host->locality())].push_back(host);
+    }
+    const bool has_local_locality = !local_locality.empty() &&
+                                    hosts_per_locality.find(local_locality) !=
+                                        hosts_per_locality.end();
+
+    if (has_local_locality || !locality_weights_map.empty()) {
+      std::shared_ptr<HostSet::LocalityWeights> weights;
+      if (!locality_weights_map.empty()) {
+        weights.reset(new HostSet::LocalityWeights());
       }
+      auto add_locality = [&](const Locality& locality, std::vector<HostSharedPtr>& hosts) {
+        per_locality->push_back(hosts);
+        if (weights != nullptr) {
+          const auto weight = locality_weights_map.find(locality);
+          weights->push_back(weight != locality_weights_map.end() ? weight->second
+                                                                 : DefaultLocalityWeight);
+        }
+      };
 
-      // Populate per_locality hosts only if upstream cluster has hosts in the same locality.
-      if (hosts_per_locality.find(local_locality) != hosts_per_locality.end()) {
-        per_locality->push_back(hosts_per_locality[local_locality]);
-
-        for (auto& entry : hosts_per_locality) {
-          if (local_locality != entry.first) {
-            per_locality->push_back(entry.second);
-          }
+      if (has_local_locality) {
+        add_locality(local_locality, hosts_per_locality[local_locality]);
+      }
+      for (auto& entry : hosts_per_locality) {
+        if (!has_local_locality || local_locality != entry.first) {
+          add_locality(entry.first, entry.second);
         }
       }
+      locality_weights = weights;
     }
 
     host_set.updateHosts(current_hosts_copy, createHealthyHostList(*current_hosts_copy),
-                         per_locality, createHealthyHostLists(*per_locality), hosts_added,
-                         hosts_removed);
+                         per_locality, createHealthyHostLists(*per_locality), locality_weights,
+                         hosts_added, hosts_removed);
   }
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <map>
+#include <vector>
+
 #include "envoy/config/subscription.h"
 #include "envoy/local_info/local_info.h"
 
@@ -33,7 +36,10 @@ public:
   void onConfigUpdateFailed(const EnvoyException* e) override;
 
 private:
-  void updateHostsPerLocality(HostSet& host_set, std::vector<HostSharedPtr>& new_hosts);
+  typedef std::map<Locality, uint32_t> LocalityWeightsMap;
+
+  void updateHostsPerLocality(HostSet& host_set, std::vector<HostSharedPtr>& new_hosts,
+                              LocalityWeightsMap& new_locality_weights_map);
 
   // ClusterImplBase
   void startPreInit() override;
@@ -42,6 +48,9 @@ private:
   std::unique_ptr<Config::Subscription<envoy::api::v2::ClusterLoadAssignment>> subscription_;
   const LocalInfo::LocalInfo& local_info_;
   const std::string cluster_name_;
+  const std::string locality_weighted_lb_runtime_key_;
+  // The locality weights last published to each priority's host set.
+  std::vector<LocalityWeightsMap> locality_weights_map_;
 };
 
 } // namespace Upstream
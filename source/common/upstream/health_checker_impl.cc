@@ -189,8 +189,7 @@ void HealthCheckerImplBase::start() {
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
     HealthCheckerImplBase& parent, HostSharedPtr host)
     : host_(host), parent_(parent),
-      interval_timer_(parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
-      timeout_timer_(parent.dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })) {
+      timer_(parent.dispatcher_.createTimer([this]() -> void { onTimer(); })) {
 
   if (!host->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent.incHealthy();
@@ -223,8 +222,8 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess() {
   first_check_ = false;
   parent_.runCallbacks(host_, changed_state);
 
-  timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval());
+  check_in_flight_ = false;
+  timer_->enableTimer(parent_.interval());
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(FailureType type) {
@@ -253,13 +252,18 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(FailureType t
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(FailureType type) {
   setUnhealthy(type);
-  timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval());
+  check_in_flight_ = false;
+  timer_->enableTimer(parent_.interval());
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::onIntervalBase() {
+  check_in_flight_ = true;
   onInterval();
-  timeout_timer_->enableTimer(parent_.timeout_);
+  // The check may have already completed inline (e.g., an immediate connection failure), in which
+  // case the timer has been rearmed for the next interval.
+  if (check_in_flight_) {
+    timer_->enableTimer(parent_.timeout_);
+  }
   parent_.stats_.attempt_.inc();
 }
 
@@ -268,6 +272,14 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onTimeoutBase() {
   handleFailure(FailureType::Network);
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::onTimer() {
+  if (check_in_flight_) {
+    onTimeoutBase();
+  } else {
+    onIntervalBase();
+  }
+}
+
 HttpHealthCheckerImpl::HttpHealthCheckerImpl(const Cluster& cluster,
                                              const envoy::api::v2::HealthCheck& config,
                                              Event::Dispatcher& dispatcher,
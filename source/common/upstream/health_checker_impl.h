@@ -100,10 +100,14 @@ protected:
     void onIntervalBase();
     virtual void onTimeout() PURE;
     void onTimeoutBase();
+    void onTimer();
 
     HealthCheckerImplBase& parent_;
-    Event::TimerPtr interval_timer_;
-    Event::TimerPtr timeout_timer_;
+    // A session is always either waiting for the next interval or waiting for the response to an
+    // in flight check, so a single timer serves as both the interval and the timeout timer. This
+    // halves the number of timers the dispatcher has to track per health checked host.
+    Event::TimerPtr timer_;
+    bool check_in_flight_{};
     uint32_t num_unhealthy_{};
     uint32_t num_healthy_{};
     bool first_check_{true};
@@ -1,5 +1,6 @@
 #include "common/upstream/load_balancer_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -35,6 +36,7 @@ const HostSet* bestAvailable(const PrioritySet* priority_set) {
 static const std::string RuntimeZoneEnabled = "upstream.zone_routing.enabled";
 static const std::string RuntimeMinClusterSize = "upstream.zone_routing.min_cluster_size";
 static const std::string RuntimePanicThreshold = "upstream.healthy_panic_threshold";
+static const uint64_t MaxLeastRequestChoiceCount = 10;
 
 LoadBalancerBase::LoadBalancerBase(const PrioritySet& priority_set, ClusterStats& stats,
                                    Runtime::Loader& runtime, Runtime::RandomGenerator& random)
@@ -63,10 +65,15 @@ ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(const PrioritySet& priority
       local_priority_set_(local_priority_set) {
   ASSERT(!priority_set.hostSetsPerPriority().empty());
   resizePerPriorityState();
+  for (uint32_t priority = 0; priority < priority_set.hostSetsPerPriority().size(); ++priority) {
+    regenerateLocalityWeights(priority);
+  }
   priority_set_.addMemberUpdateCb([this](uint32_t priority, const std::vector<HostSharedPtr>&,
                                          const std::vector<HostSharedPtr>&) -> void {
     // Make sure per_priority_state_ is as large as priority_set_.hostSetsPerPriority()
     resizePerPriorityState();
+    // Host health feeds into the locality weights, so this is done on every update.
+    regenerateLocalityWeights(priority);
     // If P=0 changes, regenerate locality routing structures. Locality based routing is disabled
     // at all other levels.
     if (local_priority_set_ && priority == 0) {
@@ -185,9 +192,37 @@ void ZoneAwareLoadBalancerBase::resizePerPriorityState() {
   }
 }
 
+void ZoneAwareLoadBalancerBase::regenerateLocalityWeights(uint32_t priority) {
+  const HostSet& host_set = *priority_set_.hostSetsPerPriority()[priority];
+  const HostSet::LocalityWeightsConstSharedPtr locality_weights = host_set.localityWeights();
+  std::vector<uint64_t> effective_weights;
+  if (locality_weights != nullptr) {
+    ASSERT(locality_weights->size() == host_set.hostsPerLocality().size());
+    effective_weights.reserve(locality_weights->size());
+    for (size_t i = 0; i < locality_weights->size(); ++i) {
+      // As with locality percentages, scale by 10000 to keep precision for small weights.
+      const uint64_t hosts = host_set.hostsPerLocality()[i].size();
+      effective_weights.push_back(
+          hosts > 0 ? 10000ULL * (*locality_weights)[i] *
+                          host_set.healthyHostsPerLocality()[i].size() / hosts
+                    : 0);
+    }
+  }
+
+  // The table is left untouched if the effective weights did not change.
+  per_priority_state_[priority]->locality_table_.rebuild(effective_weights);
+}
+
 bool ZoneAwareLoadBalancerBase::earlyExitNonLocalityRouting() {
   // We only do locality routing for P=0.
   HostSet& host_set = *priority_set_.hostSetsPerPriority()[0];
+
+  // Locality weighted load balancing replaces locality aware routing for clusters that opted into
+  // it. Index 0 of the per locality hosts is not necessarily the local locality in that case.
+  if (host_set.localityWeights() != nullptr) {
+    return true;
+  }
+
   if (host_set.healthyHostsPerLocality().size() < 2) {
     return true;
   }
@@ -299,6 +334,17 @@ const std::vector<HostSharedPtr>& ZoneAwareLoadBalancerBase::hostsToUse() {
     return host_set.hosts();
   }
 
+  // If the cluster opted into locality weighted load balancing and EDS supplied locality weights,
+  // pick the locality in proportion to its weight. If no weighted locality has healthy hosts, fall
+  // back to all healthy hosts.
+  if (host_set.localityWeights() != nullptr) {
+    const AliasTable& locality_table = per_priority_state_[host_set.priority()]->locality_table_;
+    if (locality_table.empty()) {
+      return host_set.healthyHosts();
+    }
+    return host_set.healthyHostsPerLocality()[locality_table.pick(random_.random())];
+  }
+
   // If we've latched that we can't do priority-based routing, return healthy hosts for the selected
   // host set.
   if (per_priority_state_[host_set.priority()]->locality_routing_state_ ==
@@ -376,13 +422,23 @@ HostConstSharedPtr LeastRequestLoadBalancer::chooseHost(LoadBalancerContext*) {
 
     return last_host_;
   } else {
-    HostSharedPtr host1 = hosts_to_use[random_.random() % hosts_to_use.size()];
-    HostSharedPtr host2 = hosts_to_use[random_.random() % hosts_to_use.size()];
-    if (host1->stats().rq_active_.value() < host2->stats().rq_active_.value()) {
-      return host1;
-    } else {
-      return host2;
+    // Power of N choices: sample N hosts at random and pick the one with the fewest active
+    // requests, with ties going to the later sample. The default is the classic two choices. More
+    // samples than hosts, or than a handful, only make each pick more expensive.
+    const uint64_t choice_count = std::max<uint64_t>(
+        std::min<uint64_t>(
+            {runtime_.snapshot().getInteger("upstream.least_request.choice_count", 2),
+             MaxLeastRequestChoiceCount, hosts_to_use.size()}),
+        1);
+    const HostSharedPtr* candidate = &hosts_to_use[random_.random() % hosts_to_use.size()];
+    for (uint64_t i = 1; i < choice_count; ++i) {
+      const HostSharedPtr& sampled_host = hosts_to_use[random_.random() % hosts_to_use.size()];
+      if (sampled_host->stats().rq_active_.value() <= (*candidate)->stats().rq_active_.value()) {
+        candidate = &sampled_host;
+      }
     }
+
+    return *candidate;
   }
 }
 
@@ -8,6 +8,8 @@
 #include "envoy/upstream/load_balancer.h"
 #include "envoy/upstream/upstream.h"
 
+#include "common/upstream/alias_table.h"
+
 #include "api/cds.pb.h"
 
 namespace Envoy {
@@ -80,6 +82,12 @@ private:
    */
   void resizePerPriorityState();
 
+  /**
+   * Rebuild the locality pick table for a priority level from its host set's locality weights.
+   * Each configured weight is scaled by the locality's share of healthy hosts.
+   */
+  void regenerateLocalityWeights(uint32_t priority);
+
   /**
    * @return decision on quick exit from locality aware routing based on cluster configuration.
    * This gets recalculated on update callback.
@@ -120,6 +128,8 @@ private:
     // for each of the non-local localities to determine what traffic should be
     // routed where.
     std::vector<uint64_t> residual_capacity_;
+    // When the host set has locality weights, this picks the locality to route to in O(1).
+    AliasTable locality_table_;
   };
   typedef std::unique_ptr<PerPriorityState> PerPriorityStatePtr;
   // Routing state broken out for each priority level in priority_set_.
@@ -148,7 +158,8 @@ private:
  * Weighted Least Request load balancer.
  *
  * In a normal setup when all hosts have the same weight of 1 it randomly picks up two healthy hosts
- * and compares number of active requests.
+ * and compares number of active requests. The number of hosts sampled can be changed via the
+ * upstream.least_request.choice_count runtime key, up to 10 and the number of hosts.
  * Technique is based on http://www.eecs.harvard.edu/~michaelm/postscripts/mythesis.pdf
  *
  * When any of the hosts have non 1 weight, apply random weighted balancing.
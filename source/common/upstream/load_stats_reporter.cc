@@ -1,5 +1,9 @@
 #include "common/upstream/load_stats_reporter.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "common/protobuf/protobuf.h"
 
 namespace Envoy {
@@ -49,6 +53,29 @@ void LoadStatsReporter::establishNewStream() {
 }
 
 void LoadStatsReporter::sendLoadStatsRequest() {
+  // The reports are handed over by every thread before the request is sent, so that the request
+  // pairs them with the requests that are in progress at that time.
+  std::weak_ptr<bool> alive = alive_;
+  cm_.harvestLoadReports(clusters_, [this, alive](HostLoadReportMap&& load_reports) -> void {
+    // The harvest completes on a later event loop iteration, by which time the reporter may have
+    // been destroyed.
+    if (alive.expired()) {
+      return;
+    }
+    for (const auto& host_load_report : load_reports) {
+      HostLoadReport& load_report = load_reports_[host_load_report.first];
+      load_report.rq_success_ += host_load_report.second.rq_success_;
+      load_report.rq_error_ += host_load_report.second.rq_error_;
+    }
+    // If the stream went away in the meantime, the reports are sent on the next stream.
+    if (stream_ != nullptr) {
+      sendLoadStatsRequest(load_reports_);
+      load_reports_.clear();
+    }
+  });
+}
+
+void LoadStatsReporter::sendLoadStatsRequest(const HostLoadReportMap& load_reports) {
   request_.mutable_cluster_stats()->Clear();
   for (const std::string& cluster_name : clusters_) {
     auto cluster_info_map = cm_.clusters();
@@ -67,8 +94,11 @@ void LoadStatsReporter::sendLoadStatsRequest() {
         uint64_t rq_error = 0;
         uint64_t rq_active = 0;
         for (auto host : hosts) {
-          rq_success += host->stats().rq_success_.latch();
-          rq_error += host->stats().rq_error_.latch();
+          auto load_report = load_reports.find(host);
+          if (load_report != load_reports.end()) {
+            rq_success += load_report->second.rq_success_;
+            rq_error += load_report->second.rq_error_;
+          }
           rq_active += host->stats().rq_active_.value();
         }
         if (rq_success + rq_error + rq_active != 0) {
@@ -91,7 +121,7 @@ void LoadStatsReporter::sendLoadStatsRequest() {
   // When the connection is established, the message has not yet been read so we
   // will not have a load reporting period.
   if (message_.get()) {
-    startLoadReportPeriod();
+    enableResponseTimer();
   }
 }
 
@@ -119,24 +149,31 @@ void LoadStatsReporter::onReceiveMessage(
 }
 
 void LoadStatsReporter::startLoadReportPeriod() {
+  const std::vector<std::string> previous_clusters = std::move(clusters_);
   clusters_.clear();
-  // Reset stats for all hosts in clusters we are tracking.
   for (const std::string& cluster_name : message_->clusters()) {
     clusters_.emplace_back(cluster_name);
+  }
+
+  // Start accumulating load reports for the clusters we are tracking. What was accumulated for a
+  // cluster we were already tracking has not been sent yet and goes out with the next request.
+  cm_.updateLoadReportClusters(clusters_);
+  for (const std::string& cluster_name : clusters_) {
+    if (std::find(previous_clusters.begin(), previous_clusters.end(), cluster_name) !=
+        previous_clusters.end()) {
+      continue;
+    }
     auto cluster_info_map = cm_.clusters();
     auto it = cluster_info_map.find(cluster_name);
     if (it == cluster_info_map.end()) {
       continue;
     }
-    auto& cluster = it->second.get();
-    for (auto& host_set : cluster.prioritySet().hostSetsPerPriority()) {
-      for (auto host : host_set->hosts()) {
-        host->stats().rq_success_.latch();
-        host->stats().rq_error_.latch();
-      }
-    }
-    cluster.info()->loadReportStats().upstream_rq_dropped_.latch();
+    it->second.get().info()->loadReportStats().upstream_rq_dropped_.latch();
   }
+  enableResponseTimer();
+}
+
+void LoadStatsReporter::enableResponseTimer() {
   response_timer_->enableTimer(std::chrono::milliseconds(
       Protobuf::util::TimeUtil::DurationToMilliseconds(message_->load_reporting_interval())));
 }
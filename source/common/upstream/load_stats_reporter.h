@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "envoy/event/dispatcher.h"
 #include "envoy/stats/stats_macros.h"
 #include "envoy/upstream/cluster_manager.h"
@@ -57,8 +59,10 @@ private:
   void setRetryTimer();
   void establishNewStream();
   void sendLoadStatsRequest();
+  void sendLoadStatsRequest(const HostLoadReportMap& load_reports);
   void handleFailure();
   void startLoadReportPeriod();
+  void enableResponseTimer();
 
   ClusterManager& cm_;
   LoadReporterStats stats_;
@@ -70,6 +74,10 @@ private:
   envoy::api::v2::LoadStatsRequest request_;
   std::unique_ptr<envoy::api::v2::LoadStatsResponse> message_;
   std::vector<std::string> clusters_;
+  // Load reports harvested but not sent yet.
+  HostLoadReportMap load_reports_;
+  // Harvest callbacks hold a weak reference to this, which expires when the reporter is destroyed.
+  std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
 };
 
 typedef std::unique_ptr<LoadStatsReporter> LoadStatsReporterPtr;
@@ -114,7 +114,8 @@ void LogicalDnsCluster::startResolve() {
             ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
             auto& first_host_set = priority_set_.getOrCreateHostSet(0);
             first_host_set.updateHosts(new_hosts, createHealthyHostList(*new_hosts),
-                                       empty_host_lists_, empty_host_lists_, *new_hosts, {});
+                                       empty_host_lists_, empty_host_lists_, nullptr,
+                                       *new_hosts, {});
           }
         }
 
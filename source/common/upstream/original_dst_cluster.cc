@@ -51,7 +51,11 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
       HostSharedPtr host = host_map_.find(dst_addr);
       if (host) {
         ENVOY_LOG(debug, "Using existing host {}.", host->address()->asString());
-        host->used(true); // Mark as used.
+        // Mark as used. The flag is only cleared by the cleanup timer, so only the first use after
+        // a cleanup needs to write to it. This keeps the workers from contending on hot hosts.
+        if (!host->used()) {
+          host->used(true);
+        }
         return std::move(host);
       }
       // Add a new host
@@ -70,6 +74,7 @@ HostConstSharedPtr OriginalDstCluster::LoadBalancer::chooseHost(LoadBalancerCont
         host_map_.insert(host, false);
 
         if (std::shared_ptr<OriginalDstCluster> parent = parent_.lock()) {
+          parent->stats_.host_created_.inc();
           // lambda cannot capture a member by value.
           std::weak_ptr<OriginalDstCluster> post_parent = parent_;
           parent->dispatcher_.post([post_parent, host]() mutable {
@@ -99,19 +104,37 @@ OriginalDstCluster::OriginalDstCluster(const envoy::api::v2::Cluster& config,
                       added_via_api),
       dispatcher_(dispatcher), cleanup_interval_ms_(std::chrono::milliseconds(
                                    PROTOBUF_GET_MS_OR_DEFAULT(config, cleanup_interval, 5000))),
-      cleanup_timer_(dispatcher.createTimer([this]() -> void { cleanup(); })) {
+      add_hosts_timer_(dispatcher.createTimer([this]() -> void { addPendingHosts(); })),
+      cleanup_timer_(dispatcher.createTimer([this]() -> void { cleanup(); })),
+      stats_{ALL_ORIGINAL_DST_STATS(POOL_COUNTER_PREFIX(info()->statsScope(), "original_dst."))} {
 
   cleanup_timer_->enableTimer(cleanup_interval_ms_);
 }
 
 void OriginalDstCluster::addHost(HostSharedPtr& host) {
+  // Every host set update copies the whole host set, so adding each new destination on its own
+  // would be quadratic in the number of destinations seen in a burst.
+  if (pending_hosts_.empty()) {
+    add_hosts_timer_->enableTimer(std::chrono::milliseconds(0));
+  }
+  pending_hosts_.emplace_back(std::move(host));
+}
+
+void OriginalDstCluster::addPendingHosts() {
   // Given the current config, only EDS clusters support multiple priorities.
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
   auto& first_host_set = priority_set_.getOrCreateHostSet(0);
-  HostVectorSharedPtr new_hosts(new std::vector<HostSharedPtr>(first_host_set.hosts()));
-  new_hosts->emplace_back(host);
+  HostVectorSharedPtr new_hosts(new std::vector<HostSharedPtr>());
+  new_hosts->reserve(first_host_set.hosts().size() + pending_hosts_.size());
+  new_hosts->insert(new_hosts->end(), first_host_set.hosts().begin(),
+                    first_host_set.hosts().end());
+  new_hosts->insert(new_hosts->end(), pending_hosts_.begin(), pending_hosts_.end());
+
+  std::vector<HostSharedPtr> hosts_added;
+  hosts_added.swap(pending_hosts_);
+  stats_.host_add_batch_.inc();
   first_host_set.updateHosts(new_hosts, createHealthyHostList(*new_hosts), empty_host_lists_,
-                             empty_host_lists_, {std::move(host)}, {});
+                             empty_host_lists_, nullptr, hosts_added, {});
 }
 
 void OriginalDstCluster::cleanup() {
@@ -120,6 +143,7 @@ void OriginalDstCluster::cleanup() {
   // Given the current config, only EDS clusters support multiple priorities.
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
   auto& host_set = priority_set_.getOrCreateHostSet(0);
+  new_hosts->reserve(host_set.hosts().size());
 
   ENVOY_LOG(debug, "Cleaning up stale original dst hosts.");
   for (const HostSharedPtr& host : host_set.hosts()) {
@@ -134,8 +158,9 @@ void OriginalDstCluster::cleanup() {
   }
 
   if (to_be_removed.size() > 0) {
+    stats_.host_evicted_.add(to_be_removed.size());
     host_set.updateHosts(new_hosts, createHealthyHostList(*new_hosts), empty_host_lists_,
-                         empty_host_lists_, {}, to_be_removed);
+                         empty_host_lists_, nullptr, {}, to_be_removed);
   }
 
   cleanup_timer_->enableTimer(cleanup_interval_ms_);
@@ -4,7 +4,9 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "envoy/stats/stats_macros.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "common/common/empty_string.h"
@@ -14,6 +16,23 @@
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * All original destination cluster stats. @see stats_macros.h
+ */
+// clang-format off
+#define ALL_ORIGINAL_DST_STATS(COUNTER)                                                            \
+  COUNTER(host_created)                                                                            \
+  COUNTER(host_add_batch)                                                                          \
+  COUNTER(host_evicted)
+// clang-format on
+
+/**
+ * Struct definition for all original destination cluster stats. @see stats_macros.h
+ */
+struct OriginalDstStats {
+  ALL_ORIGINAL_DST_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * The OriginalDstCluster is a dynamic cluster that automatically adds hosts as needed based on the
  * original destination address of the downstream connection. These hosts are also automatically
@@ -99,6 +118,7 @@ public:
 
 private:
   void addHost(HostSharedPtr&);
+  void addPendingHosts();
   void cleanup();
 
   // ClusterImplBase
@@ -106,7 +126,12 @@ private:
 
   Event::Dispatcher& dispatcher_;
   const std::chrono::milliseconds cleanup_interval_ms_;
+  // Hosts created by the workers that have not been added to the host set yet. They are added in
+  // a single update once the main thread is done with the current event.
+  std::vector<HostSharedPtr> pending_hosts_;
+  Event::TimerPtr add_hosts_timer_;
   Event::TimerPtr cleanup_timer_;
+  OriginalDstStats stats_;
 };
 
 } // namespace Upstream
@@ -1,6 +1,7 @@
 #include "common/upstream/outlier_detection_impl.h"
 
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -47,7 +48,8 @@ void DetectorHostMonitorImpl::updateCurrentSuccessRateBucket() {
 }
 
 void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
-  success_rate_accumulator_bucket_.load()->total_request_counter_++;
+  SuccessRateAccumulatorBucket* bucket = success_rate_accumulator_bucket_.load();
+  bucket->total_request_counter_++;
   if (Http::CodeUtility::is5xx(response_code)) {
     std::shared_ptr<DetectorImpl> detector = detector_.lock();
     if (!detector) {
@@ -61,7 +63,7 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
         detector->onConsecutiveGatewayFailure(host_.lock());
       }
     } else {
-      consecutive_gateway_failure_ = 0;
+      resetConsecutiveGatewayFailure();
     }
 
     if (++consecutive_5xx_ ==
@@ -70,9 +72,9 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
       detector->onConsecutive5xx(host_.lock());
     }
   } else {
-    success_rate_accumulator_bucket_.load()->success_request_counter_++;
-    consecutive_5xx_ = 0;
-    consecutive_gateway_failure_ = 0;
+    bucket->success_request_counter_++;
+    resetConsecutive5xx();
+    resetConsecutiveGatewayFailure();
   }
 }
 
@@ -345,31 +347,31 @@ void DetectorImpl::onConsecutiveErrorWorker(HostSharedPtr host, EjectionType typ
 }
 
 Utility::EjectionPair Utility::successRateEjectionThreshold(
-    double success_rate_sum, const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
+    const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
     double success_rate_stdev_factor) {
   // This function is using mean and standard deviation as statistical measures for outlier
-  // detection. First the mean is calculated by dividing the sum of success rate data over the
-  // number of data points. Then variance is calculated by taking the mean of the
-  // squared difference of data points to the mean of the data. Then standard deviation is
-  // calculated by taking the square root of the variance. Then the outlier threshold is
-  // calculated as the difference between the mean and the product of the standard
-  // deviation and a constant factor.
+  // detection. The mean and variance are computed in a single pass using Welford's online
+  // algorithm, which avoids a second walk over the data and is numerically stable for the large
+  // host sets where success rate detection is most useful. Then standard deviation is calculated
+  // by taking the square root of the variance. Then the outlier threshold is calculated as the
+  // difference between the mean and the product of the standard deviation and a constant factor.
   //
   // For example with a data set that looks like success_rate_data = {50, 100, 100, 100, 100} the
   // math would work as follows:
-  // success_rate_sum = 450
   // mean = 90
   // variance = 400
   // stdev = 20
   // threshold returned = 52
-  double mean = success_rate_sum / valid_success_rate_hosts.size();
-  double variance = 0;
-  std::for_each(valid_success_rate_hosts.begin(), valid_success_rate_hosts.end(),
-                [&variance, mean](HostSuccessRatePair v) {
-                  variance += std::pow(v.success_rate_ - mean, 2);
-                });
-  variance /= valid_success_rate_hosts.size();
-  double stdev = std::sqrt(variance);
+  ASSERT(!valid_success_rate_hosts.empty());
+  double mean = 0;
+  double sum_squared_deviations = 0;
+  uint64_t count = 0;
+  for (const HostSuccessRatePair& v : valid_success_rate_hosts) {
+    const double delta = v.success_rate_ - mean;
+    mean += delta / ++count;
+    sum_squared_deviations += delta * (v.success_rate_ - mean);
+  }
+  double stdev = std::sqrt(sum_squared_deviations / count);
 
   return {mean, (mean - (success_rate_stdev_factor * stdev))};
 }
@@ -380,7 +382,6 @@ void DetectorImpl::processSuccessRateEjections() {
   uint64_t success_rate_request_volume = runtime_.snapshot().getInteger(
       "outlier_detection.success_rate_request_volume", config_.successRateRequestVolume());
   std::vector<HostSuccessRatePair> valid_success_rate_hosts;
-  double success_rate_sum = 0;
 
   // Reset the Detector's success rate mean and stdev.
   success_rate_average_ = -1;
@@ -401,21 +402,20 @@ void DetectorImpl::processSuccessRateEjections() {
           host.second->successRateAccumulator().getSuccessRate(success_rate_request_volume);
 
       if (host_success_rate.valid()) {
-        valid_success_rate_hosts.emplace_back(
-            HostSuccessRatePair(host.first, host_success_rate.value()));
-        success_rate_sum += host_success_rate.value();
+        valid_success_rate_hosts.emplace_back(host.first, host_success_rate.value());
         host.second->successRate(host_success_rate.value());
       }
     }
   }
 
-  if (valid_success_rate_hosts.size() >= success_rate_minimum_hosts) {
+  if (!valid_success_rate_hosts.empty() &&
+      valid_success_rate_hosts.size() >= success_rate_minimum_hosts) {
     double success_rate_stdev_factor =
         runtime_.snapshot().getInteger("outlier_detection.success_rate_stdev_factor",
                                        config_.successRateStdevFactor()) /
         1000.0;
     Utility::EjectionPair ejection_pair = Utility::successRateEjectionThreshold(
-        success_rate_sum, valid_success_rate_hosts, success_rate_stdev_factor);
+        valid_success_rate_hosts, success_rate_stdev_factor);
     success_rate_average_ = ejection_pair.success_rate_average_;
     success_rate_ejection_threshold_ = ejection_pair.ejection_threshold_;
     for (const auto& host_success_rate_pair : valid_success_rate_hosts) {
@@ -115,8 +115,19 @@ public:
   void updateCurrentSuccessRateBucket();
   SuccessRateAccumulator& successRateAccumulator() { return success_rate_accumulator_; }
   void successRate(double new_success_rate) { success_rate_ = new_success_rate; }
-  void resetConsecutive5xx() { consecutive_5xx_ = 0; }
-  void resetConsecutiveGatewayFailure() { consecutive_gateway_failure_ = 0; }
+  // The counters are shared by all workers sending to the host. Only write to them when they are
+  // not already zero so that a stream of successes to a popular host does not keep bouncing the
+  // cache line between workers.
+  void resetConsecutive5xx() {
+    if (consecutive_5xx_.load(std::memory_order_relaxed) != 0) {
+      consecutive_5xx_ = 0;
+    }
+  }
+  void resetConsecutiveGatewayFailure() {
+    if (consecutive_gateway_failure_.load(std::memory_order_relaxed) != 0) {
+      consecutive_gateway_failure_ = 0;
+    }
+  }
 
   // Upstream::Outlier::DetectorHostMonitor
   uint32_t numEjections() override { return num_ejections_; }
@@ -289,14 +300,14 @@ public:
    * This function returns an EjectionPair for success rate outlier detection. The pair contains
    * the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param valid_success_rate_hosts is the non-empty vector containing the individual success rate
+   *        data points.
+   * @param success_rate_stdev_factor the number of standard deviations below the mean at which a
+   *        host is considered an outlier.
    * @return EjectionPair.
    */
   static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
+  successRateEjectionThreshold(const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
                                double success_rate_stdev_factor);
 };
 
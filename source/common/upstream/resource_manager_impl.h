@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -30,13 +33,15 @@ public:
       : connections_(max_connections, runtime, runtime_key + "max_connections"),
         pending_requests_(max_pending_requests, runtime, runtime_key + "max_pending_requests"),
         requests_(max_requests, runtime, runtime_key + "max_requests"),
-        retries_(max_retries, runtime, runtime_key + "max_retries") {}
+        retries_(max_retries, runtime, runtime_key + "max_retries"),
+        adaptive_requests_(requests_, runtime, runtime_key + "adaptive_concurrency.enabled") {}
 
   // Upstream::ResourceManager
   Resource& connections() override { return connections_; }
   Resource& pendingRequests() override { return pending_requests_; }
   Resource& requests() override { return requests_; }
   Resource& retries() override { return retries_; }
+  AdaptiveResource& adaptiveRequests() override { return adaptive_requests_; }
 
 private:
   struct ResourceImpl : public Resource {
@@ -59,10 +64,105 @@ private:
     const std::string runtime_key_;
   };
 
+  /**
+   * Gradient based concurrency limit. Response times are accumulated into fixed size windows. At
+   * the end of each window the limit is scaled by the ratio of the long term average response time
+   * to the window's average response time (clamped to [0.5, 1]) and is then allowed to grow by a
+   * queueing allowance of sqrt(limit). The result is smoothed and bounded by max_requests, which
+   * is also the starting limit. Requests can then be shed before they queue up in the upstream.
+   * Failures are recorded as taking at least twice the long term average, which is the largest
+   * slowdown the gradient reacts to, so a window of failures backs the limit off as far as it goes.
+   * NOTE: As with the other resources, relaxed accounting is favored over synchronization. Workers
+   *       add samples with atomics and whichever worker completes a window updates the limit.
+   *       Samples racing with the end of a window may be dropped.
+   */
+  struct AdaptiveRequestsImpl : public AdaptiveResource {
+    AdaptiveRequestsImpl(ResourceImpl& requests, Runtime::Loader& runtime,
+                         const std::string& enabled_runtime_key)
+        : requests_(requests), runtime_(runtime), enabled_runtime_key_(enabled_runtime_key),
+          limit_(requests.max_) {}
+    ~AdaptiveRequestsImpl() { ASSERT(current_ == 0); }
+
+    // Upstream::Resource
+    bool canCreate() override { return current_ < max(); }
+    void inc() override { current_++; }
+    void dec() override {
+      ASSERT(current_ > 0);
+      current_--;
+    }
+    uint64_t max() override {
+      return std::min(static_cast<uint64_t>(limit_.load()), requests_.max());
+    }
+
+    // Upstream::AdaptiveResource
+    bool enabled() override {
+      return runtime_.snapshot().getInteger(enabled_runtime_key_, 0) != 0;
+    }
+    void recordResponseTime(std::chrono::milliseconds response_time) override {
+      window_response_time_ms_ += response_time.count();
+      if (++window_samples_ == WINDOW_SAMPLES) {
+        const uint64_t window_response_time_ms = window_response_time_ms_.exchange(0);
+        window_samples_ = 0;
+        updateLimit(static_cast<double>(window_response_time_ms) / WINDOW_SAMPLES);
+      }
+    }
+    void recordFailure(std::chrono::milliseconds response_time) override {
+      const auto penalty = std::chrono::milliseconds(
+          static_cast<uint64_t>(FAILURE_PENALTY * long_term_response_time_ms_.load()));
+      recordResponseTime(std::max(response_time, penalty));
+    }
+
+    void updateLimit(double sample_ms) {
+      // Treat sub-millisecond upstreams as 1ms so that the gradient is well defined.
+      sample_ms = std::max(sample_ms, 1.0);
+      double long_term_ms = long_term_response_time_ms_.load();
+      if (long_term_ms == 0) {
+        long_term_ms = sample_ms;
+      } else {
+        long_term_ms = long_term_ms * (1 - LONG_TERM_WEIGHT) + sample_ms * LONG_TERM_WEIGHT;
+        // Let the long term average recover quickly once a latency spike has passed, otherwise the
+        // limit would keep growing unchecked while the inflated average decays.
+        if (long_term_ms > 2 * sample_ms) {
+          long_term_ms *= 0.95;
+        }
+      }
+      long_term_response_time_ms_ = long_term_ms;
+
+      const double limit = limit_.load();
+      const double gradient = std::max(0.5, std::min(1.0, long_term_ms / sample_ms));
+      const double new_limit = limit * gradient + std::sqrt(limit);
+      const double smoothed_limit = limit * (1 - SMOOTHING) + new_limit * SMOOTHING;
+      const double max_limit = static_cast<double>(requests_.max());
+      if (smoothed_limit > max_limit) {
+        limit_ = max_limit;
+      } else if (smoothed_limit < MIN_LIMIT) {
+        limit_ = MIN_LIMIT;
+      } else {
+        limit_ = smoothed_limit;
+      }
+    }
+
+    static constexpr uint64_t WINDOW_SAMPLES = 100;
+    static constexpr double LONG_TERM_WEIGHT = 0.05;
+    static constexpr double SMOOTHING = 0.2;
+    static constexpr double FAILURE_PENALTY = 2;
+    static constexpr double MIN_LIMIT = 1;
+
+    ResourceImpl& requests_;
+    Runtime::Loader& runtime_;
+    const std::string enabled_runtime_key_;
+    std::atomic<uint64_t> current_{};
+    std::atomic<double> limit_;
+    std::atomic<double> long_term_response_time_ms_{};
+    std::atomic<uint64_t> window_response_time_ms_{};
+    std::atomic<uint64_t> window_samples_{};
+  };
+
   ResourceImpl connections_;
   ResourceImpl pending_requests_;
   ResourceImpl requests_;
   ResourceImpl retries_;
+  AdaptiveRequestsImpl adaptive_requests_;
 };
 
 typedef std::unique_ptr<ResourceManagerImpl> ResourceManagerImplPtr;
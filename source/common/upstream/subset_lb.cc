@@ -71,7 +71,7 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
   }
 
   // Route has metadata match criteria defined, see if we have a matching subset.
-  LbSubsetEntryPtr entry = findSubset(match_criteria->metadataMatchCriteria());
+  LbSubsetEntryPtr entry = findSubsetCached(match_criteria->metadataMatchCriteria());
   if (entry == nullptr || !entry->active()) {
     // No matching subset or subset not active: use fallback policy.
     return nullptr;
@@ -121,6 +121,33 @@ SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubset(
   return nullptr;
 }
 
+// Returns the result of findSubset for the given criteria, consulting subset_lookup_cache_ first.
+SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::findSubsetCached(
+    const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& match_criteria) {
+  size_t key = 0;
+  for (const auto& match_criterion : match_criteria) {
+    key = key * 31 + std::hash<const Router::MetadataMatchCriterion*>()(match_criterion.get());
+  }
+
+  auto cache_it = subset_lookup_cache_.find(key);
+  if (cache_it != subset_lookup_cache_.end() && cache_it->second.criteria_ == match_criteria) {
+    return cache_it->second.entry_;
+  }
+
+  LbSubsetEntryPtr entry = findSubset(match_criteria);
+  if (cache_it != subset_lookup_cache_.end()) {
+    // Key collision with different criteria: replace the existing entry.
+    cache_it->second = {match_criteria, entry};
+  } else {
+    if (subset_lookup_cache_.size() >= MAX_SUBSET_LOOKUP_CACHE_SIZE) {
+      subset_lookup_cache_.clear();
+    }
+    subset_lookup_cache_.emplace(key, SubsetLookupCacheEntry{match_criteria, entry});
+  }
+
+  return entry;
+}
+
 void SubsetLoadBalancer::updateFallbackSubset(uint32_t priority,
                                               const std::vector<HostSharedPtr>& hosts_added,
                                               const std::vector<HostSharedPtr>& hosts_removed) {
@@ -189,6 +216,9 @@ void SubsetLoadBalancer::processSubsets(
 // new subsets as necessary.
 void SubsetLoadBalancer::update(uint32_t priority, const std::vector<HostSharedPtr>& hosts_added,
                                 const std::vector<HostSharedPtr>& hosts_removed) {
+  // New subsets may be created below, invalidating any cached lookup misses.
+  subset_lookup_cache_.clear();
+
   updateFallbackSubset(priority, hosts_added, hosts_removed);
 
   processSubsets(hosts_added, hosts_removed,
@@ -260,7 +290,7 @@ SubsetLoadBalancer::extractSubsetMetadata(const std::set<std::string>& subset_ke
   }
 
   const auto& fields = filter_it->second.fields();
-  for (const auto key : subset_keys) {
+  for (const auto& key : subset_keys) {
     const auto it = fields.find(key);
     if (it == fields.end()) {
       break;
@@ -373,14 +403,14 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const std::vector<HostSharedPtr>
                                                 const std::vector<HostSharedPtr>& hosts_removed,
                                                 std::function<bool(const Host&)> predicate) {
   std::vector<HostSharedPtr> filtered_added;
-  for (const auto host : hosts_added) {
+  for (const auto& host : hosts_added) {
     if (predicate(*host)) {
       filtered_added.emplace_back(host);
     }
   }
 
   std::vector<HostSharedPtr> filtered_removed;
-  for (const auto host : hosts_removed) {
+  for (const auto& host : hosts_removed) {
     if (predicate(*host)) {
       filtered_removed.emplace_back(host);
     }
@@ -395,7 +425,7 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const std::vector<HostSharedPtr>
   HostListsSharedPtr hosts_per_locality(new std::vector<std::vector<HostSharedPtr>>());
   HostListsSharedPtr healthy_hosts_per_locality(new std::vector<std::vector<HostSharedPtr>>());
 
-  for (const auto host : original_host_set_.hosts()) {
+  for (const auto& host : original_host_set_.hosts()) {
     if (predicate(*host)) {
       hosts->emplace_back(host);
       if (host->healthy()) {
@@ -404,10 +434,10 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const std::vector<HostSharedPtr>
     }
   }
 
-  for (const auto locality_hosts : original_host_set_.hostsPerLocality()) {
+  for (const auto& locality_hosts : original_host_set_.hostsPerLocality()) {
     std::vector<HostSharedPtr> curr_locality_hosts;
     std::vector<HostSharedPtr> curr_locality_healthy_hosts;
-    for (const auto locality_host : locality_hosts) {
+    for (const auto& locality_host : locality_hosts) {
       if (predicate(*locality_host)) {
         curr_locality_hosts.emplace_back(locality_host);
         if (locality_host->healthy()) {
@@ -416,12 +446,13 @@ void SubsetLoadBalancer::HostSubsetImpl::update(const std::vector<HostSharedPtr>
       }
     }
 
-    hosts_per_locality->emplace_back(curr_locality_hosts);
-    healthy_hosts_per_locality->emplace_back(curr_locality_healthy_hosts);
+    hosts_per_locality->emplace_back(std::move(curr_locality_hosts));
+    healthy_hosts_per_locality->emplace_back(std::move(curr_locality_healthy_hosts));
   }
 
+  // Every locality is kept (possibly empty) so the original locality weights still line up.
   HostSetImpl::updateHosts(hosts, healthy_hosts, hosts_per_locality, healthy_hosts_per_locality,
-                           filtered_added, filtered_removed);
+                           original_host_set_.localityWeights(), filtered_added, filtered_removed);
 }
 
 HostSetImplPtr SubsetLoadBalancer::PrioritySubsetImpl::createHostSet(uint32_t priority) {
@@ -4,6 +4,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "envoy/common/optional.h"
 #include "envoy/runtime/runtime.h"
@@ -121,6 +123,8 @@ private:
 
   LbSubsetEntryPtr
   findSubset(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& matches);
+  LbSubsetEntryPtr
+  findSubsetCached(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& matches);
 
   LbSubsetEntryPtr findOrCreateSubset(LbSubsetMap& subsets, const SubsetMetadata& kvs,
                                       uint32_t idx);
@@ -144,6 +148,19 @@ private:
 
   // Forms a trie-like structure. Requires lexically sorted Host and Route metadata.
   LbSubsetMap subsets_;
+
+  // Route match criteria are built once per route and shared by every request that uses the
+  // route, so the result of walking subsets_ for a given set of criterion objects is memoized,
+  // keyed by the identity of those objects. Each entry holds references to its criteria so that
+  // their addresses cannot be reused while cached. The cache is flushed on any membership update
+  // since that may create new subsets.
+  struct SubsetLookupCacheEntry {
+    std::vector<Router::MetadataMatchCriterionConstSharedPtr> criteria_;
+    LbSubsetEntryPtr entry_;
+  };
+  std::unordered_map<size_t, SubsetLookupCacheEntry> subset_lookup_cache_;
+
+  static const size_t MAX_SUBSET_LOOKUP_CACHE_SIZE = 1024;
 };
 
 } // namespace Upstream
@@ -2,9 +2,11 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -171,7 +173,7 @@ ClusterSharedPtr ClusterImplBase::create(const envoy::api::v2::Cluster& cluster,
     for (const auto& resolver_addr : resolver_addrs) {
       resolvers.push_back(Network::Address::resolveProtoAddress(resolver_addr));
     }
-    selected_dns_resolver = dispatcher.createDnsResolver(resolvers);
+    selected_dns_resolver = dispatcher.createDnsResolver(resolvers, stats);
   }
 
   switch (cluster.type()) {
@@ -386,7 +388,8 @@ void ClusterImplBase::reloadHealthyHosts() {
         new std::vector<std::vector<HostSharedPtr>>(host_set->hostsPerLocality()));
     host_set->updateHosts(hosts_copy, createHealthyHostList(host_set->hosts()),
                           hosts_per_locality_copy,
-                          createHealthyHostLists(host_set->hostsPerLocality()), {}, {});
+                          createHealthyHostLists(host_set->hostsPerLocality()),
+                          host_set->localityWeights(), {}, {});
   }
 }
 
@@ -469,7 +472,8 @@ void StaticClusterImpl::startPreInit() {
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
   auto& first_host_set = priority_set_.getOrCreateHostSet(0);
   first_host_set.updateHosts(initial_hosts_, createHealthyHostList(*initial_hosts_),
-                             empty_host_lists_, empty_host_lists_, *initial_hosts_, {});
+                             empty_host_lists_, empty_host_lists_, nullptr, *initial_hosts_,
+                             {});
   initial_hosts_ = nullptr;
 
   onPreInitComplete();
@@ -483,65 +487,86 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(const std::vector<HostSharedP
   uint64_t max_host_weight = 1;
 
   // Go through and see if the list we have is different from what we just got. If it is, we
-  // make a new host list and raise a change notification. This uses an N^2 search given that
-  // this does not happen very often and the list sizes should be small. We also check for
-  // duplicates here. It's possible for DNS to return the same address multiple times, and a bad
-  // SDS implementation could do the same thing.
-  std::unordered_set<std::string> host_addresses;
+  // make a new host list and raise a change notification. Current hosts are indexed by address so
+  // that this is linear in the number of hosts. We also check for duplicates here. It's possible
+  // for DNS to return the same address multiple times, and a bad SDS implementation could do the
+  // same thing. The index and duplicate set refer to the address strings owned by the hosts rather
+  // than copying them.
+  typedef std::reference_wrapper<const std::string> AddressRef;
+  std::unordered_multimap<AddressRef, size_t, std::hash<std::string>, std::equal_to<std::string>>
+      current_hosts_index;
+  current_hosts_index.reserve(current_hosts.size());
+  for (size_t i = 0; i < current_hosts.size(); i++) {
+    current_hosts_index.emplace(current_hosts[i]->address()->asString(), i);
+  }
+
+  std::unordered_set<AddressRef, std::hash<std::string>, std::equal_to<std::string>>
+      host_addresses;
+  host_addresses.reserve(new_hosts.size());
+  std::vector<bool> current_hosts_kept(current_hosts.size());
   std::vector<HostSharedPtr> final_hosts;
+  final_hosts.reserve(new_hosts.size());
   for (const HostSharedPtr& host : new_hosts) {
-    if (host_addresses.count(host->address()->asString())) {
+    if (!host_addresses.emplace(host->address()->asString()).second) {
       continue;
     }
-    host_addresses.emplace(host->address()->asString());
-
-    bool found = false;
-    for (auto i = current_hosts.begin(); i != current_hosts.end();) {
-      // If we find a host matched based on address, we keep it. However we do change weight inline
-      // so do that here.
-      if (*(*i)->address() == *host->address()) {
-        if (host->weight() > max_host_weight) {
-          max_host_weight = host->weight();
-        }
 
-        (*i)->weight(host->weight());
-        final_hosts.push_back(*i);
-        i = current_hosts.erase(i);
-        found = true;
-      } else {
-        i++;
-      }
+    if (host->weight() > max_host_weight) {
+      max_host_weight = host->weight();
     }
 
-    if (!found) {
-      if (host->weight() > max_host_weight) {
-        max_host_weight = host->weight();
+    // If we find a host matched based on address, we keep it. However we do change weight inline
+    // so do that here.
+    const auto matches = current_hosts_index.equal_range(host->address()->asString());
+    if (matches.first != matches.second) {
+      for (auto match = matches.first; match != matches.second; match++) {
+        const HostSharedPtr& current_host = current_hosts[match->second];
+        current_host->weight(host->weight());
+        final_hosts.push_back(current_host);
+        current_hosts_kept[match->second] = true;
       }
+      continue;
+    }
 
-      final_hosts.push_back(host);
-      hosts_added.push_back(host);
+    final_hosts.push_back(host);
+    hosts_added.push_back(host);
 
-      // If we are depending on a health checker, we initialize to unhealthy.
-      if (depend_on_hc) {
-        hosts_added.back()->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    // If we are depending on a health checker, we initialize to unhealthy.
+    if (depend_on_hc) {
+      hosts_added.back()->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+  }
+
+  // Leave only the hosts that were not matched in current_hosts, preserving their order.
+  size_t unmatched = 0;
+  for (size_t i = 0; i < current_hosts.size(); i++) {
+    if (!current_hosts_kept[i]) {
+      if (unmatched != i) {
+        current_hosts[unmatched] = std::move(current_hosts[i]);
       }
+      unmatched++;
     }
   }
+  current_hosts.resize(unmatched);
 
   // If there are removed hosts, check to see if we should only delete if unhealthy.
   if (!current_hosts.empty() && depend_on_hc) {
-    for (auto i = current_hosts.begin(); i != current_hosts.end();) {
-      if (!(*i)->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
-        if ((*i)->weight() > max_host_weight) {
-          max_host_weight = (*i)->weight();
+    size_t removed = 0;
+    for (size_t i = 0; i < current_hosts.size(); i++) {
+      if (!current_hosts[i]->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
+        if (current_hosts[i]->weight() > max_host_weight) {
+          max_host_weight = current_hosts[i]->weight();
         }
 
-        final_hosts.push_back(*i);
-        i = current_hosts.erase(i);
+        final_hosts.push_back(std::move(current_hosts[i]));
       } else {
-        i++;
+        if (removed != i) {
+          current_hosts[removed] = std::move(current_hosts[i]);
+        }
+        removed++;
       }
     }
+    current_hosts.resize(removed);
   }
 
   info_->stats().max_host_weight_.set(max_host_weight);
@@ -611,7 +636,7 @@ void StrictDnsClusterImpl::updateAllHosts(const std::vector<HostSharedPtr>& host
   ASSERT(priority_set_.hostSetsPerPriority().size() == 1);
   auto& first_host_set = priority_set_.getOrCreateHostSet(0);
   first_host_set.updateHosts(new_hosts, createHealthyHostList(*new_hosts), empty_host_lists_,
-                             empty_host_lists_, hosts_added, hosts_removed);
+                             empty_host_lists_, nullptr, hosts_added, hosts_removed);
 }
 
 StrictDnsClusterImpl::ResolveTarget::ResolveTarget(StrictDnsClusterImpl& parent,
@@ -182,12 +182,14 @@ public:
   void updateHosts(HostVectorConstSharedPtr hosts, HostVectorConstSharedPtr healthy_hosts,
                    HostListsConstSharedPtr hosts_per_locality,
                    HostListsConstSharedPtr healthy_hosts_per_locality,
+                   LocalityWeightsConstSharedPtr locality_weights,
                    const std::vector<HostSharedPtr>& hosts_added,
                    const std::vector<HostSharedPtr>& hosts_removed) override {
     hosts_ = std::move(hosts);
     healthy_hosts_ = std::move(healthy_hosts);
     hosts_per_locality_ = std::move(hosts_per_locality);
     healthy_hosts_per_locality_ = std::move(healthy_hosts_per_locality);
+    locality_weights_ = std::move(locality_weights);
     runUpdateCallbacks(hosts_added, hosts_removed);
   }
 
@@ -212,6 +214,7 @@ public:
   const std::vector<std::vector<HostSharedPtr>>& healthyHostsPerLocality() const override {
     return *healthy_hosts_per_locality_;
   }
+  LocalityWeightsConstSharedPtr localityWeights() const override { return locality_weights_; }
   uint32_t priority() const override { return priority_; }
 
 protected:
@@ -226,6 +229,7 @@ private:
   HostVectorConstSharedPtr healthy_hosts_;
   HostListsConstSharedPtr hosts_per_locality_;
   HostListsConstSharedPtr healthy_hosts_per_locality_;
+  LocalityWeightsConstSharedPtr locality_weights_;
   // TODO(mattklein123): Remove mutable.
   mutable Common::CallbackManager<uint32_t, const std::vector<HostSharedPtr>&,
                                   const std::vector<HostSharedPtr>&>
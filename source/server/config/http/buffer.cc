@@ -27,8 +27,7 @@ BufferFilterConfig::createFilter(const envoy::api::v2::filter::http::Buffer& pro
       static_cast<uint64_t>(proto_config.max_request_bytes().value()),
       std::chrono::seconds(PROTOBUF_GET_SECONDS_REQUIRED(proto_config, max_request_time))});
   return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(
-        Http::StreamDecoderFilterSharedPtr{new Http::BufferFilter(filter_config)});
+    callbacks.addStreamDecoderFilter(std::make_shared<Http::BufferFilter>(filter_config));
   };
 }
 
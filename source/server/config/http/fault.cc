@@ -17,8 +17,7 @@ FaultFilterConfig::createFilter(const envoy::api::v2::filter::http::HTTPFault& c
   Http::FaultFilterConfigSharedPtr filter_config(
       new Http::FaultFilterConfig(config, context.runtime(), stats_prefix, context.scope()));
   return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(
-        Http::StreamDecoderFilterSharedPtr{new Http::FaultFilter(filter_config)});
+    callbacks.addStreamDecoderFilter(std::make_shared<Http::FaultFilter>(filter_config));
   };
 }
 
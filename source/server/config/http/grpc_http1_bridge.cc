@@ -13,8 +13,7 @@ namespace Configuration {
 HttpFilterFactoryCb GrpcHttp1BridgeFilterConfig::createFilter(const std::string&,
                                                               FactoryContext& context) {
   return [&context](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(
-        Http::StreamFilterSharedPtr{new Grpc::Http1BridgeFilter(context.clusterManager())});
+    callbacks.addStreamFilter(std::make_shared<Grpc::Http1BridgeFilter>(context.clusterManager()));
   };
 }
 
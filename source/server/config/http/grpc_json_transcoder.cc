@@ -22,8 +22,7 @@ HttpFilterFactoryCb GrpcJsonTranscoderFilterConfig::createFilter(
       std::make_shared<Grpc::JsonTranscoderConfig>(proto_config);
 
   return [filter_config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(
-        Http::StreamFilterSharedPtr{new Grpc::JsonTranscoderFilter(*filter_config)});
+    callbacks.addStreamFilter(std::make_shared<Grpc::JsonTranscoderFilter>(*filter_config));
   };
 }
 
@@ -10,8 +10,7 @@ namespace Configuration {
 
 HttpFilterFactoryCb GrpcWebFilterConfig::createFilter(const std::string&, FactoryContext& context) {
   return [&context](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(
-        Http::StreamFilterSharedPtr{new Grpc::GrpcWebFilter(context.clusterManager())});
+    callbacks.addStreamFilter(std::make_shared<Grpc::GrpcWebFilter>(context.clusterManager()));
   };
 }
 
@@ -16,8 +16,7 @@ HttpFilterFactoryCb IpTaggingFilterConfig::createFilterFactory(const Json::Objec
                                                                FactoryContext&) {
   Http::IpTaggingFilterConfigSharedPtr config(new Http::IpTaggingFilterConfig(json_config));
   return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(
-        Http::StreamDecoderFilterSharedPtr{new Http::IpTaggingFilter(config)});
+    callbacks.addStreamDecoderFilter(std::make_shared<Http::IpTaggingFilter>(config));
   };
 }
 
@@ -25,8 +25,8 @@ RateLimitFilterConfig::createFilter(const envoy::api::v2::filter::http::RateLimi
   const uint32_t timeout_ms = PROTOBUF_GET_MS_OR_DEFAULT(proto_config, timeout, 20);
   return [filter_config, timeout_ms,
           &context](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr{new Http::RateLimit::Filter(
-        filter_config, context.rateLimitClient(std::chrono::milliseconds(timeout_ms)))});
+    callbacks.addStreamDecoderFilter(std::make_shared<Http::RateLimit::Filter>(
+        filter_config, context.rateLimitClient(std::chrono::milliseconds(timeout_ms))));
   };
 }
 
@@ -19,7 +19,7 @@ ValidationDispatcher::createSslClientConnection(Ssl::ClientContext&,
 }
 
 Network::DnsResolverSharedPtr ValidationDispatcher::createDnsResolver(
-    const std::vector<Network::Address::InstanceConstSharedPtr>&) {
+    const std::vector<Network::Address::InstanceConstSharedPtr>&, Stats::Scope&) {
   NOT_IMPLEMENTED;
 }
 
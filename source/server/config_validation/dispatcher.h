@@ -20,8 +20,9 @@ public:
   Network::ClientConnectionPtr
   createSslClientConnection(Ssl::ClientContext&, Network::Address::InstanceConstSharedPtr,
                             Network::Address::InstanceConstSharedPtr) override;
-  Network::DnsResolverSharedPtr createDnsResolver(
-      const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers) override;
+  Network::DnsResolverSharedPtr
+  createDnsResolver(const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers,
+                    Stats::Scope& scope) override;
   Network::ListenerPtr createListener(Network::ConnectionHandler&, Network::ListenSocket&,
                                       Network::ListenerCallbacks&, Stats::Scope&,
                                       const Network::ListenerOptions&) override;
@@ -590,7 +590,7 @@ bool AdminImpl::createFilterChain(Network::Connection& connection) {
 }
 
 void AdminImpl::createFilterChain(Http::FilterChainFactoryCallbacks& callbacks) {
-  callbacks.addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr{new AdminFilter(*this)});
+  callbacks.addStreamDecoderFilter(std::make_shared<AdminFilter>(*this));
 }
 
 Http::Code AdminImpl::runCallback(const std::string& path_and_query,
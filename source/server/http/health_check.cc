@@ -45,8 +45,8 @@ HealthCheckFilterConfig::createFilter(const envoy::api::v2::filter::http::Health
 
   return [&context, pass_through_mode, cache_manager,
           hc_endpoint](Http::FilterChainFactoryCallbacks& callbacks) -> void {
-    callbacks.addStreamFilter(Http::StreamFilterSharedPtr{
-        new HealthCheckFilter(context, pass_through_mode, cache_manager, hc_endpoint)});
+    callbacks.addStreamFilter(std::make_shared<HealthCheckFilter>(context, pass_through_mode,
+                                                                  cache_manager, hc_endpoint));
   };
 }
 
@@ -4,6 +4,7 @@
 
 #include "common/common/assert.h"
 #include "common/config/utility.h"
+#include "common/network/connection_rate_limiter_impl.h"
 #include "common/network/listen_socket_impl.h"
 #include "common/network/utility.h"
 #include "common/protobuf/utility.h"
@@ -93,6 +94,14 @@ ListenerImpl::ListenerImpl(const envoy::api::v2::Listener& config, ListenerManag
   // filter chain #1308.
   ASSERT(config.filter_chains().size() >= 1);
 
+  // The workers accept from the same socket, so they share a single limiter to stay within the
+  // listener's limit together.
+  const uint64_t connection_rate_limit = parent_.server_.runtime().snapshot().getInteger(
+      fmt::format("listener.{}.connection_rate_limit_per_second", name_), 0);
+  if (connection_rate_limit > 0) {
+    connection_rate_limiter_.reset(new Network::ConnectionRateLimiterImpl(connection_rate_limit));
+  }
+
   // Skip lookup and update of the SSL Context if there is only one filter chain
   // and it doesn't enforce any SNI restrictions.
   const bool skip_context_update =
@@ -120,6 +129,7 @@ ListenerImpl::ListenerImpl(const envoy::api::v2::Listener& config, ListenerManag
       has_tls++;
       if (filter_chain.tls_context().has_session_ticket_keys()) {
         has_stk++;
+        watchSessionTicketKeys(filter_chain.tls_context(), *tls_contexts_.back());
       }
     }
   }
@@ -146,6 +156,40 @@ ListenerImpl::~ListenerImpl() {
   filter_factories_.clear();
 }
 
+void ListenerImpl::watchSessionTicketKeys(const envoy::api::v2::DownstreamTlsContext& tls_context,
+                                          Ssl::ServerContext& context) {
+  // Keys are rotated by atomically moving new key files into place, after which all of the keys
+  // of the context are read again. This way tickets encrypted with a key that is still listed keep
+  // working across the rotation.
+  for (const auto& datasource : tls_context.session_ticket_keys().keys()) {
+    if (datasource.specifier_case() != envoy::api::v2::DataSource::kFilename) {
+      continue;
+    }
+
+    if (session_ticket_keys_watcher_ == nullptr) {
+      session_ticket_keys_watcher_ = dispatcher().createFilesystemWatcher();
+    }
+
+    try {
+      session_ticket_keys_watcher_->addWatch(
+          datasource.filename(), Filesystem::Watcher::Events::MovedTo,
+          [this, tls_context, &context](uint32_t) -> void {
+            try {
+              context.setSessionTicketKeys(
+                  Ssl::ServerContextConfigImpl::readSessionTicketKeys(tls_context));
+              ENVOY_LOG(info, "{}: reloaded TLS session ticket keys", address_->asString());
+            } catch (const EnvoyException& e) {
+              ENVOY_LOG(warn, "{}: failed to reload TLS session ticket keys: {}",
+                        address_->asString(), e.what());
+            }
+          });
+    } catch (const EnvoyException& e) {
+      ENVOY_LOG(warn, "{}: TLS session ticket keys will not be rotated: {}", address_->asString(),
+                e.what());
+    }
+  }
+}
+
 bool ListenerImpl::createFilterChain(Network::Connection& connection) {
   return Configuration::FilterChainUtility::buildFilterChain(connection, filter_factories_);
 }
@@ -157,6 +201,11 @@ bool ListenerImpl::drainClose() const {
   return local_drain_manager_->drainClose() || parent_.server_.drainManager().drainClose();
 }
 
+uint32_t ListenerImpl::maxConnectionsPerAccept() {
+  return parent_.server_.runtime().snapshot().getInteger(
+      fmt::format("listener.{}.max_connections_per_accept", name_), 0);
+}
+
 void ListenerImpl::debugLog(const std::string& message) {
   UNREFERENCED_PARAMETER(message);
   ENVOY_LOG(debug, "{}: name={}, hash={}, address={}", message, name_, hash_, address_->asString());
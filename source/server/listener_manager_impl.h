@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/filesystem/filesystem.h"
 #include "envoy/server/filter_config.h"
 #include "envoy/server/instance.h"
 #include "envoy/server/listener_manager.h"
@@ -200,6 +201,10 @@ public:
   bool useProxyProto() override { return use_proxy_proto_; }
   bool useOriginalDst() override { return use_original_dst_; }
   uint32_t perConnectionBufferLimitBytes() override { return per_connection_buffer_limit_bytes_; }
+  uint32_t maxConnectionsPerAccept() override;
+  Network::ConnectionRateLimiterSharedPtr connectionRateLimiter() override {
+    return connection_rate_limiter_;
+  }
   Stats::Scope& listenerScope() override { return *listener_scope_; }
   uint64_t listenerTag() override { return listener_tag_; }
   const std::string& name() const override { return name_; }
@@ -233,12 +238,22 @@ public:
   bool createFilterChain(Network::Connection& connection) override;
 
 private:
+  /**
+   * Reload the session ticket keys of a TLS context whenever one of its key files is replaced.
+   * @param tls_context supplies the configuration of the TLS context.
+   * @param context supplies the context to update.
+   */
+  void watchSessionTicketKeys(const envoy::api::v2::DownstreamTlsContext& tls_context,
+                              Ssl::ServerContext& context);
+
   ListenerManagerImpl& parent_;
   Network::Address::InstanceConstSharedPtr address_;
   Network::ListenSocketSharedPtr socket_;
   Stats::ScopePtr global_scope_;   // Stats with global named scope, but needed for LDS cleanup.
   Stats::ScopePtr listener_scope_; // Stats with listener named scope.
   std::vector<Ssl::ServerContextPtr> tls_contexts_;
+  // Must be destroyed before the contexts its callbacks update.
+  Filesystem::WatcherPtr session_ticket_keys_watcher_;
   const bool bind_to_port_;
   const bool use_proxy_proto_;
   const bool use_original_dst_;
@@ -251,6 +266,7 @@ private:
   bool initialize_canceled_{};
   std::vector<Configuration::NetworkFilterFactoryCb> filter_factories_;
   DrainManagerPtr local_drain_manager_;
+  Network::ConnectionRateLimiterSharedPtr connection_rate_limiter_;
   bool saw_listener_create_failure_{};
 };
 
@@ -51,7 +51,7 @@ InstanceImpl::InstanceImpl(Options& options, Network::Address::InstanceConstShar
       singleton_manager_(new Singleton::ManagerImpl()),
       handler_(new ConnectionHandlerImpl(ENVOY_LOGGER(), *dispatcher_)),
       listener_component_factory_(*this), worker_factory_(thread_local_, *api_, hooks),
-      dns_resolver_(dispatcher_->createDnsResolver({})),
+      dns_resolver_(dispatcher_->createDnsResolver({}, stats_store_)),
       access_log_manager_(*api_, *dispatcher_, access_log_lock, store) {
 
   try {
@@ -376,6 +376,7 @@ void InstanceImpl::run() {
 
   // Shutdown all the workers now that the main dispatch loop is done.
   listener_manager_->stopWorkers();
+  ssl_context_manager_->shutdown();
 
   // Only flush if we have not been hot restarted.
   if (stat_flush_timer_) {
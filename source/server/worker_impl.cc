@@ -43,11 +43,13 @@ void WorkerImpl::addListener(Listener& listener, AddListenerCompletion completio
 }
 
 void WorkerImpl::addListenerWorker(Listener& listener) {
-  const Network::ListenerOptions listener_options = {.bind_to_port_ = listener.bindToPort(),
-                                                     .use_proxy_proto_ = listener.useProxyProto(),
-                                                     .use_original_dst_ = listener.useOriginalDst(),
-                                                     .per_connection_buffer_limit_bytes_ =
-                                                         listener.perConnectionBufferLimitBytes()};
+  const Network::ListenerOptions listener_options = {
+      .bind_to_port_ = listener.bindToPort(),
+      .use_proxy_proto_ = listener.useProxyProto(),
+      .use_original_dst_ = listener.useOriginalDst(),
+      .per_connection_buffer_limit_bytes_ = listener.perConnectionBufferLimitBytes(),
+      .max_connections_per_accept_ = listener.maxConnectionsPerAccept(),
+      .connection_rate_limiter_ = listener.connectionRateLimiter()};
   if (listener.defaultSslContext()) {
     handler_->addSslListener(listener.filterChainFactory(), *listener.defaultSslContext(),
                              listener.socket(), listener.listenerScope(), listener.listenerTag(),
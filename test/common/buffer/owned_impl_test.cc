@@ -0,0 +1,78 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+#include "common/buffer/buffer_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class OwnedImplReadTest : public testing::Test {
+public:
+  OwnedImplReadTest() {
+    EXPECT_EQ(0, pipe(pipe_fds_));
+    EXPECT_EQ(0, fcntl(pipe_fds_[0], F_SETFL, O_NONBLOCK));
+  }
+
+  ~OwnedImplReadTest() {
+    close(pipe_fds_[0]);
+    if (pipe_fds_[1] != -1) {
+      close(pipe_fds_[1]);
+    }
+  }
+
+  int pipe_fds_[2] = {-1, -1};
+};
+
+// Reads append to what is already in the buffer, never exceed max_length and report EAGAIN once
+// there is nothing left to read.
+TEST_F(OwnedImplReadTest, Read) {
+  std::string data(50000, 'a');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = 'a' + i % 26;
+  }
+  ASSERT_EQ(static_cast<ssize_t>(data.size()), write(pipe_fds_[1], data.data(), data.size()));
+
+  OwnedImpl buffer("hello");
+  uint64_t bytes_read_total = 0;
+  int rc;
+  while ((rc = buffer.read(pipe_fds_[0], 16384)) > 0) {
+    EXPECT_LE(rc, 16384);
+    bytes_read_total += rc;
+  }
+  EXPECT_EQ(-1, rc);
+  EXPECT_EQ(EAGAIN, errno);
+  EXPECT_EQ(data.size(), bytes_read_total);
+  EXPECT_EQ("hello" + data, TestUtility::bufferToString(buffer));
+}
+
+TEST_F(OwnedImplReadTest, ReadMaxLength) {
+  ASSERT_EQ(10, write(pipe_fds_[1], "0123456789", 10));
+
+  OwnedImpl buffer;
+  EXPECT_EQ(0, buffer.read(pipe_fds_[0], 0));
+  EXPECT_EQ(3, buffer.read(pipe_fds_[0], 3));
+  EXPECT_EQ(3, buffer.length());
+  EXPECT_EQ(7, buffer.read(pipe_fds_[0], 16384));
+  EXPECT_EQ("0123456789", TestUtility::bufferToString(buffer));
+}
+
+TEST_F(OwnedImplReadTest, ReadEndOfFile) {
+  close(pipe_fds_[1]);
+  pipe_fds_[1] = -1;
+
+  OwnedImpl buffer;
+  EXPECT_EQ(0, buffer.read(pipe_fds_[0], 16384));
+  EXPECT_EQ(0, buffer.length());
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -91,9 +91,17 @@ public:
         response->add_resources()->PackFrom(*load_assignment);
       }
     }
-    EXPECT_CALL(callbacks_, onConfigUpdate(RepeatedProtoEq(typed_resources)))
-        .WillOnce(ThrowOnRejectedConfig(accept));
+    // Resources identical to the last accepted update are accepted without being delivered.
+    const std::string resources_string = RepeatedPtrUtil::debugString(typed_resources);
+    if (last_accepted_resources_.valid() && last_accepted_resources_.value() == resources_string) {
+      EXPECT_CALL(callbacks_, onConfigUpdate(_)).Times(0);
+      accept = true;
+    } else {
+      EXPECT_CALL(callbacks_, onConfigUpdate(RepeatedProtoEq(typed_resources)))
+          .WillOnce(ThrowOnRejectedConfig(accept));
+    }
     if (accept) {
+      last_accepted_resources_.value(resources_string);
       expectSendMessage(last_cluster_names_, version);
       version_ = version;
     } else {
@@ -128,6 +136,7 @@ public:
   std::unique_ptr<GrpcEdsSubscriptionImpl> subscription_;
   std::string last_response_nonce_;
   std::vector<std::string> last_cluster_names_;
+  Optional<std::string> last_accepted_resources_;
 };
 
 // TODO(danielhochman): test with RDS and ensure version_info is same as what API returned
@@ -21,8 +21,10 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::DoAll;
 using testing::MatchesRegex;
 using testing::NiceMock;
+using testing::Ref;
 using testing::Return;
 using testing::ReturnPointee;
 using testing::ReturnRef;
@@ -819,6 +821,50 @@ TEST_F(TcpProxyTest, AccessLogBytesRxTxDuration) {
                   "bytesreceived=1 bytessent=2 datetime=[0-9-]+T[0-9:.]+Z nonzeronum=[1-9][0-9]*"));
 }
 
+// Test that data is spliced between the connections when enabled at runtime, and that the bytes
+// moved by the connections are still accounted for.
+TEST_F(TcpProxyTest, Splice) {
+  setup(1, accessLogConfig("bytesreceived=%BYTES_RECEIVED% bytessent=%BYTES_SENT%"));
+
+  ON_CALL(factory_context_.runtime_loader_.snapshot_,
+          featureEnabled("tcp_proxy.splice_enabled", 0))
+      .WillByDefault(Return(true));
+  Network::Connection::BytesSplicedCb downstream_spliced_cb;
+  Network::Connection::BytesSplicedCb upstream_spliced_cb;
+  EXPECT_CALL(filter_callbacks_.connection_, spliceTo(Ref(*upstream_connections_.at(0)), _))
+      .WillOnce(DoAll(SaveArg<1>(&downstream_spliced_cb), Return(true)));
+  EXPECT_CALL(*upstream_connections_.at(0), spliceTo(Ref(filter_callbacks_.connection_), _))
+      .WillOnce(DoAll(SaveArg<1>(&upstream_spliced_cb), Return(true)));
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(1U, factory_context_.scope_.counter("tcp.name.downstream_cx_spliced").value());
+
+  downstream_spliced_cb(3);
+  upstream_spliced_cb(5);
+  upstream_spliced_cb(2);
+
+  upstream_connections_.at(0)->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  filter_.reset();
+
+  EXPECT_EQ("bytesreceived=3 bytessent=7", access_log_data_);
+}
+
+// Test that a connection which cannot be spliced keeps using the buffered path.
+TEST_F(TcpProxyTest, SpliceNotPossible) {
+  setup(1);
+
+  ON_CALL(factory_context_.runtime_loader_.snapshot_,
+          featureEnabled("tcp_proxy.splice_enabled", 0))
+      .WillByDefault(Return(true));
+  EXPECT_CALL(filter_callbacks_.connection_, spliceTo(_, _)).WillOnce(Return(false));
+  EXPECT_CALL(*upstream_connections_.at(0), spliceTo(_, _)).WillOnce(Return(false));
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, factory_context_.scope_.counter("tcp.name.downstream_cx_spliced").value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer)));
+  filter_->onData(buffer);
+}
+
 // Tests that upstream flush works properly with no idle timeout configured.
 TEST_F(TcpProxyTest, UpstreamFlushNoTimeout) {
   setup(1);
@@ -166,5 +166,59 @@ TEST(GrpcCodecTest, decodeMultipleFrame) {
   }
 }
 
+TEST(GrpcCodecTest, decodeByteAtATime) {
+  helloworld::HelloRequest request;
+  request.set_name("hello");
+
+  Buffer::OwnedImpl buffer;
+  std::array<uint8_t, 5> header;
+  Encoder encoder;
+  encoder.newFrame(GRPC_FH_DEFAULT, request.ByteSize(), header);
+  for (int i = 0; i < 2; i++) {
+    buffer.add(header.data(), 5);
+    buffer.add(request.SerializeAsString());
+  }
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  while (buffer.length() > 0) {
+    Buffer::OwnedImpl byte;
+    byte.move(buffer, 1);
+    EXPECT_TRUE(decoder.decode(byte, frames));
+    EXPECT_EQ(static_cast<size_t>(0), byte.length());
+  }
+
+  EXPECT_EQ(frames.size(), static_cast<uint64_t>(2));
+  for (Frame& frame : frames) {
+    EXPECT_EQ(GRPC_FH_DEFAULT, frame.flags_);
+    EXPECT_EQ(static_cast<uint64_t>(request.ByteSize()), frame.length_);
+
+    helloworld::HelloRequest result;
+    result.ParseFromArray(frame.data_->linearize(frame.data_->length()), frame.data_->length());
+    EXPECT_EQ("hello", result.name());
+  }
+}
+
+TEST(GrpcCodecTest, decodeInvalidFrameAfterValidFrame) {
+  helloworld::HelloRequest request;
+  request.set_name("hello");
+
+  Buffer::OwnedImpl buffer;
+  std::array<uint8_t, 5> header;
+  Encoder encoder;
+  encoder.newFrame(GRPC_FH_DEFAULT, request.ByteSize(), header);
+  buffer.add(header.data(), 5);
+  buffer.add(request.SerializeAsString());
+  encoder.newFrame(0b10u, request.ByteSize(), header);
+  buffer.add(header.data(), 5);
+  buffer.add(request.SerializeAsString());
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  EXPECT_FALSE(decoder.decode(buffer, frames));
+  EXPECT_EQ(frames.size(), static_cast<uint64_t>(1));
+  EXPECT_EQ(static_cast<size_t>(5 + request.ByteSize()), buffer.length());
+}
+
 } // namespace Grpc
 } // namespace Envoy
@@ -334,6 +334,50 @@ TEST_F(GrpcJsonTranscoderFilterTest, TranscodingUnaryError) {
   EXPECT_EQ(0, request_data.length());
 }
 
+TEST_F(GrpcJsonTranscoderFilterTest, TranscodingRequestBufferLimit) {
+  Http::TestHeaderMapImpl request_headers{
+      {"content-type", "application/json"}, {":method", "POST"}, {":path", "/shelf"}};
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+
+  ON_CALL(decoder_callbacks_, decoderBufferLimit()).WillByDefault(Return(8));
+  Buffer::OwnedImpl request_data{"{\"theme\": \"Children\""};
+
+  EXPECT_CALL(decoder_callbacks_, encodeHeaders_(_, false))
+      .WillOnce(Invoke([](Http::HeaderMap& headers, bool end_stream) {
+        EXPECT_STREQ("413", headers.Status()->value().c_str());
+        EXPECT_FALSE(end_stream);
+      }));
+  EXPECT_CALL(decoder_callbacks_, encodeData(_, true));
+
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer,
+            filter_.decodeData(request_data, false));
+  EXPECT_EQ(0, request_data.length());
+}
+
+TEST_F(GrpcJsonTranscoderFilterTest, TranscodingResponseBufferLimit) {
+  Http::TestHeaderMapImpl request_headers{
+      {"content-type", "application/json"}, {":method", "GET"}, {":path", "/authors/101"}};
+
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, true));
+
+  Http::TestHeaderMapImpl response_headers{{"content-type", "application/grpc"},
+                                           {":status", "200"}};
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_.encodeHeaders(response_headers, false));
+
+  // A frame header announcing a 100 byte message followed by only part of the message.
+  ON_CALL(encoder_callbacks_, encoderBufferLimit()).WillByDefault(Return(8));
+  const uint8_t frame_header[] = {0, 0, 0, 0, 100};
+  Buffer::OwnedImpl response_data;
+  response_data.add(frame_header, sizeof(frame_header));
+  response_data.add(std::string(16, 'a'));
+
+  EXPECT_CALL(encoder_callbacks_, resetStream());
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer,
+            filter_.encodeData(response_data, false));
+}
+
 struct GrpcJsonTranscoderFilterPrintTestParam {
   std::string config_json_;
   std::string expected_response_;
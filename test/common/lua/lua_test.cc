@@ -22,6 +22,9 @@ public:
   MOCK_METHOD1(doTestCall, int(lua_State* state));
   MOCK_METHOD0(onDestroy, void());
 
+  // Lets a test tie the lifetime of a coroutine to a Lua object.
+  CoroutinePtr coroutine_;
+
 private:
   DECLARE_LUA_FUNCTION(TestObject, luaTestCall);
 };
@@ -149,5 +152,89 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// Finished coroutines are returned to the pool and reused, errored coroutines are not.
+TEST_F(LuaTest, CoroutinePooling) {
+  const std::string SCRIPT{R"EOF(
+    function callMe()
+    end
+
+    function callMeError()
+      error("bad")
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  EXPECT_NE(LUA_REFNIL, state_->getGlobalRef(state_->registerGlobal("callMe")));
+  EXPECT_NE(LUA_REFNIL, state_->getGlobalRef(state_->registerGlobal("callMeError")));
+
+  CoroutinePtr cr1(state_->createCoroutine());
+  lua_State* cr1_state = cr1->luaState();
+  cr1->start(state_->getGlobalRef(0), 0, yield_callback_);
+  EXPECT_EQ(cr1->state(), Coroutine::State::Finished);
+  cr1.reset();
+
+  CoroutinePtr cr2(state_->createCoroutine());
+  EXPECT_EQ(cr1_state, cr2->luaState());
+  cr2->start(state_->getGlobalRef(0), 0, yield_callback_);
+  EXPECT_EQ(cr2->state(), Coroutine::State::Finished);
+  cr2.reset();
+
+  CoroutinePtr cr3(state_->createCoroutine());
+  EXPECT_EQ(cr1_state, cr3->luaState());
+  EXPECT_THROW_WITH_MESSAGE(cr3->start(state_->getGlobalRef(1), 0, yield_callback_), LuaException,
+                            "[string \"...\"]:6: bad");
+  cr3.reset();
+
+  CoroutinePtr cr4(state_->createCoroutine());
+  EXPECT_NE(cr1_state, cr4->luaState());
+}
+
+// A coroutine owned by a Lua object is destroyed while the state is closed, which must not return
+// its thread to the pool.
+TEST_F(LuaTest, CoroutineOwnedByObjectOnClose) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      saved = object
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  EXPECT_NE(LUA_REFNIL, state_->getGlobalRef(state_->registerGlobal("callMe")));
+
+  // The object is kept alive by a Lua global until the state is closed. The coroutine it owns
+  // never ran, so it would normally be returned to the pool.
+  CoroutinePtr cr(state_->createCoroutine());
+  TestObject* object = TestObject::create(cr->luaState()).first;
+  object->coroutine_ = state_->createCoroutine();
+  cr->start(state_->getGlobalRef(0), 1, yield_callback_);
+  EXPECT_EQ(cr->state(), Coroutine::State::Finished);
+  cr.reset();
+
+  EXPECT_CALL(*object, onDestroy());
+  state_.reset();
+}
+
+// Calling a method with a self argument of the wrong type raises a Lua error.
+TEST_F(LuaTest, WrongUserDataType) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(object)
+      object.testCall({})
+    end
+  )EOF"};
+
+  InSequence s;
+  setup(SCRIPT);
+  EXPECT_NE(LUA_REFNIL, state_->getGlobalRef(state_->registerGlobal("callMe")));
+
+  CoroutinePtr cr(state_->createCoroutine());
+  LuaRef<TestObject> ref(TestObject::create(cr->luaState()), true);
+  EXPECT_THROW(cr->start(state_->getGlobalRef(0), 1, yield_callback_), LuaException);
+
+  lua_gc(cr->luaState(), LUA_GCCOLLECT, 0);
+  EXPECT_CALL(*ref.get(), onDestroy());
+  ref.reset();
+  lua_gc(cr->luaState(), LUA_GCCOLLECT, 0);
+}
+
 } // namespace Lua
 } // namespace Envoy
@@ -27,6 +27,7 @@
 #include "gtest/gtest.h"
 
 using testing::AnyNumber;
+using testing::AtMost;
 using testing::DoAll;
 using testing::InSequence;
 using testing::Invoke;
@@ -575,6 +576,178 @@ TEST_P(ConnectionImplTest, BindFailureTest) {
   dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
 }
 
+TEST_P(ConnectionImplTest, SpliceNotPossible) {
+  setUpBasicConnection();
+  connect();
+
+  // A connection cannot splice to itself, and the client has no read filter yet.
+  EXPECT_FALSE(server_connection_->spliceTo(*server_connection_, [](uint64_t) {}));
+  EXPECT_FALSE(server_connection_->spliceTo(*client_connection_, [](uint64_t) {}));
+
+  // A write filter needs to see the data written to the client.
+  client_connection_->addReadFilter(std::make_shared<NiceMock<MockReadFilter>>());
+  client_connection_->addWriteFilter(std::make_shared<NiceMock<MockWriteFilter>>());
+  EXPECT_FALSE(server_connection_->spliceTo(*client_connection_, [](uint64_t) {}));
+
+  disconnect(true);
+}
+
+#ifdef __linux__
+// Proxy data from the first server connection to a second client connection, with the same flow
+// control the TCP proxy applies.
+TEST_P(ConnectionImplTest, Splice) {
+  setUpBasicConnection();
+  connect();
+
+  ClientConnectionPtr upstream_client =
+      dispatcher_->createClientConnection(socket_.localAddress(), source_address_);
+  upstream_client->addReadFilter(std::make_shared<NiceMock<MockReadFilter>>());
+  upstream_client->setBufferLimits(32 * 1024);
+  NiceMock<MockConnectionCallbacks> upstream_client_callbacks;
+  upstream_client->addConnectionCallbacks(upstream_client_callbacks);
+  ConnectionPtr upstream_server;
+  std::shared_ptr<MockReadFilter> upstream_server_filter(new NiceMock<MockReadFilter>());
+
+  int expected_callbacks = 2;
+  EXPECT_CALL(listener_callbacks_, onNewConnection_(_))
+      .WillOnce(Invoke([&](ConnectionPtr& conn) -> void {
+        upstream_server = std::move(conn);
+        upstream_server->addReadFilter(upstream_server_filter);
+        if (--expected_callbacks == 0) {
+          dispatcher_->exit();
+        }
+      }));
+  EXPECT_CALL(upstream_client_callbacks, onEvent(ConnectionEvent::Connected))
+      .WillOnce(Invoke([&](ConnectionEvent) -> void {
+        if (--expected_callbacks == 0) {
+          dispatcher_->exit();
+        }
+      }));
+  upstream_client->connect();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  ON_CALL(upstream_client_callbacks, onAboveWriteBufferHighWatermark())
+      .WillByDefault(Invoke([&]() -> void { server_connection_->readDisable(true); }));
+  ON_CALL(upstream_client_callbacks, onBelowWriteBufferLowWatermark())
+      .WillByDefault(Invoke([&]() -> void { server_connection_->readDisable(false); }));
+
+  uint64_t bytes_spliced = 0;
+  EXPECT_TRUE(server_connection_->spliceTo(
+      *upstream_client, [&](uint64_t bytes) -> void { bytes_spliced += bytes; }));
+  // Only one connection can splice to a destination.
+  EXPECT_FALSE(upstream_server->spliceTo(*upstream_client, [](uint64_t) {}));
+
+  std::string payload;
+  for (uint32_t i = 0; i < 1024 * 1024; ++i) {
+    payload.push_back('a' + i % 23);
+  }
+  std::string received;
+  EXPECT_CALL(*read_filter_, onData(_)).Times(0);
+  EXPECT_CALL(*upstream_server_filter, onData(_))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& data) -> FilterStatus {
+        received.append(TestUtility::bufferToString(data));
+        data.drain(data.length());
+        if (received.size() == payload.size()) {
+          dispatcher_->exit();
+        }
+        return FilterStatus::StopIteration;
+      }));
+
+  Buffer::OwnedImpl data(payload);
+  client_connection_->write(data);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(payload, received);
+  EXPECT_EQ(payload.size(), bytes_spliced);
+
+  upstream_client->close(ConnectionCloseType::NoFlush);
+  upstream_server->close(ConnectionCloseType::NoFlush);
+  disconnect(true);
+}
+
+// Data written to a connection after its source stopped splicing is sent after the data still in
+// the pipe.
+TEST_P(ConnectionImplTest, WriteAfterSpliceStops) {
+  setUpBasicConnection();
+  connect();
+
+  ClientConnectionPtr upstream_client =
+      dispatcher_->createClientConnection(socket_.localAddress(), source_address_);
+  upstream_client->addReadFilter(std::make_shared<NiceMock<MockReadFilter>>());
+  upstream_client->setBufferLimits(32 * 1024);
+  NiceMock<MockConnectionCallbacks> upstream_client_callbacks;
+  upstream_client->addConnectionCallbacks(upstream_client_callbacks);
+  ConnectionPtr upstream_server;
+  std::shared_ptr<MockReadFilter> upstream_server_filter(new NiceMock<MockReadFilter>());
+
+  int expected_callbacks = 2;
+  EXPECT_CALL(listener_callbacks_, onNewConnection_(_))
+      .WillOnce(Invoke([&](ConnectionPtr& conn) -> void {
+        upstream_server = std::move(conn);
+        upstream_server->addReadFilter(upstream_server_filter);
+        if (--expected_callbacks == 0) {
+          dispatcher_->exit();
+        }
+      }));
+  EXPECT_CALL(upstream_client_callbacks, onEvent(ConnectionEvent::Connected))
+      .WillOnce(Invoke([&](ConnectionEvent) -> void {
+        if (--expected_callbacks == 0) {
+          dispatcher_->exit();
+        }
+      }));
+  upstream_client->connect();
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Back up the upstream until the pipe holds more than the buffer limit.
+  upstream_server->readDisable(true);
+  ON_CALL(upstream_client_callbacks, onAboveWriteBufferHighWatermark())
+      .WillByDefault(Invoke([&]() -> void {
+        server_connection_->readDisable(true);
+        dispatcher_->exit();
+      }));
+
+  uint64_t bytes_spliced = 0;
+  EXPECT_TRUE(server_connection_->spliceTo(
+      *upstream_client, [&](uint64_t bytes) -> void { bytes_spliced += bytes; }));
+
+  std::string payload;
+  for (uint32_t i = 0; i < 16 * 1024 * 1024; ++i) {
+    payload.push_back('a' + i % 23);
+  }
+  Buffer::OwnedImpl data(payload);
+  client_connection_->write(data);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  // Closing the source stops splicing, but the destination keeps flushing the pipe.
+  EXPECT_CALL(server_callbacks_, onEvent(ConnectionEvent::LocalClose));
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::RemoteClose)).Times(AtMost(1));
+  EXPECT_CALL(client_callbacks_, onEvent(ConnectionEvent::LocalClose)).Times(AtMost(1));
+  server_connection_->close(ConnectionCloseType::NoFlush);
+
+  const std::string tail = "written after splicing";
+  Buffer::OwnedImpl tail_data(tail);
+  upstream_client->write(tail_data);
+
+  const std::string expected = payload.substr(0, bytes_spliced) + tail;
+  std::string received;
+  EXPECT_CALL(*upstream_server_filter, onData(_))
+      .WillRepeatedly(Invoke([&](Buffer::Instance& buffer) -> FilterStatus {
+        received.append(TestUtility::bufferToString(buffer));
+        buffer.drain(buffer.length());
+        if (received.size() == expected.size()) {
+          dispatcher_->exit();
+        }
+        return FilterStatus::StopIteration;
+      }));
+  upstream_server->readDisable(false);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(expected, received);
+
+  upstream_client->close(ConnectionCloseType::NoFlush);
+  upstream_server->close(ConnectionCloseType::NoFlush);
+  client_connection_->close(ConnectionCloseType::NoFlush);
+}
+#endif
+
 class ConnectionImplBytesSentTest : public testing::Test {
 public:
   ConnectionImplBytesSentTest() {
@@ -2,6 +2,7 @@
 #include <arpa/nameser.h>
 #include <arpa/nameser_compat.h>
 
+#include <chrono>
 #include <list>
 #include <memory>
 #include <string>
@@ -49,8 +50,9 @@ enum record_type { A, AAAA };
 
 class TestDnsServerQuery {
 public:
-  TestDnsServerQuery(ConnectionPtr connection, const HostMap& hosts_A, const HostMap& hosts_AAAA)
-      : connection_(std::move(connection)), hosts_A_(hosts_A), hosts_AAAA_(hosts_AAAA) {
+  TestDnsServerQuery(ConnectionPtr connection, const HostMap& hosts_A, const HostMap& hosts_AAAA,
+                     const std::chrono::seconds& ttl)
+      : connection_(std::move(connection)), hosts_A_(hosts_A), hosts_AAAA_(hosts_AAAA), ttl_(ttl) {
     connection_->addReadFilter(Network::ReadFilterSharedPtr{new ReadFilter(*this)});
   }
 
@@ -143,7 +145,7 @@ private:
           DNS_RR_SET_LEN(response_rr_fixed, sizeof(in6_addr));
         }
         DNS_RR_SET_CLASS(response_rr_fixed, C_IN);
-        DNS_RR_SET_TTL(response_rr_fixed, 0);
+        DNS_RR_SET_TTL(response_rr_fixed, parent_.ttl_.count());
 
         size_t response_rest_len;
         if (q_type == T_A) {
@@ -194,13 +196,14 @@ private:
   ConnectionPtr connection_;
   const HostMap& hosts_A_;
   const HostMap& hosts_AAAA_;
+  const std::chrono::seconds& ttl_;
 };
 
 class TestDnsServer : public ListenerCallbacks {
 public:
   void onNewConnection(ConnectionPtr&& new_connection) override {
     TestDnsServerQuery* query =
-        new TestDnsServerQuery(std::move(new_connection), hosts_A_, hosts_AAAA_);
+        new TestDnsServerQuery(std::move(new_connection), hosts_A_, hosts_AAAA_, ttl_);
     queries_.emplace_back(query);
   }
 
@@ -212,9 +215,13 @@ public:
     }
   }
 
+  // Set the TTL of the records in all responses.
+  void setTtl(const std::chrono::seconds& ttl) { ttl_ = ttl; }
+
 private:
   HostMap hosts_A_;
   HostMap hosts_AAAA_;
+  std::chrono::seconds ttl_{0};
   // All queries are tracked so we can do resource reclamation when the test is
   // over.
   std::vector<std::unique_ptr<TestDnsServerQuery>> queries_;
@@ -226,6 +233,14 @@ public:
   DnsResolverImplPeer(DnsResolverImpl* resolver) : resolver_(resolver) {}
   ares_channel channel() const { return resolver_->channel_; }
   const std::unordered_map<int, Event::FileEventPtr>& events() { return resolver_->events_; }
+  size_t cacheSize() const { return resolver_->cache_.size(); }
+  // Expire every cache entry, as if their TTLs had elapsed.
+  void expireCache() {
+    resolver_->cache_expiries_.clear();
+    for (auto& entry : resolver_->cache_) {
+      entry.second.expiry_ = resolver_->cache_expiries_.emplace(MonotonicTime(), entry.first);
+    }
+  }
   // Reset the channel state for a DnsResolverImpl such that it will only use
   // TCP and optionally has a zero timeout (for validating timeout behavior).
   void resetChannelTcpOnly(bool zero_timeout) {
@@ -254,7 +269,8 @@ TEST(DnsImplConstructor, SupportsCustomResolvers) {
   auto addr4 = Network::Utility::parseInternetAddressAndPort("127.0.0.1:54");
   char addr6str[INET6_ADDRSTRLEN];
   auto addr6 = Network::Utility::parseInternetAddressAndPort("[::1]:54");
-  auto resolver = dispatcher.createDnsResolver({addr4, addr6});
+  Stats::IsolatedStoreImpl stats_store;
+  auto resolver = dispatcher.createDnsResolver({addr4, addr6}, stats_store);
   auto peer = std::unique_ptr<DnsResolverImplPeer>{
       new DnsResolverImplPeer(dynamic_cast<DnsResolverImpl*>(resolver.get()))};
   ares_addr_port_node* resolvers;
@@ -273,7 +289,7 @@ TEST(DnsImplConstructor, SupportsCustomResolvers) {
 class DnsImplTest : public testing::TestWithParam<Address::IpVersion> {
 public:
   void SetUp() override {
-    resolver_ = dispatcher_.createDnsResolver({});
+    resolver_ = dispatcher_.createDnsResolver({}, stats_store_);
 
     // Instantiate TestDnsServer and listen on a random port on the loopback address.
     server_.reset(new TestDnsServer());
@@ -564,6 +580,130 @@ TEST_P(DnsImplTest, Cancel) {
   EXPECT_TRUE(hasAddress(address_list, "201.134.56.7"));
 }
 
+// Validate that resolutions are cached for the TTL of the records, per lookup family, and that
+// failures are not cached.
+TEST_P(DnsImplTest, CachedLookup) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, A);
+  server_->setTtl(std::chrono::seconds(300));
+  std::list<Address::InstanceConstSharedPtr> address_list;
+  EXPECT_NE(nullptr,
+            resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only,
+                               [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                 address_list = results;
+                                 dispatcher_.exit();
+                               }));
+
+  dispatcher_.run(Event::Dispatcher::RunType::Block);
+  EXPECT_TRUE(hasAddress(address_list, "201.134.56.7"));
+
+  address_list.clear();
+  EXPECT_EQ(nullptr,
+            resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only,
+                               [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                 address_list = results;
+                               }));
+  EXPECT_TRUE(hasAddress(address_list, "201.134.56.7"));
+  EXPECT_EQ(1UL, stats_store_.counter("dns.cache_hit").value());
+  EXPECT_EQ(1UL, stats_store_.counter("dns.cache_miss").value());
+
+  EXPECT_NE(nullptr,
+            resolver_->resolve("some.good.domain", DnsLookupFamily::Auto,
+                               [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                 address_list = results;
+                                 dispatcher_.exit();
+                               }));
+  dispatcher_.run(Event::Dispatcher::RunType::Block);
+  EXPECT_TRUE(hasAddress(address_list, "201.134.56.7"));
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_NE(nullptr,
+              resolver_->resolve("some.bad.domain", DnsLookupFamily::V4Only,
+                                 [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                   address_list = results;
+                                   dispatcher_.exit();
+                                 }));
+    dispatcher_.run(Event::Dispatcher::RunType::Block);
+    EXPECT_TRUE(address_list.empty());
+  }
+  EXPECT_EQ(1UL, stats_store_.counter("dns.cache_hit").value());
+  EXPECT_EQ(4UL, stats_store_.counter("dns.cache_miss").value());
+}
+
+// Validate that expired cache entries are removed when a resolution is cached, even if their
+// names are never resolved again.
+TEST_P(DnsImplTest, ExpiredCacheEntriesSwept) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, A);
+  server_->addHosts("other.good.domain", {"201.134.56.8"}, A);
+  server_->setTtl(std::chrono::seconds(300));
+  std::list<Address::InstanceConstSharedPtr> address_list;
+  for (const std::string name : {"some.good.domain", "other.good.domain"}) {
+    EXPECT_NE(nullptr,
+              resolver_->resolve(name, DnsLookupFamily::V4Only,
+                                 [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                   address_list = results;
+                                   dispatcher_.exit();
+                                 }));
+    dispatcher_.run(Event::Dispatcher::RunType::Block);
+    EXPECT_FALSE(address_list.empty());
+    if (name == "some.good.domain") {
+      EXPECT_EQ(1U, peer_->cacheSize());
+      peer_->expireCache();
+    }
+  }
+  EXPECT_EQ(1U, peer_->cacheSize());
+}
+
+// Validate that address literals resolve synchronously and honor the lookup family.
+TEST_P(DnsImplTest, LiteralLookupFamily) {
+  std::list<Address::InstanceConstSharedPtr> address_list;
+  auto callback = [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+    address_list = results;
+  };
+
+  EXPECT_EQ(nullptr, resolver_->resolve("1.2.3.4", DnsLookupFamily::V4Only, callback));
+  EXPECT_TRUE(hasAddress(address_list, "1.2.3.4"));
+  EXPECT_EQ(nullptr, resolver_->resolve("1.2.3.4", DnsLookupFamily::Auto, callback));
+  EXPECT_TRUE(hasAddress(address_list, "1.2.3.4"));
+  EXPECT_EQ(nullptr, resolver_->resolve("1.2.3.4", DnsLookupFamily::V6Only, callback));
+  EXPECT_TRUE(address_list.empty());
+
+  EXPECT_EQ(nullptr, resolver_->resolve("::2", DnsLookupFamily::V6Only, callback));
+  EXPECT_TRUE(hasAddress(address_list, "::2"));
+  EXPECT_EQ(nullptr, resolver_->resolve("::2", DnsLookupFamily::V4Only, callback));
+  EXPECT_TRUE(address_list.empty());
+  EXPECT_EQ(0UL, stats_store_.counter("dns.cache_miss").value());
+}
+
+// Validate that concurrent resolutions of the same name share a single query, and that cancelling
+// one of them doesn't affect the others.
+TEST_P(DnsImplTest, CoalescedLookup) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, A);
+  ActiveDnsQuery* cancelled =
+      resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only,
+                         [](std::list<Address::InstanceConstSharedPtr> &&) -> void { FAIL(); });
+  ASSERT_NE(nullptr, cancelled);
+
+  uint32_t completed = 0;
+  std::list<Address::InstanceConstSharedPtr> address_list;
+  for (int i = 0; i < 2; i++) {
+    EXPECT_NE(nullptr,
+              resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only,
+                                 [&](std::list<Address::InstanceConstSharedPtr>&& results) -> void {
+                                   address_list = results;
+                                   if (++completed == 2) {
+                                     dispatcher_.exit();
+                                   }
+                                 }));
+  }
+  cancelled->cancel();
+
+  dispatcher_.run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(2U, completed);
+  EXPECT_TRUE(hasAddress(address_list, "201.134.56.7"));
+  EXPECT_EQ(2UL, stats_store_.counter("dns.query_coalesced").value());
+  EXPECT_EQ(0UL, stats_store_.counter("dns.cache_hit").value());
+}
+
 class DnsImplZeroTimeoutTest : public DnsImplTest {
 protected:
   bool zero_timeout() const override { return true; }
@@ -595,7 +735,8 @@ TEST(DnsImplUnitTest, PendingTimerEnable) {
   Event::MockDispatcher dispatcher;
   Event::MockTimer* timer = new NiceMock<Event::MockTimer>();
   EXPECT_CALL(dispatcher, createTimer_(_)).WillOnce(Return(timer));
-  DnsResolverImpl resolver(dispatcher, {});
+  Stats::IsolatedStoreImpl stats_store;
+  DnsResolverImpl resolver(dispatcher, {}, stats_store);
   Event::FileEvent* file_event = new NiceMock<Event::MockFileEvent>();
   EXPECT_CALL(dispatcher, createFileEvent_(_, _, _, _)).WillOnce(Return(file_event));
   EXPECT_CALL(*timer, enableTimer(_));
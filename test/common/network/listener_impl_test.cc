@@ -1,4 +1,7 @@
+#include <vector>
+
 #include "common/network/address_impl.h"
+#include "common/network/connection_rate_limiter_impl.h"
 #include "common/network/listener_impl.h"
 #include "common/network/utility.h"
 #include "common/stats/stats_impl.h"
@@ -327,5 +330,113 @@ TEST_P(ListenerImplTest, WildcardListenerUseActualDst) {
   dispatcher.run(Event::Dispatcher::RunType::Block);
 }
 
+// Each wakeup accepts at most max_connections_per_accept_ connections, the rest are picked up on
+// later event loop iterations.
+TEST_P(ListenerImplTest, AcceptBudget) {
+  Stats::IsolatedStoreImpl stats_store;
+  Event::DispatcherImpl dispatcher;
+  Network::TcpListenSocket socket(Network::Test::getCanonicalLoopbackAddress(version_), true);
+  Network::MockListenerCallbacks listener_callbacks;
+  Network::MockConnectionHandler connection_handler;
+  Network::TestListenerImpl listener(connection_handler, dispatcher, socket, listener_callbacks,
+                                     stats_store,
+                                     {.bind_to_port_ = true,
+                                      .use_proxy_proto_ = false,
+                                      .use_original_dst_ = false,
+                                      .per_connection_buffer_limit_bytes_ = 0,
+                                      .max_connections_per_accept_ = 1,
+                                      .connection_rate_limiter_ = nullptr});
+
+  std::vector<Network::ClientConnectionPtr> client_connections;
+  for (int i = 0; i < 3; i++) {
+    client_connections.emplace_back(dispatcher.createClientConnection(
+        socket.localAddress(), Network::Address::InstanceConstSharedPtr()));
+    client_connections.back()->connect();
+  }
+
+  std::vector<Network::ConnectionPtr> server_connections;
+  EXPECT_CALL(listener, newConnection(_, _, _, _)).Times(3);
+  EXPECT_CALL(listener_callbacks, onNewConnection_(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](Network::ConnectionPtr& conn) -> void {
+        server_connections.emplace_back(std::move(conn));
+        if (server_connections.size() == 3) {
+          dispatcher.exit();
+        }
+      }));
+
+  dispatcher.run(Event::Dispatcher::RunType::Block);
+
+  // The first two wakeups left connections behind, the last one took the last connection.
+  EXPECT_EQ(2UL, stats_store.counter("downstream_cx_accept_budget_exhausted").value());
+  for (auto& connection : client_connections) {
+    connection->close(ConnectionCloseType::NoFlush);
+  }
+  for (auto& connection : server_connections) {
+    connection->close(ConnectionCloseType::NoFlush);
+  }
+}
+
+// Connections above the rate limit wait in the kernel backlog until the limiter allows them.
+TEST_P(ListenerImplTest, ConnectionRateLimit) {
+  ConnectionRateLimiterSharedPtr limiter(new ConnectionRateLimiterImpl(2));
+  Stats::IsolatedStoreImpl stats_store;
+  Event::DispatcherImpl dispatcher;
+  Network::TcpListenSocket socket(Network::Test::getCanonicalLoopbackAddress(version_), true);
+  Network::MockListenerCallbacks listener_callbacks;
+  Network::MockConnectionHandler connection_handler;
+  Network::TestListenerImpl listener(connection_handler, dispatcher, socket, listener_callbacks,
+                                     stats_store,
+                                     {.bind_to_port_ = true,
+                                      .use_proxy_proto_ = false,
+                                      .use_original_dst_ = false,
+                                      .per_connection_buffer_limit_bytes_ = 0,
+                                      .max_connections_per_accept_ = 0,
+                                      .connection_rate_limiter_ = limiter});
+
+  std::vector<Network::ClientConnectionPtr> client_connections;
+  for (int i = 0; i < 3; i++) {
+    client_connections.emplace_back(dispatcher.createClientConnection(
+        socket.localAddress(), Network::Address::InstanceConstSharedPtr()));
+    client_connections.back()->connect();
+  }
+
+  std::vector<Network::ConnectionPtr> server_connections;
+  EXPECT_CALL(listener, newConnection(_, _, _, _)).Times(3);
+  EXPECT_CALL(listener_callbacks, onNewConnection_(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](Network::ConnectionPtr& conn) -> void {
+        server_connections.emplace_back(std::move(conn));
+        if (server_connections.size() == 3) {
+          dispatcher.exit();
+        }
+      }));
+
+  dispatcher.run(Event::Dispatcher::RunType::Block);
+
+  // The two connection burst is used up right away, so the third connection had to wait.
+  EXPECT_LE(1UL, stats_store.counter("downstream_cx_accept_rate_limited").value());
+  for (auto& connection : client_connections) {
+    connection->close(ConnectionCloseType::NoFlush);
+  }
+  for (auto& connection : server_connections) {
+    connection->close(ConnectionCloseType::NoFlush);
+  }
+}
+
+// A refunded token can be consumed again, but the bucket never holds more than a second's worth.
+TEST(ConnectionRateLimiterImplTest, Refund) {
+  ConnectionRateLimiterImpl limiter(2);
+  limiter.refund();
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(0, limiter.consume().count());
+  }
+  EXPECT_LT(0, limiter.consume().count());
+
+  limiter.refund();
+  EXPECT_EQ(0, limiter.consume().count());
+  EXPECT_LT(0, limiter.consume().count());
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -282,6 +282,149 @@ TEST_P(ProxyProtocolTest, ClosedEmpty) {
   dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
 }
 
+namespace {
+
+const std::string V2_SIGNATURE("\r\n\r\n\0\r\nQUIT\n", 12);
+
+// PROXY TCP4 1.2.3.4 0.1.2.3 1234 5678
+const std::string V2_TCP4_ADDRESSES("\x01\x02\x03\x04\x00\x01\x02\x03\x04\xd2\x16\x2e", 12);
+
+} // namespace
+
+TEST_P(ProxyProtocolTest, V2Basic) {
+  connect();
+  write(V2_SIGNATURE + std::string("\x21\x11\x00\x0c", 4) + V2_TCP4_ADDRESSES + "more data");
+
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> FilterStatus {
+        EXPECT_EQ(server_connection_->remoteAddress()->asString(), "1.2.3.4:1234");
+
+        EXPECT_EQ(TestUtility::bufferToString(buffer), "more data");
+        buffer.drain(9);
+        return Network::FilterStatus::Continue;
+      }));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  disconnect();
+}
+
+TEST_P(ProxyProtocolTest, V2BasicV6) {
+  connect();
+  // PROXY TCP6 1:2:3::4 5:6::7:8 1234 5678
+  write(V2_SIGNATURE + std::string("\x21\x21\x00\x24", 4) +
+        std::string("\x00\x01\x00\x02\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00\x04", 16) +
+        std::string("\x00\x05\x00\x06\x00\x00\x00\x00\x00\x00\x00\x00\x00\x07\x00\x08", 16) +
+        std::string("\x04\xd2\x16\x2e", 4) + "more data");
+
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> FilterStatus {
+        EXPECT_EQ(server_connection_->remoteAddress()->asString(), "[1:2:3::4]:1234");
+
+        EXPECT_EQ(TestUtility::bufferToString(buffer), "more data");
+        buffer.drain(9);
+        return Network::FilterStatus::Continue;
+      }));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  disconnect();
+}
+
+TEST_P(ProxyProtocolTest, V2Fragmented) {
+  const std::string header = V2_SIGNATURE + std::string("\x21\x11\x00\x0c", 4) + V2_TCP4_ADDRESSES;
+
+  connect();
+  write(header.substr(0, 5));
+  write(header.substr(5, 10));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  write(header.substr(15));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  disconnect();
+
+  EXPECT_EQ(server_connection_->remoteAddress()->ip()->addressAsString(), "1.2.3.4");
+}
+
+// TLVs following the addresses are read and discarded, even when they don't fit in the buffer.
+TEST_P(ProxyProtocolTest, V2Tlvs) {
+  connect();
+  write(V2_SIGNATURE + std::string("\x21\x11\x03\x0c", 4) + V2_TCP4_ADDRESSES);
+  write(std::string("\x02\x02\xfd", 3) + std::string(0x2fd, 'a'));
+  write("more data");
+
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> FilterStatus {
+        EXPECT_EQ(server_connection_->remoteAddress()->asString(), "1.2.3.4:1234");
+
+        EXPECT_EQ(TestUtility::bufferToString(buffer), "more data");
+        buffer.drain(9);
+        return Network::FilterStatus::Continue;
+      }));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  disconnect();
+}
+
+// A LOCAL command keeps the addresses of the connection itself.
+TEST_P(ProxyProtocolTest, V2Local) {
+  connect();
+  write(V2_SIGNATURE + std::string("\x20\x00\x00\x00", 4) + "more data");
+
+  EXPECT_CALL(*read_filter_, onNewConnection());
+  EXPECT_CALL(*read_filter_, onData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& buffer) -> FilterStatus {
+        EXPECT_EQ(server_connection_->remoteAddress()->ip()->addressAsString(),
+                  conn_->localAddress()->ip()->addressAsString());
+
+        EXPECT_EQ(TestUtility::bufferToString(buffer), "more data");
+        buffer.drain(9);
+        return Network::FilterStatus::Continue;
+      }));
+
+  dispatcher_.run(Event::Dispatcher::RunType::NonBlock);
+
+  disconnect();
+}
+
+TEST_P(ProxyProtocolTest, V2BadSignature) {
+  connectNoRead();
+  write(std::string("\r\n\r\n\0\r\nQUIX\n", 12) + std::string("\x21\x11\x00\x0c", 4) +
+        V2_TCP4_ADDRESSES);
+  expectProxyProtoError();
+}
+
+TEST_P(ProxyProtocolTest, V2BadVersion) {
+  connectNoRead();
+  write(V2_SIGNATURE + std::string("\x11\x11\x00\x0c", 4) + V2_TCP4_ADDRESSES);
+  expectProxyProtoError();
+}
+
+TEST_P(ProxyProtocolTest, V2BadCommand) {
+  connectNoRead();
+  write(V2_SIGNATURE + std::string("\x22\x11\x00\x0c", 4) + V2_TCP4_ADDRESSES);
+  expectProxyProtoError();
+}
+
+TEST_P(ProxyProtocolTest, V2UnsupportedProto) {
+  connectNoRead();
+  write(V2_SIGNATURE + std::string("\x21\x12\x00\x0c", 4) + V2_TCP4_ADDRESSES);
+  expectProxyProtoError();
+}
+
+TEST_P(ProxyProtocolTest, V2AddressesTooShort) {
+  connectNoRead();
+  write(V2_SIGNATURE + std::string("\x21\x11\x00\x04", 4) + V2_TCP4_ADDRESSES.substr(0, 4));
+  expectProxyProtoError();
+}
+
 class WildcardProxyProtocolTest : public testing::TestWithParam<Address::IpVersion> {
 public:
   WildcardProxyProtocolTest()
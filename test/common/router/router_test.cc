@@ -56,6 +56,42 @@ public:
   MockRetryState* retry_state_{};
 };
 
+class MockAdaptiveResource : public Upstream::AdaptiveResource {
+public:
+  MockAdaptiveResource() {
+    ON_CALL(*this, enabled()).WillByDefault(Return(true));
+    ON_CALL(*this, canCreate()).WillByDefault(Return(true));
+  }
+
+  // Upstream::Resource
+  MOCK_METHOD0(canCreate, bool());
+  MOCK_METHOD0(inc, void());
+  MOCK_METHOD0(dec, void());
+  MOCK_METHOD0(max, uint64_t());
+
+  // Upstream::AdaptiveResource
+  MOCK_METHOD0(enabled, bool());
+  MOCK_METHOD1(recordResponseTime, void(std::chrono::milliseconds response_time));
+  MOCK_METHOD1(recordFailure, void(std::chrono::milliseconds response_time));
+};
+
+// Forwards to a resource manager, except for the adaptive concurrency limit which is mocked.
+class AdaptiveResourceManager : public Upstream::ResourceManager {
+public:
+  AdaptiveResourceManager(std::unique_ptr<Upstream::ResourceManager>&& parent)
+      : parent_(std::move(parent)) {}
+
+  // Upstream::ResourceManager
+  Upstream::Resource& connections() override { return parent_->connections(); }
+  Upstream::Resource& pendingRequests() override { return parent_->pendingRequests(); }
+  Upstream::Resource& requests() override { return parent_->requests(); }
+  Upstream::Resource& retries() override { return parent_->retries(); }
+  Upstream::AdaptiveResource& adaptiveRequests() override { return adaptive_requests_; }
+
+  std::unique_ptr<Upstream::ResourceManager> parent_;
+  NiceMock<MockAdaptiveResource> adaptive_requests_;
+};
+
 class RouterTestBase : public testing::Test {
 public:
   RouterTestBase(bool start_child_span)
@@ -68,6 +104,13 @@ public:
 
     ON_CALL(*cm_.conn_pool_.host_, address()).WillByDefault(Return(host_address_));
     ON_CALL(*cm_.conn_pool_.host_, locality()).WillByDefault(ReturnRef(upstream_locality_));
+    ON_CALL(cm_, recordLoadReport(_, _))
+        .WillByDefault(Invoke(
+            [this](const Upstream::HostDescriptionConstSharedPtr& host, bool success) -> void {
+              if (host == cm_.conn_pool_.host_) {
+                success ? host_rq_success_++ : host_rq_error_++;
+              }
+            }));
     router_.downstream_connection_.local_address_ = host_address_;
     router_.downstream_connection_.remote_address_ =
         Network::Utility::parseInternetAddressAndPort("1.2.3.4:80");
@@ -86,15 +129,13 @@ public:
   }
 
   AssertionResult verifyHostUpstreamStats(uint64_t success, uint64_t error) {
-    if (success != cm_.conn_pool_.host_->stats_store_.counter("rq_success").value()) {
-      return AssertionFailure() << fmt::format(
-                 "rq_success {} does not match expected {}",
-                 cm_.conn_pool_.host_->stats_store_.counter("rq_success").value(), success);
+    if (success != host_rq_success_) {
+      return AssertionFailure() << fmt::format("rq_success {} does not match expected {}",
+                                               host_rq_success_, success);
     }
-    if (error != cm_.conn_pool_.host_->stats_store_.counter("rq_error").value()) {
-      return AssertionFailure() << fmt::format(
-                 "rq_error {} does not match expected {}",
-                 cm_.conn_pool_.host_->stats_store_.counter("rq_error").value(), error);
+    if (error != host_rq_error_) {
+      return AssertionFailure() << fmt::format("rq_error {} does not match expected {}",
+                                               host_rq_error_, error);
     }
     return AssertionSuccess();
   }
@@ -113,6 +154,9 @@ public:
   TestFilter router_;
   Event::MockTimer* response_timeout_{};
   Event::MockTimer* per_try_timeout_{};
+  // Load reports recorded for the upstream host.
+  uint64_t host_rq_success_{};
+  uint64_t host_rq_error_{};
   Network::Address::InstanceConstSharedPtr host_address_{
       Network::Utility::resolveUrl("tcp://10.0.0.5:9211")};
 };
@@ -481,6 +525,148 @@ TEST_F(RouterTest, MaintenanceMode) {
                     .value());
 }
 
+TEST_F(RouterTest, AdaptiveConcurrencyLimited) {
+  ON_CALL(cm_.thread_local_cluster_.cluster_.info_->runtime_.snapshot_,
+          getInteger("fake_keyadaptive_concurrency.enabled", 0))
+      .WillByDefault(Return(1));
+  ON_CALL(cm_.thread_local_cluster_.cluster_.info_->runtime_.snapshot_,
+          getInteger("fake_keymax_requests", 1024))
+      .WillByDefault(Return(0));
+  EXPECT_CALL(cm_, httpConnPoolForCluster(_, _, _)).Times(0);
+
+  Http::TestHeaderMapImpl response_headers{{":status", "503"},
+                                           {"content-length", "26"},
+                                           {"content-type", "text/plain"},
+                                           {"x-envoy-overloaded", "true"}};
+  EXPECT_CALL(callbacks_, encodeHeaders_(HeaderMapEqualRef(&response_headers), false));
+  EXPECT_CALL(callbacks_, encodeData(_, true));
+  EXPECT_CALL(callbacks_.request_info_,
+              setResponseFlag(RequestInfo::ResponseFlag::UpstreamOverflow));
+
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("upstream_rq_concurrency_limited")
+                    .value());
+  EXPECT_TRUE(verifyHostUpstreamStats(0, 0));
+}
+
+TEST_F(RouterTest, AdaptiveConcurrencyAdmitted) {
+  ON_CALL(cm_.thread_local_cluster_.cluster_.info_->runtime_.snapshot_,
+          getInteger("fake_keyadaptive_concurrency.enabled", 0))
+      .WillByDefault(Return(1));
+  ON_CALL(cm_.thread_local_cluster_.cluster_.info_->runtime_.snapshot_,
+          getInteger("fake_keymax_requests", 1024))
+      .WillByDefault(Return(1));
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _)).WillOnce(Return(&cancellable_));
+  expectResponseTimerCreate();
+
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+
+  // The request holds the only slot until the filter is destroyed.
+  Upstream::AdaptiveResource& adaptive_requests =
+      cm_.thread_local_cluster_.cluster_.info_->resource_manager_->adaptiveRequests();
+  EXPECT_FALSE(adaptive_requests.canCreate());
+
+  EXPECT_CALL(cancellable_, cancel());
+  router_.onDestroy();
+  EXPECT_TRUE(adaptive_requests.canCreate());
+}
+
+// A reset is recorded with the adaptive concurrency limit as a failure.
+TEST_F(RouterTest, AdaptiveConcurrencyUpstreamReset) {
+  Upstream::MockClusterInfo& cluster_info = *cm_.thread_local_cluster_.cluster_.info_;
+  AdaptiveResourceManager* resource_manager =
+      new AdaptiveResourceManager(std::move(cluster_info.resource_manager_));
+  cluster_info.resource_manager_.reset(resource_manager);
+
+  NiceMock<Http::MockStreamEncoder> encoder;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolReady(encoder, cm_.conn_pool_.host_);
+        return nullptr;
+      }));
+  expectResponseTimerCreate();
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, inc());
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, recordResponseTime(_)).Times(0);
+  EXPECT_CALL(resource_manager->adaptive_requests_, recordFailure(_));
+  EXPECT_CALL(resource_manager->adaptive_requests_, dec());
+  EXPECT_CALL(cm_.conn_pool_.host_->outlier_detector_, putHttpResponseCode(503));
+  encoder.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+  EXPECT_TRUE(verifyHostUpstreamStats(0, 1));
+}
+
+// A reset on a route without a timeout is still recorded as a failure, so that fast resets can't
+// raise the adaptive concurrency limit.
+TEST_F(RouterTest, AdaptiveConcurrencyUpstreamResetNoTimeout) {
+  Upstream::MockClusterInfo& cluster_info = *cm_.thread_local_cluster_.cluster_.info_;
+  AdaptiveResourceManager* resource_manager =
+      new AdaptiveResourceManager(std::move(cluster_info.resource_manager_));
+  cluster_info.resource_manager_.reset(resource_manager);
+
+  EXPECT_CALL(callbacks_.route_->route_entry_, timeout())
+      .WillOnce(Return(std::chrono::milliseconds(0)));
+  EXPECT_CALL(callbacks_.dispatcher_, createTimer_(_)).Times(0);
+
+  NiceMock<Http::MockStreamEncoder> encoder;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolReady(encoder, cm_.conn_pool_.host_);
+        return nullptr;
+      }));
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, inc());
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, recordResponseTime(_)).Times(0);
+  EXPECT_CALL(resource_manager->adaptive_requests_, recordFailure(_));
+  EXPECT_CALL(resource_manager->adaptive_requests_, dec());
+  EXPECT_CALL(cm_.conn_pool_.host_->outlier_detector_, putHttpResponseCode(503));
+  encoder.stream_.resetStream(Http::StreamResetReason::RemoteReset);
+  EXPECT_TRUE(verifyHostUpstreamStats(0, 1));
+}
+
+// A timed out request is recorded with the adaptive concurrency limit.
+TEST_F(RouterTest, AdaptiveConcurrencyUpstreamTimeout) {
+  Upstream::MockClusterInfo& cluster_info = *cm_.thread_local_cluster_.cluster_.info_;
+  AdaptiveResourceManager* resource_manager =
+      new AdaptiveResourceManager(std::move(cluster_info.resource_manager_));
+  cluster_info.resource_manager_.reset(resource_manager);
+
+  NiceMock<Http::MockStreamEncoder> encoder;
+  EXPECT_CALL(cm_.conn_pool_, newStream(_, _))
+      .WillOnce(Invoke([&](Http::StreamDecoder&, Http::ConnectionPool::Callbacks& callbacks)
+                           -> Http::ConnectionPool::Cancellable* {
+        callbacks.onPoolReady(encoder, cm_.conn_pool_.host_);
+        return nullptr;
+      }));
+  expectResponseTimerCreate();
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, inc());
+  Http::TestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_.decodeHeaders(headers, true);
+
+  EXPECT_CALL(resource_manager->adaptive_requests_, recordResponseTime(_));
+  EXPECT_CALL(resource_manager->adaptive_requests_, dec());
+  EXPECT_CALL(encoder.stream_, resetStream(Http::StreamResetReason::LocalReset));
+  EXPECT_CALL(cm_.conn_pool_.host_->outlier_detector_, putHttpResponseCode(504));
+  response_timeout_->callback_();
+  EXPECT_TRUE(verifyHostUpstreamStats(0, 1));
+}
+
 TEST_F(RouterTest, NoRetriesOverflow) {
   NiceMock<Http::MockStreamEncoder> encoder1;
   Http::StreamDecoder* response_decoder = nullptr;
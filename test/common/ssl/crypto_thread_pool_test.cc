@@ -0,0 +1,73 @@
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "common/ssl/crypto_thread_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Ssl {
+
+TEST(CryptoThreadPoolTest, RunsOperations) {
+  std::atomic<uint32_t> ran{0};
+  {
+    CryptoThreadPool pool(4, 1000);
+    for (uint32_t i = 0; i < 1000; i++) {
+      EXPECT_TRUE(pool.post([&ran]() -> void { ran++; }));
+    }
+  }
+  // The destructor runs whatever is still queued before joining the threads.
+  EXPECT_EQ(1000U, ran.load());
+}
+
+TEST(CryptoThreadPoolTest, Shutdown) {
+  std::atomic<uint32_t> ran{0};
+  CryptoThreadPool pool(2, 100);
+  for (uint32_t i = 0; i < 100; i++) {
+    EXPECT_TRUE(pool.post([&ran]() -> void { ran++; }));
+  }
+  pool.shutdown();
+  EXPECT_EQ(100U, ran.load());
+
+  // Operations posted afterwards are refused, so callers run them inline.
+  EXPECT_FALSE(pool.post([&ran]() -> void { ran++; }));
+  EXPECT_EQ(100U, ran.load());
+}
+
+TEST(CryptoThreadPoolTest, FullQueue) {
+  std::mutex lock;
+  std::condition_variable event;
+  bool started = false;
+  bool release = false;
+  std::atomic<uint32_t> ran{0};
+  {
+    CryptoThreadPool pool(1, 2);
+
+    // Block the only thread so that further operations stay queued.
+    EXPECT_TRUE(pool.post([&]() -> void {
+      std::unique_lock<std::mutex> guard(lock);
+      started = true;
+      event.notify_all();
+      event.wait(guard, [&]() -> bool { return release; });
+    }));
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      event.wait(guard, [&]() -> bool { return started; });
+    }
+
+    EXPECT_TRUE(pool.post([&ran]() -> void { ran++; }));
+    EXPECT_TRUE(pool.post([&ran]() -> void { ran++; }));
+    EXPECT_FALSE(pool.post([&ran]() -> void { ran++; }));
+
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      release = true;
+    }
+    event.notify_all();
+  }
+  EXPECT_EQ(2U, ran.load());
+}
+
+} // namespace Ssl
+} // namespace Envoy
@@ -0,0 +1,93 @@
+#include <string>
+
+#include "common/ssl/server_name_index.h"
+
+#include "test/mocks/ssl/mocks.h"
+
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Ssl {
+
+TEST(ServerNameIndexTest, Empty) {
+  ServerNameIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(nullptr, index.find("www.example.com"));
+  EXPECT_EQ(nullptr, index.find(""));
+}
+
+TEST(ServerNameIndexTest, Precedence) {
+  MockServerContext exact, wildcard, no_sni;
+  ServerNameIndex index;
+  index.add("www.example.com", &exact);
+  index.add("*.example.com", &wildcard);
+
+  EXPECT_EQ(&exact, index.find("www.example.com"));
+  EXPECT_EQ(&wildcard, index.find("api.example.com"));
+  EXPECT_EQ(nullptr, index.find("example.com"));
+  EXPECT_EQ(nullptr, index.find("www.example.org"));
+
+  index.add("", &no_sni);
+  EXPECT_EQ(&no_sni, index.find("example.com"));
+  EXPECT_EQ(&no_sni, index.find("www.example.org"));
+  EXPECT_EQ(&no_sni, index.find(""));
+}
+
+// Wildcards match exactly one label.
+TEST(ServerNameIndexTest, WildcardSingleLabel) {
+  MockServerContext wildcard, nested;
+  ServerNameIndex index;
+  index.add("*.example.com", &wildcard);
+  index.add("*.api.example.com", &nested);
+
+  EXPECT_EQ(&wildcard, index.find("api.example.com"));
+  EXPECT_EQ(&nested, index.find("v1.api.example.com"));
+  EXPECT_EQ(nullptr, index.find("a.b.example.com"));
+  EXPECT_EQ(nullptr, index.find(".example.com"));
+  EXPECT_EQ(nullptr, index.find("www."));
+  EXPECT_EQ(nullptr, index.find("com"));
+}
+
+TEST(ServerNameIndexTest, Remove) {
+  MockServerContext first, second;
+  ServerNameIndex index;
+  index.add("*.example.com", &first);
+  index.add("*.api.example.com", &first);
+  index.add("example.com", &first);
+
+  // A name remapped to another context is not removed on behalf of the old one.
+  index.add("example.com", &second);
+  index.remove("example.com", &first);
+  EXPECT_EQ(&second, index.find("example.com"));
+  index.remove("example.com", &second);
+  EXPECT_EQ(nullptr, index.find("example.com"));
+
+  index.remove("*.example.com", &first);
+  EXPECT_EQ(nullptr, index.find("www.example.com"));
+  EXPECT_EQ(&first, index.find("v1.api.example.com"));
+
+  index.remove("*.other.com", &first);
+  index.remove("*.api.example.com", &first);
+  EXPECT_EQ(nullptr, index.find("v1.api.example.com"));
+  EXPECT_TRUE(index.empty());
+}
+
+// A listener serving many certificates still resolves every name to its own context.
+TEST(ServerNameIndexTest, ManyNames) {
+  MockServerContext contexts[2];
+  ServerNameIndex index;
+  for (uint32_t i = 0; i < 10000; i++) {
+    index.add(fmt::format("www.tenant{}.example.com", i), &contexts[0]);
+    index.add(fmt::format("*.tenant{}.example.com", i), &contexts[1]);
+  }
+
+  for (uint32_t i = 0; i < 10000; i++) {
+    EXPECT_EQ(&contexts[0], index.find(fmt::format("www.tenant{}.example.com", i)));
+    EXPECT_EQ(&contexts[1], index.find(fmt::format("api.tenant{}.example.com", i)));
+  }
+  EXPECT_EQ(nullptr, index.find("api.tenant10000.example.com"));
+}
+
+} // namespace Ssl
+} // namespace Envoy
@@ -0,0 +1,82 @@
+#include <string>
+
+#include "common/ssl/session_cache.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Ssl {
+
+class SessionCacheTest : public testing::Test {
+public:
+  SessionCacheTest() : ctx_(SSL_CTX_new(TLS_method())) {}
+
+  bssl::UniquePtr<SSL_SESSION> newSession() {
+    return bssl::UniquePtr<SSL_SESSION>(SSL_SESSION_new(ctx_.get()));
+  }
+
+  bssl::UniquePtr<SSL_CTX> ctx_;
+};
+
+TEST_F(SessionCacheTest, InsertLookupRemove) {
+  SessionCache cache;
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+
+  bssl::UniquePtr<SSL_SESSION> session = newSession();
+  SSL_SESSION* raw_session = session.get();
+  cache.insert("a", std::move(session));
+  EXPECT_EQ(1U, cache.size());
+
+  // Lookups hand out a new reference, the session stays cached.
+  bssl::UniquePtr<SSL_SESSION> found = cache.lookup("a");
+  EXPECT_EQ(raw_session, found.get());
+  EXPECT_EQ(raw_session, cache.lookup("a").get());
+  EXPECT_EQ(nullptr, cache.lookup("b"));
+
+  cache.remove("b");
+  EXPECT_EQ(1U, cache.size());
+  cache.remove("a");
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup("a"));
+}
+
+TEST_F(SessionCacheTest, Replace) {
+  SessionCache cache;
+  cache.insert("a", newSession());
+  bssl::UniquePtr<SSL_SESSION> session = newSession();
+  SSL_SESSION* raw_session = session.get();
+  cache.insert("a", std::move(session));
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_EQ(raw_session, cache.lookup("a").get());
+}
+
+// Each shard evicts its least recently used session once it is full, so the cache never holds
+// more than its capacity.
+TEST_F(SessionCacheTest, Eviction) {
+  SessionCache cache(SessionCache::NUM_SHARDS);
+  for (int i = 0; i < 1000; i++) {
+    cache.insert(std::to_string(i), newSession());
+    EXPECT_LE(cache.size(), 16U);
+  }
+  EXPECT_NE(nullptr, cache.lookup("999"));
+  EXPECT_EQ(nullptr, cache.lookup("0"));
+}
+
+TEST_F(SessionCacheTest, LookupRefreshesSession) {
+  // Two sessions per shard.
+  SessionCache cache(SessionCache::NUM_SHARDS * 2);
+  cache.insert("a", newSession());
+
+  // Keep looking up "a" while filling the cache, it must survive as the most recently used
+  // session of its shard.
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_NE(nullptr, cache.lookup("a"));
+    cache.insert(std::to_string(i), newSession());
+  }
+  EXPECT_NE(nullptr, cache.lookup("a"));
+  EXPECT_LE(cache.size(), SessionCache::NUM_SHARDS * 2);
+}
+
+} // namespace Ssl
+} // namespace Envoy
@@ -1,6 +1,9 @@
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/buffer/buffer_impl.h"
 #include "common/common/empty_string.h"
@@ -29,6 +32,7 @@
 #include "openssl/ssl.h"
 
 using testing::Invoke;
+using testing::Return;
 using testing::StrictMock;
 using testing::_;
 
@@ -557,11 +561,13 @@ TEST_P(SslSocketTest, ClientAuthMultipleCAs) {
 
 namespace {
 
-// Test connecting with a client to server1, then trying to reuse the session on server2
+// Test connecting with a client to server1, then trying to reuse the session on server2. Without
+// session tickets the session is resumed by ID from the session cache shared by both servers.
 void testTicketSessionResumption(const std::string& server_ctx_json1,
                                  const std::string& server_ctx_json2,
                                  const std::string& client_ctx_json, bool expect_reuse,
-                                 const Network::Address::IpVersion ip_version) {
+                                 const Network::Address::IpVersion ip_version,
+                                 bool session_tickets = true) {
   Stats::IsolatedStoreImpl stats_store;
   Runtime::MockLoader runtime;
 
@@ -593,6 +599,11 @@ void testTicketSessionResumption(const std::string& server_ctx_json1,
   Network::ClientConnectionPtr client_connection = dispatcher.createSslClientConnection(
       *client_ctx, socket1.localAddress(), Network::Address::InstanceConstSharedPtr());
 
+  if (!session_tickets) {
+    Ssl::SslSocket* ssl_socket = dynamic_cast<Ssl::SslSocket*>(client_connection->ssl());
+    SSL_set_options(ssl_socket->rawSslForTest(), SSL_OP_NO_TICKET);
+  }
+
   Network::MockConnectionCallbacks client_connection_callbacks;
   client_connection->addConnectionCallbacks(client_connection_callbacks);
   client_connection->connect();
@@ -622,6 +633,9 @@ void testTicketSessionResumption(const std::string& server_ctx_json1,
       *client_ctx, socket2.localAddress(), Network::Address::InstanceConstSharedPtr());
   client_connection->addConnectionCallbacks(client_connection_callbacks);
   Ssl::SslSocket* ssl_socket = dynamic_cast<Ssl::SslSocket*>(client_connection->ssl());
+  if (!session_tickets) {
+    SSL_set_options(ssl_socket->rawSslForTest(), SSL_OP_NO_TICKET);
+  }
   SSL_set_session(ssl_socket->rawSslForTest(), ssl_session);
   SSL_SESSION_free(ssl_session);
 
@@ -657,6 +671,9 @@ void testTicketSessionResumption(const std::string& server_ctx_json1,
 
   // One for client, one for server
   EXPECT_EQ(expect_reuse ? 2UL : 0UL, stats_store.counter("ssl.session_reused").value());
+  if (!session_tickets) {
+    EXPECT_EQ(expect_reuse ? 1UL : 0UL, stats_store.counter("ssl.session_cache_hit").value());
+  }
 }
 } // namespace
 
@@ -677,6 +694,25 @@ TEST_P(SslSocketTest, TicketSessionResumption) {
   testTicketSessionResumption(server_ctx_json, server_ctx_json, client_ctx_json, true, GetParam());
 }
 
+// Sessions are cached by ID across server contexts, so a client that doesn't use session tickets
+// can still resume on a different listener (or worker) than the one it first connected to.
+TEST_P(SslSocketTest, SessionIdResumptionAcrossContexts) {
+  std::string server_ctx_json = R"EOF(
+  {
+    "cert_chain_file": "{{ test_tmpdir }}/unittestcert.pem",
+    "private_key_file": "{{ test_tmpdir }}/unittestkey.pem"
+  }
+  )EOF";
+
+  std::string client_ctx_json = R"EOF(
+  {
+  }
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_json, server_ctx_json, client_ctx_json, true, GetParam(),
+                              false);
+}
+
 TEST_P(SslSocketTest, TicketSessionResumptionWithClientCA) {
   std::string server_ctx_json = R"EOF(
   {
@@ -822,6 +858,74 @@ TEST_P(SslSocketTest, TicketSessionResumptionDifferentServerCertDifferentSAN) {
                               GetParam());
 }
 
+// A client context offers the session it last got from a peer on the next connection to that peer,
+// without the session being set explicitly.
+TEST_P(SslSocketTest, ClientSessionResumption) {
+  Stats::IsolatedStoreImpl stats_store;
+  Runtime::MockLoader runtime;
+
+  std::string server_ctx_json = R"EOF(
+  {
+    "cert_chain_file": "{{ test_tmpdir }}/unittestcert.pem",
+    "private_key_file": "{{ test_tmpdir }}/unittestkey.pem"
+  }
+  )EOF";
+  Json::ObjectSharedPtr server_ctx_loader = TestEnvironment::jsonLoadFromString(server_ctx_json);
+  ServerContextConfigImpl server_ctx_config(*server_ctx_loader);
+  ContextManagerImpl manager(runtime);
+  ServerContextPtr server_ctx(
+      manager.createSslServerContext("", {}, stats_store, server_ctx_config, true));
+
+  Event::DispatcherImpl dispatcher;
+  Network::TcpListenSocket socket(Network::Test::getCanonicalLoopbackAddress(GetParam()), true);
+  NiceMock<Network::MockListenerCallbacks> callbacks;
+  Network::MockConnectionHandler connection_handler;
+  Network::ListenerPtr listener =
+      dispatcher.createSslListener(connection_handler, *server_ctx, socket, callbacks, stats_store,
+                                   Network::ListenerOptions::listenerOptionsWithBindToPort());
+
+  Json::ObjectSharedPtr client_ctx_loader = TestEnvironment::jsonLoadFromString("{}");
+  ClientContextConfigImpl client_ctx_config(*client_ctx_loader);
+  ClientContextPtr client_ctx(manager.createSslClientContext(stats_store, client_ctx_config));
+
+  for (uint64_t i = 0; i < 2; i++) {
+    Network::ClientConnectionPtr client_connection = dispatcher.createSslClientConnection(
+        *client_ctx, socket.localAddress(), Network::Address::InstanceConstSharedPtr());
+    Network::MockConnectionCallbacks client_connection_callbacks;
+    client_connection->addConnectionCallbacks(client_connection_callbacks);
+    client_connection->connect();
+
+    Network::ConnectionPtr server_connection;
+    Network::MockConnectionCallbacks server_connection_callbacks;
+    EXPECT_CALL(callbacks, onNewConnection_(_))
+        .WillOnce(Invoke([&](Network::ConnectionPtr& conn) -> void {
+          server_connection = std::move(conn);
+          server_connection->addConnectionCallbacks(server_connection_callbacks);
+        }));
+
+    unsigned connect_count = 0;
+    auto stopSecondTime = [&]() {
+      if (++connect_count == 2) {
+        client_connection->close(Network::ConnectionCloseType::NoFlush);
+        server_connection->close(Network::ConnectionCloseType::NoFlush);
+        dispatcher.exit();
+      }
+    };
+    EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+        .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { stopSecondTime(); }));
+    EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::Connected))
+        .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { stopSecondTime(); }));
+    EXPECT_CALL(client_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose));
+    EXPECT_CALL(server_connection_callbacks, onEvent(Network::ConnectionEvent::LocalClose));
+
+    dispatcher.run(Event::Dispatcher::RunType::Block);
+
+    // One for client, one for server on the second connection.
+    EXPECT_EQ(2 * i, stats_store.counter("ssl.session_reused").value());
+    EXPECT_EQ(i, stats_store.counter("ssl.session_cache_hit").value());
+  }
+}
+
 // Test that if two listeners use the same cert and session ticket key, but
 // different client CA, that sessions cannot be resumed.
 TEST_P(SslSocketTest, ClientAuthCrossListenerSessionResumption) {
@@ -1688,6 +1792,50 @@ public:
     disconnect();
   }
 
+  // Write num_slices slices of slice_size bytes in a single buffer and count the TLS records the
+  // client needs for them.
+  void recordSizeTest(bool dynamic_record_sizing, uint32_t slice_size, uint32_t num_slices,
+                      uint64_t expected_records) {
+    ON_CALL(runtime_.snapshot_, featureEnabled("ssl.dynamic_record_sizing", 0))
+        .WillByDefault(Return(dynamic_record_sizing));
+    initialize(0);
+
+    EXPECT_CALL(listener_callbacks_, onNewConnection_(_))
+        .WillOnce(Invoke([&](Network::ConnectionPtr& conn) -> void {
+          server_connection_ = std::move(conn);
+          server_connection_->addConnectionCallbacks(server_callbacks_);
+          server_connection_->addReadFilter(read_filter_);
+        }));
+    EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::Connected))
+        .WillOnce(Invoke([&](Network::ConnectionEvent) -> void { dispatcher_->exit(); }));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+    uint64_t filter_seen = 0;
+    EXPECT_CALL(*read_filter_, onNewConnection());
+    EXPECT_CALL(*read_filter_, onData(_))
+        .WillRepeatedly(Invoke([&](Buffer::Instance& data) -> Network::FilterStatus {
+          filter_seen += data.length();
+          data.drain(data.length());
+          if (filter_seen == slice_size * num_slices) {
+            dispatcher_->exit();
+          }
+          return Network::FilterStatus::StopIteration;
+        }));
+
+    Buffer::OwnedImpl data;
+    for (uint32_t i = 0; i < num_slices; i++) {
+      Buffer::OwnedImpl slice(std::string(slice_size, 'a'));
+      data.move(slice);
+    }
+    client_connection_->write(data);
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+    EXPECT_EQ(expected_records, stats_store_.counter("ssl.record_written").value());
+    EXPECT_LE(1UL, stats_store_.counter("ssl.write_calls").value());
+    EXPECT_GE(expected_records, stats_store_.counter("ssl.write_calls").value());
+    disconnect();
+  }
+
   void disconnect() {
     EXPECT_CALL(client_callbacks_, onEvent(Network::ConnectionEvent::LocalClose));
     EXPECT_CALL(server_callbacks_, onEvent(Network::ConnectionEvent::RemoteClose))
@@ -1753,6 +1901,57 @@ TEST_P(SslReadBufferLimitTest, WritesSmallerThanBufferLimit) { singleWriteTest(5
 
 TEST_P(SslReadBufferLimitTest, WritesLargerThanBufferLimit) { singleWriteTest(1024, 5 * 1024); }
 
+// Many small slices are coalesced into a single TLS record.
+TEST_P(SslReadBufferLimitTest, CoalesceSmallSlices) { recordSizeTest(false, 10, 1000, 1); }
+
+// Writes are split into full-size TLS records.
+TEST_P(SslReadBufferLimitTest, FullSizeRecords) { recordSizeTest(false, 1024, 64, 4); }
+
+// With dynamic record sizing, the first records fit in a single TCP segment.
+TEST_P(SslReadBufferLimitTest, DynamicRecordSizing) { recordSizeTest(true, 1024, 64, 47); }
+
+// With async private key operations enabled, the handshake signature runs on the crypto threads.
+TEST_P(SslReadBufferLimitTest, AsyncPrivateKeyOperations) {
+  ON_CALL(runtime_.snapshot_, featureEnabled("ssl.async_private_key_operations", 0))
+      .WillByDefault(Return(true));
+  recordSizeTest(false, 1024, 1, 1);
+  EXPECT_EQ(1UL, stats_store_.counter("ssl.private_key_op_offloaded").value());
+  EXPECT_EQ(0UL, stats_store_.counter("ssl.private_key_op_inline").value());
+}
+
+// A private key operation that completes after the connection was closed doesn't touch it.
+TEST_P(SslReadBufferLimitTest, AsyncPrivateKeyOperationAfterClose) {
+  ON_CALL(runtime_.snapshot_, featureEnabled("ssl.async_private_key_operations", 0))
+      .WillByDefault(Return(true));
+  server_ctx_loader_ = TestEnvironment::jsonLoadFromString(server_ctx_json_);
+  server_ctx_config_.reset(new ServerContextConfigImpl(*server_ctx_loader_));
+  manager_.reset(new ContextManagerImpl(runtime_));
+  server_ctx_ = manager_->createSslServerContext("", {}, stats_store_, *server_ctx_config_, true);
+
+  Network::MockTransportSocketCallbacks callbacks;
+  std::promise<std::function<void()>> completion;
+  EXPECT_CALL(callbacks.connection_.dispatcher_, post(_))
+      .WillOnce(Invoke([&](std::function<void()> callback) -> void {
+        completion.set_value(callback);
+      }));
+  EXPECT_CALL(callbacks, setReadBufferReady()).Times(0);
+
+  SslSocket socket(*server_ctx_, InitialState::Server);
+  socket.setTransportSocketCallbacks(callbacks);
+  uint8_t out[16];
+  size_t out_len;
+  EXPECT_EQ(ssl_private_key_retry,
+            socket.startPrivateKeyOperation(
+                [](std::vector<uint8_t>& output) -> bool {
+                  output.assign(4, 'a');
+                  return true;
+                },
+                out, &out_len, sizeof(out)));
+
+  socket.closeSocket(Network::ConnectionEvent::LocalClose);
+  completion.get_future().get()();
+}
+
 TEST_P(SslReadBufferLimitTest, TestBind) {
   std::string address_string = TestUtility::getIpv4Loopback();
   if (GetParam() == Network::Address::IpVersion::v4) {
@@ -7,6 +7,7 @@
 using testing::InSequence;
 using testing::Ref;
 using testing::ReturnPointee;
+using testing::SaveArg;
 using testing::_;
 
 namespace Envoy {
@@ -79,5 +80,33 @@ TEST_F(ThreadLocalInstanceImplTest, All) {
   tls_.shutdownThread();
 }
 
+// Validate that the completion callback runs on the main thread once every thread has run the
+// callback.
+TEST_F(ThreadLocalInstanceImplTest, RunOnAllThreadsWithCompletion) {
+  SlotPtr slot = tls_.allocateSlot();
+
+  uint32_t thread_cb_count = 0;
+  uint32_t complete_count = 0;
+  Event::PostCb thread_cb;
+  EXPECT_CALL(thread_dispatcher_, post(_)).WillOnce(SaveArg<0>(&thread_cb));
+  slot->runOnAllThreads([&thread_cb_count]() -> void { thread_cb_count++; },
+                        [&thread_cb_count, &complete_count]() -> void {
+                          EXPECT_EQ(2U, thread_cb_count);
+                          complete_count++;
+                        });
+  EXPECT_EQ(1U, thread_cb_count);
+  EXPECT_EQ(0U, complete_count);
+
+  EXPECT_CALL(main_dispatcher_, post(_));
+  thread_cb();
+  EXPECT_EQ(2U, thread_cb_count);
+  EXPECT_EQ(1U, complete_count);
+
+  EXPECT_CALL(thread_dispatcher_, post(_));
+  slot.reset();
+  tls_.shutdownGlobalThreading();
+  tls_.shutdownThread();
+}
+
 } // namespace ThreadLocal
 } // namespace Envoy
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/upstream/alias_table.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+
+namespace {
+
+std::vector<uint64_t> pickCounts(const AliasTable& table, size_t size, uint64_t picks) {
+  std::mt19937_64 generator(1234);
+  std::vector<uint64_t> counts(size);
+  for (uint64_t i = 0; i < picks; ++i) {
+    counts[table.pick(generator())]++;
+  }
+  return counts;
+}
+
+} // namespace
+
+TEST(AliasTableTest, Empty) {
+  AliasTable table;
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(table.rebuild({0, 0, 0}));
+  EXPECT_TRUE(table.empty());
+}
+
+TEST(AliasTableTest, SingleWeight) {
+  AliasTable table;
+  EXPECT_TRUE(table.rebuild({7}));
+  EXPECT_FALSE(table.empty());
+  EXPECT_EQ(0U, table.pick(0));
+  EXPECT_EQ(0U, table.pick(UINT64_MAX));
+}
+
+TEST(AliasTableTest, RebuildOnlyOnChange) {
+  AliasTable table;
+  EXPECT_TRUE(table.rebuild({1, 2}));
+  EXPECT_FALSE(table.rebuild({1, 2}));
+  EXPECT_TRUE(table.rebuild({2, 1}));
+  EXPECT_TRUE(table.rebuild({}));
+  EXPECT_TRUE(table.empty());
+}
+
+TEST(AliasTableTest, Distribution) {
+  AliasTable table;
+  table.rebuild({1, 2, 3, 0, 4});
+  const std::vector<uint64_t> counts = pickCounts(table, 5, 100000);
+  EXPECT_NEAR(10000, counts[0], 500);
+  EXPECT_NEAR(20000, counts[1], 500);
+  EXPECT_NEAR(30000, counts[2], 500);
+  EXPECT_EQ(0U, counts[3]);
+  EXPECT_NEAR(40000, counts[4], 500);
+}
+
+// Weights whose sum does not fit in 32 bits are scaled down without dropping small weights.
+TEST(AliasTableTest, LargeWeights) {
+  AliasTable table;
+  table.rebuild({1ULL << 44, 1, 3ULL << 44});
+  const std::vector<uint64_t> counts = pickCounts(table, 3, 100000);
+  EXPECT_NEAR(25000, counts[0], 500);
+  EXPECT_NEAR(75000, counts[2], 500);
+  EXPECT_EQ(100000U, counts[0] + counts[1] + counts[2]);
+}
+
+// 100 localities with weights 1..100: every index is picked in proportion to its weight.
+TEST(AliasTableTest, ManyWeights) {
+  std::vector<uint64_t> weights;
+  for (uint64_t i = 1; i <= 100; ++i) {
+    weights.push_back(i);
+  }
+  AliasTable table;
+  table.rebuild(weights);
+  const uint64_t picks = 5050 * 200;
+  const std::vector<uint64_t> counts = pickCounts(table, 100, picks);
+  for (uint64_t i = 0; i < 100; ++i) {
+    EXPECT_NEAR(200 * weights[i], counts[i], 200 * weights[i] / 5 + 50) << i;
+  }
+}
+
+} // namespace Upstream
+} // namespace Envoy
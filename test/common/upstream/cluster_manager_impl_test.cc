@@ -891,7 +891,7 @@ TEST_F(ClusterManagerImplTest, DynamicHostRemove) {
   )EOF";
 
   std::shared_ptr<Network::MockDnsResolver> dns_resolver(new Network::MockDnsResolver());
-  EXPECT_CALL(factory_.dispatcher_, createDnsResolver(_)).WillOnce(Return(dns_resolver));
+  EXPECT_CALL(factory_.dispatcher_, createDnsResolver(_, _)).WillOnce(Return(dns_resolver));
 
   Network::DnsResolver::ResolveCb dns_callback;
   Event::MockTimer* dns_timer_ = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
@@ -967,6 +967,161 @@ TEST_F(ClusterManagerImplTest, DynamicHostRemove) {
   factory_.tls_.shutdownThread();
 }
 
+// A burst of host set updates within one main thread event reaches the workers as the first
+// update followed by a single snapshot of the final state.
+TEST_F(ClusterManagerImplTest, CoalesceThreadLocalUpdates) {
+  const std::string json = R"EOF(
+  {
+    "clusters": [
+    {
+      "name": "cluster_1",
+      "connect_timeout_ms": 250,
+      "type": "strict_dns",
+      "dns_resolvers": [ "1.2.3.4:80" ],
+      "lb_type": "round_robin",
+      "hosts": [{"url": "tcp://localhost:11001"}]
+    }]
+  }
+  )EOF";
+
+  std::shared_ptr<Network::MockDnsResolver> dns_resolver(new Network::MockDnsResolver());
+  EXPECT_CALL(factory_.dispatcher_, createDnsResolver(_, _)).WillOnce(Return(dns_resolver));
+
+  Network::DnsResolver::ResolveCb dns_callback;
+  Event::MockTimer* dns_timer_ = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
+  Network::MockActiveDnsQuery active_dns_query;
+  EXPECT_CALL(*dns_resolver, resolve(_, _, _))
+      .WillRepeatedly(DoAll(SaveArg<2>(&dns_callback), Return(&active_dns_query)));
+  create(parseBootstrapFromJson(json));
+  dns_callback(TestUtility::makeDnsResponse({"127.0.0.1"}));
+
+  // Hold on to the batch instead of running it inline.
+  std::vector<Event::PostCb> posted;
+  EXPECT_CALL(factory_.dispatcher_, post(_))
+      .WillRepeatedly(Invoke([&](Event::PostCb callback) -> void { posted.push_back(callback); }));
+
+  const HostSet& host_set =
+      *cluster_manager_->get("cluster_1")->prioritySet().hostSetsPerPriority()[0];
+  const uint64_t batches =
+      factory_.stats_.counter("cluster_manager.thread_local_update_batch").value();
+
+  // The first update is applied right away.
+  dns_timer_->callback_();
+  dns_callback(TestUtility::makeDnsResponse({"127.0.0.2"}));
+  ASSERT_EQ(1UL, host_set.hosts().size());
+  EXPECT_EQ("127.0.0.2:11001", host_set.hosts()[0]->address()->asString());
+  EXPECT_EQ(batches + 1,
+            factory_.stats_.counter("cluster_manager.thread_local_update_batch").value());
+  EXPECT_EQ(1UL, posted.size());
+
+  // The rest of the burst is merged.
+  for (const std::string& address : {"127.0.0.3", "127.0.0.2", "127.0.0.3"}) {
+    dns_timer_->callback_();
+    dns_callback(TestUtility::makeDnsResponse({address}));
+  }
+  EXPECT_EQ("127.0.0.2:11001", host_set.hosts()[0]->address()->asString());
+  EXPECT_EQ(3UL, factory_.stats_.counter("cluster_manager.thread_local_update_coalesced").value());
+  EXPECT_EQ(1UL, factory_.stats_.gauge("cluster_manager.thread_local_update_pending").value());
+  EXPECT_EQ(batches + 1,
+            factory_.stats_.counter("cluster_manager.thread_local_update_batch").value());
+  EXPECT_EQ(1UL, posted.size());
+
+  // Once the main thread is done with the current event the final state is posted.
+  posted[0]();
+  ASSERT_EQ(1UL, host_set.hosts().size());
+  EXPECT_EQ("127.0.0.3:11001", host_set.hosts()[0]->address()->asString());
+  EXPECT_EQ(0UL, factory_.stats_.gauge("cluster_manager.thread_local_update_pending").value());
+  EXPECT_EQ(batches + 2,
+            factory_.stats_.counter("cluster_manager.thread_local_update_batch").value());
+
+  factory_.tls_.shutdownThread();
+}
+
+// Load reports are only accumulated for the clusters being reported on, and each request is
+// harvested exactly once.
+TEST_F(ClusterManagerImplTest, LoadReports) {
+  const std::string json = R"EOF(
+  {
+    "clusters": [
+    {
+      "name": "cluster_1",
+      "connect_timeout_ms": 250,
+      "type": "static",
+      "lb_type": "round_robin",
+      "hosts": [{"url": "tcp://127.0.0.1:11001"}]
+    },
+    {
+      "name": "cluster_2",
+      "connect_timeout_ms": 250,
+      "type": "static",
+      "lb_type": "round_robin",
+      "hosts": [{"url": "tcp://127.0.0.1:11002"}]
+    }]
+  }
+  )EOF";
+
+  create(parseBootstrapFromJson(json));
+  const HostSharedPtr host_1 =
+      cluster_manager_->get("cluster_1")->prioritySet().hostSetsPerPriority()[0]->hosts()[0];
+  const HostSharedPtr host_2 =
+      cluster_manager_->get("cluster_2")->prioritySet().hostSetsPerPriority()[0]->hosts()[0];
+
+  auto harvest = [this](const std::vector<std::string>& clusters) -> HostLoadReportMap {
+    HostLoadReportMap harvested_load_reports;
+    uint32_t harvests = 0;
+    cluster_manager_->harvestLoadReports(
+        clusters, [&harvested_load_reports, &harvests](HostLoadReportMap&& load_reports) -> void {
+          harvested_load_reports = std::move(load_reports);
+          harvests++;
+        });
+    EXPECT_EQ(1U, harvests);
+    return harvested_load_reports;
+  };
+
+  // Nothing is accumulated before reporting starts.
+  cluster_manager_->recordLoadReport(host_1, true);
+  cluster_manager_->updateLoadReportClusters({"cluster_1"});
+  cluster_manager_->recordLoadReport(host_1, true);
+  cluster_manager_->recordLoadReport(host_1, true);
+  cluster_manager_->recordLoadReport(host_1, false);
+  cluster_manager_->recordLoadReport(host_2, false);
+
+  // A harvest returns what every thread accumulated up to the harvest.
+  HostLoadReportMap load_reports = harvest({"cluster_1"});
+  ASSERT_EQ(1UL, load_reports.size());
+  EXPECT_EQ(2UL, load_reports[host_1].rq_success_);
+  EXPECT_EQ(1UL, load_reports[host_1].rq_error_);
+  EXPECT_TRUE(harvest({"cluster_1"}).empty());
+
+  // Requests are reported exactly once across a change of the tracked clusters.
+  const uint64_t requests = 5;
+  for (uint64_t i = 0; i < requests; i++) {
+    cluster_manager_->recordLoadReport(host_1, i % 2 == 0);
+  }
+  cluster_manager_->updateLoadReportClusters({"cluster_1", "cluster_2"});
+  for (uint64_t i = 0; i < requests; i++) {
+    cluster_manager_->recordLoadReport(host_1, true);
+    cluster_manager_->recordLoadReport(host_2, false);
+  }
+  load_reports = harvest({"cluster_1", "cluster_2"});
+  ASSERT_EQ(2UL, load_reports.size());
+  EXPECT_EQ(requests + 3, load_reports[host_1].rq_success_);
+  EXPECT_EQ(2UL, load_reports[host_1].rq_error_);
+  EXPECT_EQ(0UL, load_reports[host_2].rq_success_);
+  EXPECT_EQ(requests, load_reports[host_2].rq_error_);
+  EXPECT_TRUE(harvest({"cluster_1", "cluster_2"}).empty());
+
+  // Reports for a cluster that is no longer tracked are dropped.
+  cluster_manager_->recordLoadReport(host_1, true);
+  cluster_manager_->recordLoadReport(host_2, true);
+  cluster_manager_->updateLoadReportClusters({"cluster_2"});
+  load_reports = harvest({"cluster_2"});
+  ASSERT_EQ(1UL, load_reports.size());
+  EXPECT_EQ(1UL, load_reports[host_2].rq_success_);
+
+  factory_.tls_.shutdownThread();
+}
+
 // This is a regression test for a use-after-free in
 // ClusterManagerImpl::ThreadLocalClusterManagerImpl::drainConnPools(), where a removal at one
 // priority from the ConnPoolsContainer would delete the ConnPoolsContainer mid-iteration over the
@@ -987,7 +1142,7 @@ TEST_F(ClusterManagerImplTest, DynamicHostRemoveDefaultPriority) {
   )EOF";
 
   std::shared_ptr<Network::MockDnsResolver> dns_resolver(new Network::MockDnsResolver());
-  EXPECT_CALL(factory_.dispatcher_, createDnsResolver(_)).WillOnce(Return(dns_resolver));
+  EXPECT_CALL(factory_.dispatcher_, createDnsResolver(_, _)).WillOnce(Return(dns_resolver));
 
   Network::DnsResolver::ResolveCb dns_callback;
   Event::MockTimer* dns_timer_ = new NiceMock<Event::MockTimer>(&factory_.dispatcher_);
@@ -12,6 +12,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::Return;
 using testing::ReturnRef;
 
 namespace Envoy {
@@ -181,6 +182,48 @@ TEST_F(EdsTest, EndpointMetadata) {
   EXPECT_TRUE(hosts[1]->canary());
 }
 
+// Validate that onConfigUpdate() keeps existing hosts, updates their weights inline, adds new
+// hosts, removes missing hosts and ignores duplicates.
+TEST_F(EdsTest, EndpointAddedRemovedAndWeightUpdated) {
+  Protobuf::RepeatedPtrField<envoy::api::v2::ClusterLoadAssignment> resources;
+  auto* cluster_load_assignment = resources.Add();
+  cluster_load_assignment->set_cluster_name("fare");
+
+  auto add_endpoint = [cluster_load_assignment](const std::string& address, uint32_t weight) {
+    auto* endpoint = cluster_load_assignment->mutable_endpoints(0)->add_lb_endpoints();
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_address(
+        address);
+    endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address()->set_port_value(80);
+    endpoint->mutable_load_balancing_weight()->set_value(weight);
+  };
+
+  cluster_load_assignment->add_endpoints();
+  add_endpoint("1.2.3.4", 1);
+  add_endpoint("2.3.4.5", 1);
+  add_endpoint("3.4.5.6", 1);
+
+  bool initialized = false;
+  cluster_->initialize([&initialized] { initialized = true; });
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+  EXPECT_TRUE(initialized);
+
+  const HostSharedPtr kept_host = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts()[1];
+  EXPECT_EQ("2.3.4.5:80", kept_host->address()->asString());
+
+  cluster_load_assignment->mutable_endpoints(0)->clear_lb_endpoints();
+  add_endpoint("2.3.4.5", 5);
+  add_endpoint("4.5.6.7", 1);
+  add_endpoint("2.3.4.5", 7);
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+
+  auto& hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
+  EXPECT_EQ(hosts.size(), 2);
+  EXPECT_EQ(kept_host, hosts[0]);
+  EXPECT_EQ(5, hosts[0]->weight());
+  EXPECT_EQ("4.5.6.7:80", hosts[1]->address()->asString());
+  EXPECT_EQ(5, cluster_->info()->stats().max_host_weight_.value());
+}
+
 // Validate that onConfigUpdate() updates the endpoint locality.
 TEST_F(EdsTest, EndpointLocality) {
   Protobuf::RepeatedPtrField<envoy::api::v2::ClusterLoadAssignment> resources;
@@ -291,6 +334,75 @@ TEST_F(EdsTest, EndpointHostsPerLocality) {
   }
 }
 
+// Validate that onConfigUpdate() publishes locality weights aligned with hosts per locality, even
+// when the local locality has no upstream hosts and only the weights change.
+TEST_F(EdsTest, EndpointLocalityWeights) {
+  ON_CALL(runtime_.snapshot_, featureEnabled("upstream.locality_weighted_lb.name", 0))
+      .WillByDefault(Return(true));
+  Protobuf::RepeatedPtrField<envoy::api::v2::ClusterLoadAssignment> resources;
+  auto* cluster_load_assignment = resources.Add();
+  cluster_load_assignment->set_cluster_name("fare");
+  uint32_t port = 1000;
+  auto add_hosts_to_locality = [cluster_load_assignment, &port](const std::string& region,
+                                                                uint32_t n, uint32_t weight) {
+    auto* endpoints = cluster_load_assignment->add_endpoints();
+    endpoints->mutable_locality()->set_region(region);
+    if (weight > 0) {
+      endpoints->mutable_load_balancing_weight()->set_value(weight);
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address("1.2.3.4");
+      socket_address->set_port_value(port++);
+    }
+  };
+
+  add_hosts_to_locality("oceania", 2, 25);
+  add_hosts_to_locality("general", 1, 0);
+
+  bool initialized = false;
+  cluster_->initialize([&initialized] { initialized = true; });
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+  EXPECT_TRUE(initialized);
+
+  {
+    const auto& host_set = *cluster_->prioritySet().hostSetsPerPriority()[0];
+    auto& hosts_per_locality = host_set.hostsPerLocality();
+    EXPECT_EQ(2, hosts_per_locality.size());
+    EXPECT_EQ(1, hosts_per_locality[0].size());
+    EXPECT_EQ(Locality("general", "", ""), Locality(hosts_per_locality[0][0]->locality()));
+    EXPECT_EQ(2, hosts_per_locality[1].size());
+    EXPECT_EQ(Locality("oceania", "", ""), Locality(hosts_per_locality[1][0]->locality()));
+    ASSERT_NE(nullptr, host_set.localityWeights());
+    // The locality without a weight gets the default weight.
+    EXPECT_EQ(HostSet::LocalityWeights({1, 25}), *host_set.localityWeights());
+  }
+
+  // Only the weight changes.
+  cluster_load_assignment->mutable_endpoints(0)->mutable_load_balancing_weight()->set_value(50);
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+  EXPECT_EQ(HostSet::LocalityWeights({1, 50}),
+            *cluster_->prioritySet().hostSetsPerPriority()[0]->localityWeights());
+
+  // Without weights or local locality hosts there is no per locality breakdown.
+  cluster_load_assignment->mutable_endpoints(0)->clear_load_balancing_weight();
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+  EXPECT_EQ(nullptr, cluster_->prioritySet().hostSetsPerPriority()[0]->localityWeights());
+  EXPECT_EQ(0, cluster_->prioritySet().hostSetsPerPriority()[0]->hostsPerLocality().size());
+
+  // Weights are ignored unless the cluster opts into locality weighted load balancing.
+  cluster_load_assignment->mutable_endpoints(0)->mutable_load_balancing_weight()->set_value(50);
+  ON_CALL(runtime_.snapshot_, featureEnabled("upstream.locality_weighted_lb.name", 0))
+      .WillByDefault(Return(false));
+  VERBOSE_EXPECT_NO_THROW(cluster_->onConfigUpdate(resources));
+  EXPECT_EQ(nullptr, cluster_->prioritySet().hostSetsPerPriority()[0]->localityWeights());
+  EXPECT_EQ(0, cluster_->prioritySet().hostSetsPerPriority()[0]->hostsPerLocality().size());
+}
+
 // Validate that onConfigUpdate() updates bins hosts per priority as expected.
 TEST_F(EdsTest, EndpointHostsPerPriority) {
   Protobuf::RepeatedPtrField<envoy::api::v2::ClusterLoadAssignment> resources;
@@ -183,8 +183,9 @@ public:
     TestSessionPtr new_test_session(new TestSession());
     test_sessions_.emplace_back(std::move(new_test_session));
     TestSession& test_session = *test_sessions_.back();
+    // Each session uses a single timer for both the interval and the timeout.
     test_session.timeout_timer_ = new Event::MockTimer(&dispatcher_);
-    test_session.interval_timer_ = new Event::MockTimer(&dispatcher_);
+    test_session.interval_timer_ = test_session.timeout_timer_;
     expectClientCreate(test_sessions_.size() - 1);
   }
 
@@ -274,7 +275,6 @@ TEST_F(HttpHealthCheckerImplTest, Success) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _))
       .WillOnce(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false, true);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -302,9 +302,7 @@ TEST_F(HttpHealthCheckerImplTest, SuccessWithMultipleHosts) {
       .Times(2)
       .WillRepeatedly(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   EXPECT_CALL(*test_sessions_[1]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[1]->timeout_timer_, disableTimer());
   respond(0, "200", false, true);
   respond(1, "200", false, true);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
@@ -335,9 +333,7 @@ TEST_F(HttpHealthCheckerImplTest, SuccessWithMultipleHostSets) {
       .Times(2)
       .WillRepeatedly(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   EXPECT_CALL(*test_sessions_[1]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[1]->timeout_timer_, disableTimer());
   respond(0, "200", false, true);
   respond(1, "200", false, true);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
@@ -363,7 +359,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessServiceCheck) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _))
       .WillOnce(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   Optional<std::string> health_checked_cluster("locations-production-iad");
   respond(0, "200", false, true, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
@@ -388,7 +383,6 @@ TEST_F(HttpHealthCheckerImplTest, ServiceDoesNotMatchFail) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _))
       .WillOnce(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   Optional<std::string> health_checked_cluster("api-production-iad");
   respond(0, "200", false, true, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
@@ -415,7 +409,6 @@ TEST_F(HttpHealthCheckerImplTest, ServiceNotPresentInResponseFail) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _))
       .WillOnce(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false, true, false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -441,7 +434,6 @@ TEST_F(HttpHealthCheckerImplTest, ServiceCheckRuntimeOff) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _))
       .WillOnce(Return(45000));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(45000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   Optional<std::string> health_checked_cluster("api-production-iad");
   respond(0, "200", false, true, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
@@ -464,7 +456,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirstServiceCheck) {
   // Test that failing first disables fast success.
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "503", false, false, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -476,7 +467,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirstServiceCheck) {
 
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false, false, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -488,7 +478,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirstServiceCheck) {
 
   EXPECT_CALL(*this, onHostStatus(_, true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false, false, false, health_checked_cluster);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -505,7 +494,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessNoTraffic) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(60000)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false, true, true);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -526,7 +514,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedSuccessFirst) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.max_interval", _)).WillOnce(Return(500));
   EXPECT_CALL(runtime_.snapshot_, getInteger("health_check.min_interval", _));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(std::chrono::milliseconds(500)));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -545,7 +532,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirst) {
   // Test that failing first disables fast success.
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "503", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -557,7 +543,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirst) {
 
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -569,7 +554,6 @@ TEST_F(HttpHealthCheckerImplTest, SuccessStartFailedFailFirst) {
 
   EXPECT_CALL(*this, onHostStatus(_, true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -585,7 +569,6 @@ TEST_F(HttpHealthCheckerImplTest, HttpFail) {
 
   EXPECT_CALL(*this, onHostStatus(_, true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "503", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -597,7 +580,6 @@ TEST_F(HttpHealthCheckerImplTest, HttpFail) {
 
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -609,7 +591,6 @@ TEST_F(HttpHealthCheckerImplTest, HttpFail) {
 
   EXPECT_CALL(*this, onHostStatus(_, true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -626,7 +607,6 @@ TEST_F(HttpHealthCheckerImplTest, Disconnect) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   test_sessions_[0]->client_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 
@@ -637,7 +617,6 @@ TEST_F(HttpHealthCheckerImplTest, Disconnect) {
 
   EXPECT_CALL(*this, onHostStatus(cluster_->prioritySet().getMockHostSet(0)->hosts_[0], true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   test_sessions_[0]->client_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -656,7 +635,6 @@ TEST_F(HttpHealthCheckerImplTest, Timeout) {
   EXPECT_CALL(*this, onHostStatus(_, false));
   EXPECT_CALL(*test_sessions_[0]->client_connection_, close(_));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   test_sessions_[0]->timeout_timer_->callback_();
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 
@@ -667,7 +645,6 @@ TEST_F(HttpHealthCheckerImplTest, Timeout) {
 
   EXPECT_CALL(*this, onHostStatus(_, true));
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   test_sessions_[0]->client_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
       Host::HealthFlag::FAILED_ACTIVE_HC));
@@ -704,7 +681,6 @@ TEST_F(HttpHealthCheckerImplTest, ConnectionClose) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", true);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 
@@ -726,7 +702,6 @@ TEST_F(HttpHealthCheckerImplTest, RemoteCloseBetweenChecks) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 
@@ -738,7 +713,6 @@ TEST_F(HttpHealthCheckerImplTest, RemoteCloseBetweenChecks) {
   test_sessions_[0]->interval_timer_->callback_();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -756,7 +730,6 @@ TEST_F(HttpHealthCheckerImplTest, DontReuseConnectionBetweenChecks) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 
@@ -769,7 +742,6 @@ TEST_F(HttpHealthCheckerImplTest, DontReuseConnectionBetweenChecks) {
   test_sessions_[0]->interval_timer_->callback_();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
   respond(0, "200", false);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
 }
@@ -786,7 +758,6 @@ TEST_F(HttpHealthCheckerImplTest, StreamReachesWatermarkDuringCheck) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
 
   test_sessions_[0]->request_encoder_.stream_.runHighWatermarkCallbacks();
   test_sessions_[0]->request_encoder_.stream_.runLowWatermarkCallbacks();
@@ -807,7 +778,6 @@ TEST_F(HttpHealthCheckerImplTest, ConnectionReachesWatermarkDuringCheck) {
   health_checker_->start();
 
   EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_));
-  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
 
   test_sessions_[0]->client_connection_->runHighWatermarkCallbacks();
   test_sessions_[0]->client_connection_->runLowWatermarkCallbacks();
@@ -940,8 +910,8 @@ public:
   }
 
   void expectSessionCreate() {
-    interval_timer_ = new Event::MockTimer(&dispatcher_);
     timeout_timer_ = new Event::MockTimer(&dispatcher_);
+    interval_timer_ = timeout_timer_;
   }
 
   void expectClientCreate() {
@@ -975,7 +945,6 @@ TEST_F(TcpHealthCheckerImplTest, Success) {
 
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   Buffer::OwnedImpl response;
   add_uint8(response, 2);
@@ -998,7 +967,6 @@ TEST_F(TcpHealthCheckerImplTest, DataWithoutReusingConnection) {
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
   // Expected execution flow when a healthcheck is successful and reuse_connection is false.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   EXPECT_CALL(*connection_, close(Network::ConnectionCloseType::NoFlush)).Times(1);
 
@@ -1033,7 +1001,6 @@ TEST_F(TcpHealthCheckerImplTest, Timeout) {
   read_filter_->onData(response);
 
   EXPECT_CALL(*connection_, close(_));
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   timeout_timer_->callback_();
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthy());
@@ -1045,7 +1012,6 @@ TEST_F(TcpHealthCheckerImplTest, Timeout) {
 
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
@@ -1081,7 +1047,6 @@ TEST_F(TcpHealthCheckerImplTest, TimeoutWithoutReusingConnection) {
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
   // Expected flow when a healthcheck is successful and reuse_connection is false.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   EXPECT_CALL(*connection_, close(Network::ConnectionCloseType::NoFlush)).Times(1);
 
@@ -1101,7 +1066,6 @@ TEST_F(TcpHealthCheckerImplTest, TimeoutWithoutReusingConnection) {
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
   // Expected flow when a healthcheck times out.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   // The healthcheck is not yet at the unhealthy threshold.
@@ -1122,7 +1086,6 @@ TEST_F(TcpHealthCheckerImplTest, TimeoutWithoutReusingConnection) {
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
   // Expected flow when a healthcheck times out.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
@@ -1147,7 +1110,6 @@ TEST_F(TcpHealthCheckerImplTest, NoData) {
   health_checker_->start();
 
   EXPECT_CALL(*connection_, close(_));
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
 
@@ -1178,7 +1140,6 @@ TEST_F(TcpHealthCheckerImplTest, PassiveFailure) {
 
   // A single success should not bring us back to healthy.
   EXPECT_CALL(*connection_, close(_));
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   connection_->raiseEvent(Network::ConnectionEvent::Connected);
   EXPECT_TRUE(cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
@@ -1249,6 +1210,67 @@ TEST_F(TcpHealthCheckerImplTest, PassiveFailureCrossThreadRemoveClusterRace) {
   EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.passive_failure").value());
 }
 
+// Health checks a large number of hosts across two intervals. Each host should use a single
+// timer and keep its connection open between checks.
+TEST_F(TcpHealthCheckerImplTest, ManyHosts) {
+  const uint32_t num_hosts = 10000;
+
+  setupData();
+  for (uint32_t i = 0; i < num_hosts; i++) {
+    cluster_->prioritySet().getMockHostSet(0)->hosts_.emplace_back(
+        makeTestHost(cluster_->info_, fmt::format("tcp://127.0.0.1:{}", 1000 + i)));
+  }
+
+  std::vector<Event::MockTimer*> timers;
+  ON_CALL(dispatcher_, createTimer_(_))
+      .WillByDefault(Invoke([&timers](Event::TimerCb cb) -> Event::Timer* {
+        Event::MockTimer* timer = new NiceMock<Event::MockTimer>();
+        timer->callback_ = cb;
+        timers.push_back(timer);
+        return timer;
+      }));
+  std::vector<Network::ReadFilterSharedPtr> read_filters;
+  ON_CALL(dispatcher_, createClientConnection_(_, _))
+      .WillByDefault(InvokeWithoutArgs([&read_filters]() -> Network::ClientConnection* {
+        Network::MockClientConnection* connection =
+            new NiceMock<Network::MockClientConnection>();
+        ON_CALL(*connection, addReadFilter(_))
+            .WillByDefault(Invoke([&read_filters](Network::ReadFilterSharedPtr filter) -> void {
+              read_filters.push_back(filter);
+            }));
+        return connection;
+      }));
+  EXPECT_CALL(dispatcher_, createTimer_(_)).Times(num_hosts);
+  EXPECT_CALL(dispatcher_, createClientConnection_(_, _)).Times(num_hosts);
+  health_checker_->start();
+  EXPECT_EQ(num_hosts, timers.size());
+  EXPECT_EQ(num_hosts, read_filters.size());
+
+  auto respond_all = [&read_filters]() -> void {
+    for (Network::ReadFilterSharedPtr& read_filter : read_filters) {
+      Buffer::OwnedImpl response;
+      add_uint8(response, 2);
+      read_filter->onData(response);
+    }
+  };
+
+  respond_all();
+  EXPECT_EQ(num_hosts, cluster_->info_->stats_store_.counter("health_check.success").value());
+
+  // The next interval reuses the existing connections.
+  for (Event::MockTimer* timer : timers) {
+    timer->callback_();
+  }
+  EXPECT_EQ(num_hosts, read_filters.size());
+  respond_all();
+  EXPECT_EQ(2UL * num_hosts,
+            cluster_->info_->stats_store_.counter("health_check.success").value());
+  EXPECT_EQ(2UL * num_hosts,
+            cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.failure").value());
+  EXPECT_EQ(num_hosts, cluster_->info_->stats_store_.gauge("health_check.healthy").value());
+}
+
 class RedisHealthCheckerImplTest : public testing::Test, public Redis::ConnPool::ClientFactory {
 public:
   RedisHealthCheckerImplTest() : cluster_(new NiceMock<MockCluster>()) {}
@@ -1292,8 +1314,8 @@ public:
   MOCK_METHOD0(create_, Redis::ConnPool::Client*());
 
   void expectSessionCreate() {
-    interval_timer_ = new Event::MockTimer(&dispatcher_);
     timeout_timer_ = new Event::MockTimer(&dispatcher_);
+    interval_timer_ = timeout_timer_;
   }
 
   void expectClientCreate() {
@@ -1333,7 +1355,6 @@ TEST_F(RedisHealthCheckerImplTest, All) {
   health_checker_->start();
 
   // Success
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   Redis::RespValuePtr response(new Redis::RespValue());
   response->type(Redis::RespType::SimpleString);
@@ -1344,7 +1365,6 @@ TEST_F(RedisHealthCheckerImplTest, All) {
   interval_timer_->callback_();
 
   // Failure
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   response.reset(new Redis::RespValue());
   pool_callbacks_->onResponse(std::move(response));
@@ -1353,7 +1373,6 @@ TEST_F(RedisHealthCheckerImplTest, All) {
   interval_timer_->callback_();
 
   // Redis failure via disconnect
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   pool_callbacks_->onFailure();
   client_->raiseEvent(Network::ConnectionEvent::RemoteClose);
@@ -1365,7 +1384,6 @@ TEST_F(RedisHealthCheckerImplTest, All) {
   // Timeout
   EXPECT_CALL(pool_request_, cancel());
   EXPECT_CALL(*client_, close());
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   timeout_timer_->callback_();
 
@@ -1397,7 +1415,6 @@ TEST_F(RedisHealthCheckerImplTest, AllDontReuseConnection) {
   health_checker_->start();
 
   // The connection will close on success.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   EXPECT_CALL(*client_, close());
   Redis::RespValuePtr response(new Redis::RespValue());
@@ -1410,7 +1427,6 @@ TEST_F(RedisHealthCheckerImplTest, AllDontReuseConnection) {
   interval_timer_->callback_();
 
   // The connection will close on failure.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   EXPECT_CALL(*client_, close());
   response.reset(new Redis::RespValue());
@@ -1421,7 +1437,6 @@ TEST_F(RedisHealthCheckerImplTest, AllDontReuseConnection) {
   interval_timer_->callback_();
 
   // Redis failure via disconnect, the connection was closed by the other end.
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   pool_callbacks_->onFailure();
   client_->raiseEvent(Network::ConnectionEvent::RemoteClose);
@@ -1433,7 +1448,6 @@ TEST_F(RedisHealthCheckerImplTest, AllDontReuseConnection) {
   // Timeout, the connection will be closed.
   EXPECT_CALL(pool_request_, cancel());
   EXPECT_CALL(*client_, close());
-  EXPECT_CALL(*timeout_timer_, disableTimer());
   EXPECT_CALL(*interval_timer_, enableTimer(_));
   timeout_timer_->callback_();
 
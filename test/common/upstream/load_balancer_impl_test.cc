@@ -1,5 +1,7 @@
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <random>
 #include <set>
 #include <string>
 #include <utility>
@@ -16,6 +18,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 
@@ -210,7 +213,8 @@ TEST_P(FailoverTest, ExtendPrioritiesWithLocalPrioritySet) {
   HostVectorSharedPtr hosts(
       new std::vector<HostSharedPtr>({makeTestHost(info_, "tcp://127.0.0.1:82")}));
   local_priority_set_->getOrCreateHostSet(0).updateHosts(
-      hosts, hosts, empty_locality_, empty_locality_, empty_host_vector_, empty_host_vector_);
+      hosts, hosts, empty_locality_, empty_locality_, nullptr, empty_host_vector_,
+      empty_host_vector_);
   EXPECT_EQ(tertiary_host_set_.hosts_[0], lb_->chooseHost(nullptr));
 }
 
@@ -273,7 +277,7 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareSmallCluster) {
   hostSet().healthy_hosts_ = *hosts;
   hostSet().healthy_hosts_per_locality_ = *hosts_per_locality;
   init(true);
-  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality,
+  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr,
                                empty_host_vector_, empty_host_vector_);
 
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
@@ -297,7 +301,7 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareSmallCluster) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.min_cluster_size", 6))
       .WillRepeatedly(Return(1));
   // Trigger reload.
-  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality,
+  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr,
                                empty_host_vector_, empty_host_vector_);
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_[0][0], lb_->chooseHost(nullptr));
 }
@@ -321,7 +325,7 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareDifferentZoneSize) {
   hostSet().healthy_hosts_per_locality_ = *upstream_hosts_per_locality;
   init(true);
   local_host_set_->updateHosts(hosts, hosts, local_hosts_per_locality, local_hosts_per_locality,
-                               empty_host_vector_, empty_host_vector_);
+                               nullptr, empty_host_vector_, empty_host_vector_);
 
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
       .WillRepeatedly(Return(50));
@@ -355,7 +359,7 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareRoutingLargeZoneSwitchOnOff) {
   hostSet().hosts_ = *hosts;
   hostSet().healthy_hosts_per_locality_ = *hosts_per_locality;
   init(true);
-  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality,
+  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr,
                                empty_host_vector_, empty_host_vector_);
 
   // There is only one host in the given zone for zone aware routing.
@@ -404,7 +408,8 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareRoutingSmallZone) {
   hostSet().healthy_hosts_per_locality_ = *upstream_hosts_per_locality;
   init(true);
   local_host_set_->updateHosts(local_hosts, local_hosts, local_hosts_per_locality,
-                               local_hosts_per_locality, empty_host_vector_, empty_host_vector_);
+                               local_hosts_per_locality, nullptr, empty_host_vector_,
+                               empty_host_vector_);
 
   // There is only one host in the given zone for zone aware routing.
   EXPECT_CALL(random_, random()).WillOnce(Return(100));
@@ -474,7 +479,8 @@ TEST_P(RoundRobinLoadBalancerTest, LowPrecisionForDistribution) {
 
   // To trigger update callback.
   local_host_set_->updateHosts(local_hosts, local_hosts, local_hosts_per_locality,
-                               local_hosts_per_locality, empty_host_vector_, empty_host_vector_);
+                               local_hosts_per_locality, nullptr, empty_host_vector_,
+                               empty_host_vector_);
 
   // Force request out of small zone and to randomly select zone.
   EXPECT_CALL(random_, random()).WillOnce(Return(9999)).WillOnce(Return(2));
@@ -495,7 +501,7 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingOneZone) {
   hostSet().hosts_ = *hosts;
   hostSet().healthy_hosts_per_locality_ = *hosts_per_locality;
   init(true);
-  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality,
+  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr,
                                empty_host_vector_, empty_host_vector_);
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
 }
@@ -511,7 +517,7 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingNotHealthy) {
   hostSet().hosts_ = *hosts;
   hostSet().healthy_hosts_per_locality_ = *hosts_per_locality;
   init(true);
-  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality,
+  local_host_set_->updateHosts(hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr,
                                empty_host_vector_, empty_host_vector_);
 
   // local zone has no healthy hosts, take from the all healthy hosts.
@@ -545,7 +551,8 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingLocalEmpty) {
   hostSet().healthy_hosts_per_locality_ = *upstream_hosts_per_locality;
   init(true);
   local_host_set_->updateHosts(local_hosts, local_hosts, local_hosts_per_locality,
-                               local_hosts_per_locality, empty_host_vector_, empty_host_vector_);
+                               local_hosts_per_locality, nullptr, empty_host_vector_,
+                               empty_host_vector_);
 
   // Local cluster is not OK, we'll do regular routing.
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr));
@@ -553,6 +560,56 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingLocalEmpty) {
   EXPECT_EQ(1U, stats_.lb_local_cluster_not_ok_.value());
 }
 
+TEST_P(RoundRobinLoadBalancerTest, LocalityWeighted) {
+  HostSharedPtr host_a = makeTestHost(info_, "tcp://127.0.0.1:80");
+  HostSharedPtr host_b = makeTestHost(info_, "tcp://127.0.0.1:81");
+  HostSharedPtr host_c = makeTestHost(info_, "tcp://127.0.0.1:82");
+  HostSharedPtr host_d = makeTestHost(info_, "tcp://127.0.0.1:83");
+  hostSet().hosts_ = {host_a, host_b, host_c, host_d};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().hosts_per_locality_ = {{host_a}, {host_b}, {host_c, host_d}};
+  hostSet().healthy_hosts_per_locality_ = hostSet().hosts_per_locality_;
+  hostSet().locality_weights_.reset(new HostSet::LocalityWeights({1, 0, 3}));
+  init(false);
+
+  std::mt19937_64 generator(1234);
+  ON_CALL(random_, random()).WillByDefault(Invoke([&generator]() -> uint64_t {
+    return generator();
+  }));
+  auto run = [this]() -> std::map<HostConstSharedPtr, uint32_t> {
+    std::map<HostConstSharedPtr, uint32_t> picks;
+    for (uint32_t i = 0; i < 10000; ++i) {
+      picks[lb_->chooseHost(nullptr)]++;
+    }
+    return picks;
+  };
+
+  // The locality with weight 0 is never picked.
+  std::map<HostConstSharedPtr, uint32_t> picks = run();
+  EXPECT_EQ(0U, picks[host_b]);
+  EXPECT_NEAR(2500, picks[host_a], 250);
+  EXPECT_NEAR(7500, picks[host_c] + picks[host_d], 250);
+
+  // Half of the hosts in the heaviest locality go unhealthy, halving its effective weight.
+  hostSet().healthy_hosts_ = {host_a, host_b, host_d};
+  hostSet().healthy_hosts_per_locality_ = {{host_a}, {host_b}, {host_d}};
+  hostSet().runCallbacks({}, {});
+  picks = run();
+  EXPECT_EQ(0U, picks[host_b]);
+  EXPECT_EQ(0U, picks[host_c]);
+  EXPECT_NEAR(4000, picks[host_a], 250);
+  EXPECT_NEAR(6000, picks[host_d], 250);
+
+  // Only the locality with weight 0 has healthy hosts left, fall back to all healthy hosts.
+  hostSet().locality_weights_.reset(new HostSet::LocalityWeights({1, 0, 0}));
+  hostSet().healthy_hosts_ = {host_b, host_c, host_d};
+  hostSet().healthy_hosts_per_locality_ = {{}, {host_b}, {host_c, host_d}};
+  hostSet().runCallbacks({}, {});
+  picks = run();
+  EXPECT_EQ(0U, picks[host_a]);
+  EXPECT_EQ(10000U, picks[host_b] + picks[host_c] + picks[host_d]);
+}
+
 INSTANTIATE_TEST_CASE_P(PrimaryOrFailover, RoundRobinLoadBalancerTest,
                         ::testing::Values(true, false));
 
@@ -620,6 +677,43 @@ TEST_P(LeastRequestLoadBalancerTest, Normal) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
 }
 
+TEST_P(LeastRequestLoadBalancerTest, ChoiceCount) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81"),
+                              makeTestHost(info_, "tcp://127.0.0.1:82")};
+  stats_.max_host_weight_.set(1UL);
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(3);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(2);
+  hostSet().healthy_hosts_[2]->stats().rq_active_.set(1);
+
+  // Three choices sample every host.
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.least_request.choice_count", 2))
+      .WillOnce(Return(3));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(2));
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_.chooseHost(nullptr));
+
+  // A single choice is equivalent to random.
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.least_request.choice_count", 2))
+      .WillOnce(Return(1));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+
+  // Zero is treated as one.
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.least_request.choice_count", 2))
+      .WillOnce(Return(0));
+  EXPECT_CALL(random_, random()).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_.chooseHost(nullptr));
+
+  // No more hosts are sampled than there are hosts.
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.least_request.choice_count", 2))
+      .WillOnce(Return(1000000));
+  EXPECT_CALL(random_, random()).Times(3).WillRepeatedly(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_.chooseHost(nullptr));
+}
+
 TEST_P(LeastRequestLoadBalancerTest, WeightImbalanceRuntimeOff) {
   // Disable weight balancing.
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.weight_enabled", 1))
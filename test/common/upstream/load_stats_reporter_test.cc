@@ -14,6 +14,7 @@ using testing::InSequence;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
+using testing::SaveArg;
 using testing::_;
 
 // The tests in this file provide just coverage over some corner cases in error handling. The test
@@ -118,5 +119,29 @@ TEST_F(LoadStatsReporterTest, RemoteStreamClose) {
   retry_timer_cb_();
 }
 
+// Validate that reports harvested after the stream was closed are not sent on the closed stream.
+TEST_F(LoadStatsReporterTest, HarvestCompletesAfterRemoteClose) {
+  EXPECT_CALL(*async_client_, start(_, _)).WillOnce(Return(&async_stream_));
+  ClusterManager::LoadReportsCb load_reports_cb;
+  EXPECT_CALL(cm_, harvestLoadReports(_, _)).WillOnce(SaveArg<1>(&load_reports_cb));
+  EXPECT_CALL(async_stream_, sendMessage(_, _)).Times(0);
+  createLoadStatsReporter();
+  EXPECT_CALL(*response_timer_, disableTimer());
+  EXPECT_CALL(*retry_timer_, enableTimer(_));
+  load_stats_reporter_->onRemoteClose(Grpc::Status::GrpcStatus::Canceled, "");
+  load_reports_cb(HostLoadReportMap());
+}
+
+// Validate that a harvest completing after the reporter was destroyed is dropped.
+TEST_F(LoadStatsReporterTest, HarvestCompletesAfterDestruction) {
+  EXPECT_CALL(*async_client_, start(_, _)).WillOnce(Return(&async_stream_));
+  ClusterManager::LoadReportsCb load_reports_cb;
+  EXPECT_CALL(cm_, harvestLoadReports(_, _)).WillOnce(SaveArg<1>(&load_reports_cb));
+  EXPECT_CALL(async_stream_, sendMessage(_, _)).Times(0);
+  createLoadStatsReporter();
+  load_stats_reporter_.reset();
+  load_reports_cb(HostLoadReportMap());
+}
+
 } // namespace Upstream
 } // namespace Envoy
@@ -17,6 +17,7 @@
 #include "test/mocks/upstream/mocks.h"
 #include "test/test_common/utility.h"
 
+#include "fmt/format.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -46,10 +47,13 @@ public:
 
 class OriginalDstClusterTest : public testing::Test {
 public:
-  // cleanup timer must be created before the cluster (in setup()), so that we can set expectations
-  // on it. Ownership is transferred to the cluster at the cluster constructor, so the cluster will
-  // take care of destructing it!
-  OriginalDstClusterTest() : cleanup_timer_(new Event::MockTimer(&dispatcher_)) {}
+  // Timers must be created before the cluster (in setup()), so that we can set expectations on
+  // them. Ownership is transferred to the cluster at the cluster constructor, so the cluster will
+  // take care of destructing them! The cluster creates the add hosts timer first, and the most
+  // recently created mock timer is handed out first.
+  OriginalDstClusterTest()
+      : cleanup_timer_(new Event::MockTimer(&dispatcher_)),
+        add_hosts_timer_(new Event::MockTimer(&dispatcher_)) {}
 
   void setup(const std::string& json) {
     NiceMock<MockClusterManager> cm;
@@ -69,6 +73,7 @@ public:
   NiceMock<Runtime::MockLoader> runtime_;
   NiceMock<Event::MockDispatcher> dispatcher_;
   Event::MockTimer* cleanup_timer_;
+  Event::MockTimer* add_hosts_timer_;
 };
 
 TEST(OriginalDstClusterConfigTest, BadConfig) {
@@ -212,6 +217,7 @@ TEST_F(OriginalDstClusterTest, Membership) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host = lb.chooseHost(&lb_context);
   post_cb();
+  add_hosts_timer_->callback_();
   auto cluster_hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
 
   ASSERT_NE(host, nullptr);
@@ -258,6 +264,7 @@ TEST_F(OriginalDstClusterTest, Membership) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host3 = lb.chooseHost(&lb_context);
   post_cb();
+  add_hosts_timer_->callback_();
   EXPECT_NE(host3, nullptr);
   EXPECT_NE(host3, host);
   EXPECT_NE(cluster_hosts,
@@ -306,6 +313,7 @@ TEST_F(OriginalDstClusterTest, Membership2) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host1 = lb.chooseHost(&lb_context1);
   post_cb();
+  add_hosts_timer_->callback_();
   ASSERT_NE(host1, nullptr);
   EXPECT_EQ(*connection1.local_address_, *host1->address());
 
@@ -313,6 +321,7 @@ TEST_F(OriginalDstClusterTest, Membership2) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host2 = lb.chooseHost(&lb_context2);
   post_cb();
+  add_hosts_timer_->callback_();
   ASSERT_NE(host2, nullptr);
   EXPECT_EQ(*connection2.local_address_, *host2->address());
 
@@ -356,6 +365,71 @@ TEST_F(OriginalDstClusterTest, Membership2) {
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
 }
 
+// A burst of new destinations is added to the host set in a single update, and evicted in a
+// single update once it is no longer used.
+TEST_F(OriginalDstClusterTest, ManyDestinations) {
+  std::string json = R"EOF(
+  {
+    "name": "name",
+    "connect_timeout_ms": 1250,
+    "type": "original_dst",
+    "lb_type": "original_dst_lb"
+  }
+  )EOF";
+
+  EXPECT_CALL(initialized_, ready());
+  EXPECT_CALL(*cleanup_timer_, enableTimer(_));
+  setup(json);
+
+  NiceMock<Network::MockConnection> connection;
+  TestLoadBalancerContext lb_context(&connection);
+  EXPECT_CALL(connection, usingOriginalDst()).WillRepeatedly(Return(true));
+
+  OriginalDstCluster::LoadBalancer lb(cluster_->prioritySet(), cluster_);
+  std::vector<Event::PostCb> post_cbs;
+  EXPECT_CALL(dispatcher_, post(_)).WillRepeatedly(Invoke([&](Event::PostCb post_cb) -> void {
+    post_cbs.push_back(post_cb);
+  }));
+
+  const uint32_t num_destinations = 1000;
+  for (uint32_t i = 0; i < num_destinations; ++i) {
+    connection.local_address_ = std::make_shared<Network::Address::Ipv4Instance>(
+        fmt::format("10.0.{}.{}", i / 256, i % 256), 80);
+    ASSERT_NE(nullptr, lb.chooseHost(&lb_context));
+  }
+  EXPECT_EQ(num_destinations, post_cbs.size());
+
+  // The host set is only updated once the add hosts timer fires.
+  EXPECT_CALL(*add_hosts_timer_, enableTimer(std::chrono::milliseconds(0)));
+  for (Event::PostCb& post_cb : post_cbs) {
+    post_cb();
+  }
+  EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_CALL(membership_updated_, ready());
+  add_hosts_timer_->callback_();
+  EXPECT_EQ(num_destinations, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_EQ(num_destinations,
+            cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
+  EXPECT_EQ(num_destinations,
+            stats_store_.counter("cluster.name.original_dst.host_created").value());
+  EXPECT_EQ(1UL, stats_store_.counter("cluster.name.original_dst.host_add_batch").value());
+
+  // Existing hosts are reused.
+  EXPECT_EQ(cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().back(),
+            lb.chooseHost(&lb_context));
+  EXPECT_EQ(num_destinations, post_cbs.size());
+
+  // All hosts are evicted at once on the second cleanup.
+  EXPECT_CALL(*cleanup_timer_, enableTimer(_)).Times(2);
+  cleanup_timer_->callback_();
+  EXPECT_EQ(num_destinations, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_CALL(membership_updated_, ready());
+  cleanup_timer_->callback_();
+  EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+  EXPECT_EQ(num_destinations,
+            stats_store_.counter("cluster.name.original_dst.host_evicted").value());
+}
+
 TEST_F(OriginalDstClusterTest, Connection) {
   std::string json = R"EOF(
   {
@@ -389,6 +463,7 @@ TEST_F(OriginalDstClusterTest, Connection) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host = lb.chooseHost(&lb_context);
   post_cb();
+  add_hosts_timer_->callback_();
   ASSERT_NE(host, nullptr);
   EXPECT_EQ(*connection.local_address_, *host->address());
 
@@ -422,7 +497,7 @@ TEST_F(OriginalDstClusterTest, MultipleClusters) {
     const HostListsConstSharedPtr empty_host_lists{new std::vector<std::vector<HostSharedPtr>>()};
 
     second.getOrCreateHostSet(0).updateHosts(new_hosts, healthy_hosts, empty_host_lists,
-                                             empty_host_lists, added, removed);
+                                             empty_host_lists, nullptr, added, removed);
   });
 
   EXPECT_CALL(membership_updated_, ready());
@@ -439,6 +514,7 @@ TEST_F(OriginalDstClusterTest, MultipleClusters) {
   EXPECT_CALL(dispatcher_, post(_)).WillOnce(SaveArg<0>(&post_cb));
   HostConstSharedPtr host = lb1.chooseHost(&lb_context);
   post_cb();
+  add_hosts_timer_->callback_();
   ASSERT_NE(host, nullptr);
   EXPECT_EQ(*connection.local_address_, *host->address());
 
@@ -1,4 +1,5 @@
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -815,13 +816,33 @@ TEST(OutlierUtility, SRThreshold) {
       HostSuccessRatePair(nullptr, 100), HostSuccessRatePair(nullptr, 100),
       HostSuccessRatePair(nullptr, 100),
   };
-  double sum = 450;
 
-  Utility::EjectionPair ejection_pair = Utility::successRateEjectionThreshold(sum, data, 1.9);
+  Utility::EjectionPair ejection_pair = Utility::successRateEjectionThreshold(data, 1.9);
   EXPECT_EQ(52.0, ejection_pair.ejection_threshold_);
   EXPECT_EQ(90.0, ejection_pair.success_rate_average_);
 }
 
+TEST(OutlierUtility, SRThresholdManyHosts) {
+  std::vector<HostSuccessRatePair> data;
+  double sum = 0;
+  for (uint32_t i = 0; i < 5000; i++) {
+    const double success_rate = 90.0 + (i % 11);
+    data.emplace_back(nullptr, success_rate);
+    sum += success_rate;
+  }
+
+  const double mean = sum / data.size();
+  double variance = 0;
+  for (const HostSuccessRatePair& v : data) {
+    variance += (v.success_rate_ - mean) * (v.success_rate_ - mean);
+  }
+  variance /= data.size();
+
+  Utility::EjectionPair ejection_pair = Utility::successRateEjectionThreshold(data, 1.9);
+  EXPECT_NEAR(mean, ejection_pair.success_rate_average_, 1e-9);
+  EXPECT_NEAR(mean - 1.9 * std::sqrt(variance), ejection_pair.ejection_threshold_, 1e-9);
+}
+
 } // namespace Outlier
 } // namespace Upstream
 } // namespace Envoy
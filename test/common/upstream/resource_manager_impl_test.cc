@@ -47,5 +47,66 @@ TEST(ResourceManagerImplTest, RuntimeResourceManager) {
   EXPECT_FALSE(resource_manager.retries().canCreate());
 }
 
+TEST(ResourceManagerImplTest, AdaptiveRequests) {
+  NiceMock<Runtime::MockLoader> runtime;
+  ResourceManagerImpl resource_manager(runtime, "circuit_breakers.adaptive_test.default.", 0, 0,
+                                       100, 0);
+  AdaptiveResource& adaptive_requests = resource_manager.adaptiveRequests();
+
+  EXPECT_FALSE(adaptive_requests.enabled());
+  EXPECT_CALL(runtime.snapshot_,
+              getInteger("circuit_breakers.adaptive_test.default.adaptive_concurrency.enabled", 0))
+      .WillOnce(Return(1));
+  EXPECT_TRUE(adaptive_requests.enabled());
+
+  auto record_window = [&adaptive_requests](uint64_t response_time_ms) -> void {
+    for (uint32_t i = 0; i < 100; i++) {
+      adaptive_requests.recordResponseTime(std::chrono::milliseconds(response_time_ms));
+    }
+  };
+
+  // The limit starts at, and is bounded by, max_requests.
+  EXPECT_EQ(100U, adaptive_requests.max());
+  record_window(10);
+  EXPECT_EQ(100U, adaptive_requests.max());
+
+  // Rising latency backs the limit off.
+  for (uint32_t i = 0; i < 5; i++) {
+    record_window(40);
+  }
+  const uint64_t backed_off_limit = adaptive_requests.max();
+  EXPECT_GT(backed_off_limit, 60U);
+  EXPECT_LT(backed_off_limit, 70U);
+
+  for (uint64_t i = 0; i < backed_off_limit; i++) {
+    EXPECT_TRUE(adaptive_requests.canCreate());
+    adaptive_requests.inc();
+  }
+  EXPECT_FALSE(adaptive_requests.canCreate());
+  for (uint64_t i = 0; i < backed_off_limit; i++) {
+    adaptive_requests.dec();
+  }
+
+  // Once latency recovers the limit grows back to max_requests.
+  for (uint32_t i = 0; i < 30; i++) {
+    record_window(10);
+  }
+  EXPECT_EQ(100U, adaptive_requests.max());
+
+  // Fast failures count as slow responses, so they back the limit off rather than raise it.
+  for (uint32_t i = 0; i < 5; i++) {
+    for (uint32_t j = 0; j < 100; j++) {
+      adaptive_requests.recordFailure(std::chrono::milliseconds(1));
+    }
+  }
+  EXPECT_LT(adaptive_requests.max(), 75U);
+
+  // The runtime max_requests override also bounds the adaptive limit.
+  EXPECT_CALL(runtime.snapshot_,
+              getInteger("circuit_breakers.adaptive_test.default.max_requests", 100U))
+      .WillOnce(Return(10U));
+  EXPECT_EQ(10U, adaptive_requests.max());
+}
+
 } // namespace Upstream
 } // namespace Envoy
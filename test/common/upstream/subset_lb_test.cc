@@ -160,7 +160,8 @@ public:
     }
 
     local_priority_set_.getOrCreateHostSet(0).updateHosts(
-        local_hosts_, local_hosts_, local_hosts_per_locality_, local_hosts_per_locality_, {}, {});
+        local_hosts_, local_hosts_, local_hosts_per_locality_, local_hosts_per_locality_, nullptr,
+        {}, {});
 
     lb_.reset(new SubsetLoadBalancer(lb_type_, priority_set_, &local_priority_set_, stats_,
                                      runtime_, random_, subset_info_, ring_hash_lb_config_));
@@ -250,7 +251,8 @@ public:
     if (GetParam() == REMOVES_FIRST && !remove.empty()) {
       local_priority_set_.getOrCreateHostSet(0).updateHosts(local_hosts_, local_hosts_,
                                                             local_hosts_per_locality_,
-                                                            local_hosts_per_locality_, {}, remove);
+                                                            local_hosts_per_locality_, nullptr,
+                                                            {}, remove);
     }
 
     for (const auto& host : add) {
@@ -262,12 +264,14 @@ public:
       if (!add.empty()) {
         local_priority_set_.getOrCreateHostSet(0).updateHosts(local_hosts_, local_hosts_,
                                                               local_hosts_per_locality_,
-                                                              local_hosts_per_locality_, add, {});
+                                                              local_hosts_per_locality_, nullptr,
+                                                              add, {});
       }
     } else if (!add.empty() || !remove.empty()) {
       local_priority_set_.getOrCreateHostSet(0).updateHosts(local_hosts_, local_hosts_,
                                                             local_hosts_per_locality_,
-                                                            local_hosts_per_locality_, add, remove);
+                                                            local_hosts_per_locality_, nullptr,
+                                                            add, remove);
     }
   }
 
@@ -480,6 +484,33 @@ TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
   EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
 }
 
+// Test that a subset lookup that previously failed is retried once hosts matching it are added.
+TEST_P(SubsetLoadBalancerTest, UpdateAddsSubsetForPreviouslyUnmatchedCriteria) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::api::v2::Cluster::LbSubsetConfig::NO_FALLBACK));
+
+  std::vector<std::set<std::string>> subset_keys = {{"version"}};
+  EXPECT_CALL(subset_info_, subsetKeys()).WillRepeatedly(ReturnRef(subset_keys));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+  });
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12));
+
+  HostSharedPtr host_v12 = makeHost("tcp://127.0.0.1:8000", {{"version", "1.2"}});
+  modifyHosts({host_v12}, {});
+
+  EXPECT_EQ(host_v12, lb_->chooseHost(&context_12));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10));
+  EXPECT_EQ(3U, stats_.lb_subsets_selected_.value());
+}
+
 // Test that adding backends to a failover group causes no problems.
 TEST_P(SubsetLoadBalancerTest, UpdateFailover) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
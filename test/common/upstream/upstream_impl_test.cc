@@ -694,7 +694,7 @@ TEST(PrioritySet, Extend) {
   std::vector<HostSharedPtr> hosts_removed{};
 
   priority_set.hostSetsPerPriority()[1]->updateHosts(
-      hosts, hosts, hosts_per_locality, hosts_per_locality, hosts_added, hosts_removed);
+      hosts, hosts, hosts_per_locality, hosts_per_locality, nullptr, hosts_added, hosts_removed);
   EXPECT_EQ(1, changes);
   EXPECT_EQ(last_priority, 1);
   EXPECT_EQ(1, priority_set.hostSetsPerPriority()[1]->hosts().size());
@@ -259,6 +259,21 @@ TEST_P(XfccIntegrationTest, NonTlsEnforceSanitize) {
   testRequestAndResponseWithXfccHeader(previous_xfcc_, "");
 }
 
+TEST_P(XfccIntegrationTest, UpstreamSessionResumption) {
+  // Every request goes out on a new TLS connection to the same upstream host, which resumes the
+  // session of the previous connection.
+  tls_ = false;
+  initialize();
+  testRequestAndResponseWithXfccHeader("", "");
+  cleanupUpstreamAndDownstream();
+  EXPECT_EQ(0U, test_server_->counter("cluster.cluster_0.ssl.session_reused")->value());
+
+  testRequestAndResponseWithXfccHeader("", "");
+  cleanupUpstreamAndDownstream();
+  EXPECT_EQ(1U, test_server_->counter("cluster.cluster_0.ssl.session_reused")->value());
+  EXPECT_EQ(2U, test_server_->counter("cluster.cluster_0.ssl.handshake")->value());
+}
+
 TEST_P(XfccIntegrationTest, TagExtractedNameGenerationTest) {
   // Note: the test below is meant to check that default tags are being extracted correctly with
   // real-ish input stats. If new stats are added, this test will not break because names that do
@@ -89,9 +89,10 @@ public:
                Network::ClientConnection*(Ssl::ClientContext& ssl_ctx,
                                           Network::Address::InstanceConstSharedPtr address,
                                           Network::Address::InstanceConstSharedPtr source_address));
-  MOCK_METHOD1(createDnsResolver,
+  MOCK_METHOD2(createDnsResolver,
                Network::DnsResolverSharedPtr(
-                   const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers));
+                   const std::vector<Network::Address::InstanceConstSharedPtr>& resolvers,
+                   Stats::Scope& scope));
   MOCK_METHOD4(createFileEvent_,
                FileEvent*(int fd, FileReadyCb cb, FileTriggerType trigger, uint32_t events));
   MOCK_METHOD0(createFilesystemWatcher_, Filesystem::Watcher*());
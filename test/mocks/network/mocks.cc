@@ -160,5 +160,10 @@ MockConnectionHandler::~MockConnectionHandler() {}
 MockTransportSocket::MockTransportSocket() {}
 MockTransportSocket::~MockTransportSocket() {}
 
+MockTransportSocketCallbacks::MockTransportSocketCallbacks() {
+  ON_CALL(*this, connection()).WillByDefault(ReturnRef(connection_));
+}
+MockTransportSocketCallbacks::~MockTransportSocketCallbacks() {}
+
 } // namespace Network
 } // namespace Envoy
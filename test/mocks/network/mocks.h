@@ -78,6 +78,7 @@ public:
   MOCK_CONST_METHOD0(bufferLimit, uint32_t());
   MOCK_CONST_METHOD0(usingOriginalDst, bool());
   MOCK_CONST_METHOD0(aboveHighWatermark, bool());
+  MOCK_METHOD2(spliceTo, bool(Connection& destination, BytesSplicedCb cb));
 };
 
 /**
@@ -115,6 +116,7 @@ public:
   MOCK_CONST_METHOD0(bufferLimit, uint32_t());
   MOCK_CONST_METHOD0(usingOriginalDst, bool());
   MOCK_CONST_METHOD0(aboveHighWatermark, bool());
+  MOCK_METHOD2(spliceTo, bool(Connection& destination, BytesSplicedCb cb));
 
   // Network::ClientConnection
   MOCK_METHOD0(connect, void());
@@ -291,5 +293,19 @@ public:
   MOCK_METHOD0(onConnected, void());
 };
 
+class MockTransportSocketCallbacks : public TransportSocketCallbacks {
+public:
+  MockTransportSocketCallbacks();
+  ~MockTransportSocketCallbacks();
+
+  MOCK_METHOD0(fd, int());
+  MOCK_METHOD0(connection, Connection&());
+  MOCK_METHOD0(shouldDrainReadBuffer, bool());
+  MOCK_METHOD0(setReadBufferReady, void());
+  MOCK_METHOD1(raiseEvent, void(ConnectionEvent event));
+
+  testing::NiceMock<MockConnection> connection_;
+};
+
 } // namespace Network
 } // namespace Envoy
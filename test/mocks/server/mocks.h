@@ -184,6 +184,8 @@ public:
   MOCK_METHOD0(bindToPort, bool());
   MOCK_METHOD0(useOriginalDst, bool());
   MOCK_METHOD0(perConnectionBufferLimitBytes, uint32_t());
+  MOCK_METHOD0(maxConnectionsPerAccept, uint32_t());
+  MOCK_METHOD0(connectionRateLimiter, Network::ConnectionRateLimiterSharedPtr());
   MOCK_METHOD0(listenerScope, Stats::Scope&());
   MOCK_METHOD0(listenerTag, uint64_t());
   MOCK_CONST_METHOD0(name, const std::string&());
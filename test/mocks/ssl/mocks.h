@@ -65,5 +65,17 @@ public:
   MOCK_CONST_METHOD0(getCertChainInformation, std::string());
 };
 
+class MockServerContext : public ServerContext {
+public:
+  MockServerContext();
+  ~MockServerContext();
+
+  MOCK_CONST_METHOD0(daysUntilFirstCertExpires, size_t());
+  MOCK_CONST_METHOD0(getCaCertInformation, std::string());
+  MOCK_CONST_METHOD0(getCertChainInformation, std::string());
+  MOCK_METHOD1(setSessionTicketKeys,
+               void(const std::vector<ServerContextConfig::SessionTicketKey>& keys));
+};
+
 } // namespace Ssl
 } // namespace Envoy
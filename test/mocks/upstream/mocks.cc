@@ -24,6 +24,7 @@ MockHostSet::MockHostSet(uint32_t priority) : priority_(priority) {
   ON_CALL(*this, healthyHosts()).WillByDefault(ReturnRef(healthy_hosts_));
   ON_CALL(*this, hostsPerLocality()).WillByDefault(ReturnRef(hosts_per_locality_));
   ON_CALL(*this, healthyHostsPerLocality()).WillByDefault(ReturnRef(healthy_hosts_per_locality_));
+  ON_CALL(*this, localityWeights()).WillByDefault(ReturnPointee(&locality_weights_));
 }
 
 MockPrioritySet::MockPrioritySet() {
@@ -88,6 +89,10 @@ MockClusterManager::MockClusterManager() {
   ON_CALL(*this, sourceAddress()).WillByDefault(ReturnRef(source_address_));
   ON_CALL(*this, adsMux()).WillByDefault(ReturnRef(ads_mux_));
   ON_CALL(*this, localClusterName()).WillByDefault((ReturnRef(local_cluster_name_)));
+  ON_CALL(*this, harvestLoadReports(_, _))
+      .WillByDefault(Invoke([](const std::vector<std::string>&, LoadReportsCb cb) -> void {
+        cb(HostLoadReportMap());
+      }));
 
   // Matches are LIFO so "" will match first.
   ON_CALL(*this, get(_)).WillByDefault(Return(&thread_local_cluster_));
@@ -45,13 +45,15 @@ public:
   MOCK_CONST_METHOD0(healthyHosts, const std::vector<HostSharedPtr>&());
   MOCK_CONST_METHOD0(hostsPerLocality, const std::vector<std::vector<HostSharedPtr>>&());
   MOCK_CONST_METHOD0(healthyHostsPerLocality, const std::vector<std::vector<HostSharedPtr>>&());
-  MOCK_METHOD6(
+  MOCK_CONST_METHOD0(localityWeights, LocalityWeightsConstSharedPtr());
+  MOCK_METHOD7(
       updateHosts,
       void(
           std::shared_ptr<const std::vector<HostSharedPtr>> hosts,
           std::shared_ptr<const std::vector<HostSharedPtr>> healthy_hosts,
           std::shared_ptr<const std::vector<std::vector<HostSharedPtr>>> hosts_per_locality,
           std::shared_ptr<const std::vector<std::vector<HostSharedPtr>>> healthy_hosts_per_locality,
+          LocalityWeightsConstSharedPtr locality_weights,
           const std::vector<HostSharedPtr>& hosts_added,
           const std::vector<HostSharedPtr>& hosts_removed));
   MOCK_CONST_METHOD0(priority, uint32_t());
@@ -60,6 +62,7 @@ public:
   std::vector<HostSharedPtr> healthy_hosts_;
   std::vector<std::vector<HostSharedPtr>> hosts_per_locality_;
   std::vector<std::vector<HostSharedPtr>> healthy_hosts_per_locality_;
+  LocalityWeightsConstSharedPtr locality_weights_;
   Common::CallbackManager<uint32_t, const std::vector<HostSharedPtr>&,
                           const std::vector<HostSharedPtr>&>
       member_update_cb_helper_;
@@ -161,6 +164,10 @@ public:
                MockHost::MockCreateConnectionData(const std::string& cluster,
                                                   LoadBalancerContext* context));
   MOCK_METHOD1(httpAsyncClientForCluster, Http::AsyncClient&(const std::string& cluster));
+  MOCK_METHOD2(recordLoadReport, void(const HostDescriptionConstSharedPtr& host, bool success));
+  MOCK_METHOD2(harvestLoadReports,
+               void(const std::vector<std::string>& clusters, LoadReportsCb cb));
+  MOCK_METHOD1(updateLoadReportClusters, void(const std::vector<std::string>& clusters));
   MOCK_METHOD1(removePrimaryCluster, bool(const std::string& cluster));
   MOCK_METHOD0(shutdown, void());
   MOCK_CONST_METHOD0(sourceAddress, const Network::Address::InstanceConstSharedPtr&());
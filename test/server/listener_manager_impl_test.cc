@@ -5,6 +5,7 @@
 #include "server/configuration_impl.h"
 #include "server/listener_manager_impl.h"
 
+#include "test/mocks/filesystem/mocks.h"
 #include "test/mocks/server/mocks.h"
 #include "test/server/utility.h"
 #include "test/test_common/environment.h"
@@ -16,6 +17,8 @@ using testing::InSequence;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnNew;
+using testing::SaveArg;
 using testing::Throw;
 using testing::_;
 
@@ -37,6 +40,8 @@ public:
 class ListenerManagerImplTest : public testing::Test {
 public:
   ListenerManagerImplTest() {
+    ON_CALL(server_.dispatcher_, createFilesystemWatcher_())
+        .WillByDefault(ReturnNew<NiceMock<Filesystem::MockWatcher>>());
     EXPECT_CALL(worker_factory_, createWorker_()).WillOnce(Return(worker_));
     manager_.reset(new ListenerManagerImpl(server_, listener_factory_, worker_factory_));
   }
@@ -145,6 +150,47 @@ TEST_F(ListenerManagerImplWithRealFiltersTest, SetListenerPerConnectionBufferLim
   EXPECT_EQ(8192U, manager_->listeners().back().get().perConnectionBufferLimitBytes());
 }
 
+TEST_F(ListenerManagerImplWithRealFiltersTest, ConnectionRateLimiterSharedByWorkers) {
+  const std::string foo_json = R"EOF(
+  {
+    "name": "foo",
+    "address": "tcp://127.0.0.1:1234",
+    "filters": []
+  }
+  )EOF";
+
+  EXPECT_CALL(server_.runtime_loader_.snapshot_,
+              getInteger("listener.foo.connection_rate_limit_per_second", 0))
+      .WillOnce(Return(0));
+  EXPECT_CALL(listener_factory_, createListenSocket(_, true));
+  manager_->addOrUpdateListener(parseListenerFromJson(foo_json));
+  EXPECT_EQ(nullptr, manager_->listeners().back().get().connectionRateLimiter());
+
+  const std::string bar_json = R"EOF(
+  {
+    "name": "bar",
+    "address": "tcp://127.0.0.1:1235",
+    "filters": []
+  }
+  )EOF";
+
+  EXPECT_CALL(server_.runtime_loader_.snapshot_,
+              getInteger("listener.bar.connection_rate_limit_per_second", 0))
+      .WillOnce(Return(3));
+  EXPECT_CALL(listener_factory_, createListenSocket(_, true));
+  manager_->addOrUpdateListener(parseListenerFromJson(bar_json));
+  Listener& listener = manager_->listeners().back().get();
+
+  // Every worker gets the same limiter, so together they accept no more than the configured rate.
+  Network::ConnectionRateLimiterSharedPtr limiter = listener.connectionRateLimiter();
+  ASSERT_NE(nullptr, limiter);
+  EXPECT_EQ(limiter, listener.connectionRateLimiter());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(0, limiter->consume().count());
+  }
+  EXPECT_LT(0, limiter->consume().count());
+}
+
 TEST_F(ListenerManagerImplWithRealFiltersTest, SslContext) {
   const std::string json = TestEnvironment::substitute(R"EOF(
   {
@@ -948,6 +994,52 @@ TEST_F(ListenerManagerImplWithRealFiltersTest,
                             "of Session Ticket Keys are currently not supported");
 }
 
+TEST_F(ListenerManagerImplWithRealFiltersTest, SessionTicketKeysRotation) {
+  const std::string key_a = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::runfilesPath("test/common/ssl/test_data/ticket_key_a"));
+  const std::string key_path = TestEnvironment::writeStringToFileForTest("ticket_key", key_a);
+  const std::string yaml = TestEnvironment::substitute(R"EOF(
+    address:
+      socket_address: { address: 127.0.0.1, port_value: 1234 }
+    filter_chains:
+    - tls_context:
+        common_tls_context:
+          tls_certificates:
+            - certificate_chain: { filename: "{{ test_rundir }}/test/common/ssl/test_data/san_dns_cert.pem" }
+              private_key: { filename: "{{ test_rundir }}/test/common/ssl/test_data/san_dns_key.pem" }
+        session_ticket_keys:
+          keys:
+          - filename: "{{ test_tmpdir }}/ticket_key"
+          - filename: "{{ test_rundir }}/test/common/ssl/test_data/ticket_key_b"
+      filters: []
+  )EOF",
+                                                       Network::Address::IpVersion::v4);
+
+  Filesystem::MockWatcher* watcher = new Filesystem::MockWatcher();
+  Filesystem::Watcher::OnChangedCb on_changed;
+  EXPECT_CALL(server_.dispatcher_, createFilesystemWatcher_()).WillOnce(Return(watcher));
+  EXPECT_CALL(*watcher, addWatch(key_path, Filesystem::Watcher::Events::MovedTo, _))
+      .WillOnce(SaveArg<2>(&on_changed));
+  EXPECT_CALL(*watcher,
+              addWatch(TestEnvironment::runfilesPath("test/common/ssl/test_data/ticket_key_b"),
+                       Filesystem::Watcher::Events::MovedTo, _));
+  EXPECT_CALL(listener_factory_, createListenSocket(_, true));
+  manager_->addOrUpdateListener(parseListenerFromV2Yaml(yaml));
+  EXPECT_EQ(1U, manager_->listeners().size());
+
+  on_changed(Filesystem::Watcher::Events::MovedTo);
+  EXPECT_EQ(1UL, server_.stats_store_
+                     .counter("listener.127.0.0.1_1234.ssl.session_ticket_keys_rotated")
+                     .value());
+
+  // Invalid keys are ignored and the previous keys stay in use.
+  TestEnvironment::writeStringToFileForTest("ticket_key", "bad key");
+  on_changed(Filesystem::Watcher::Events::MovedTo);
+  EXPECT_EQ(1UL, server_.stats_store_
+                     .counter("listener.127.0.0.1_1234.ssl.session_ticket_keys_rotated")
+                     .value());
+}
+
 TEST_F(ListenerManagerImplWithRealFiltersTest, SniWithTwoDifferentFilterChains) {
   const std::string yaml = TestEnvironment::substitute(R"EOF(
     address: